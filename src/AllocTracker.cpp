@@ -0,0 +1,300 @@
+/**
+ * @file AllocTracker.cpp
+ * @brief Implementation of AllocTracker and the replacement operator new.
+ */
+
+#include "AllocTracker.hpp"
+
+#include <algorithm> // std::max
+#include <iomanip>   // std::setw, std::setprecision
+#include <ostream>
+
+#ifdef BREAKOUT_ALLOC_TRACKING
+
+#include <atomic>
+#include <cstdio>    // std::fprintf
+#include <cstdlib>   // std::malloc, std::free, std::abort
+#include <new>       // std::bad_alloc, std::nothrow_t
+
+// =============================================================================
+// Tracker state
+// =============================================================================
+
+namespace {
+
+/// Sentinel meaning "no phase is active".
+constexpr int NO_PHASE = -1;
+
+/// True on the thread that drives the main loop (set by beginFrame).
+thread_local bool tlsFrameThread = false;
+
+/// Index of the active FramePhase on this thread, or NO_PHASE.
+thread_local int tlsPhase = NO_PHASE;
+
+/// Process-wide counters, updated from every thread.
+std::atomic<std::uint64_t> totalAllocations{0};
+std::atomic<std::uint64_t> totalFrees{0};
+std::atomic<std::uint64_t> totalBytes{0};
+
+// The remaining state is only touched by the frame thread, so plain integers
+// suffice.
+
+AllocTracker::Counters frameCounters;                     ///< Current frame.
+AllocTracker::Counters framePhaseCounters[FRAME_PHASE_COUNT]; ///< Current frame, per phase.
+AllocTracker::Counters lastFrameCounters;                 ///< Last completed frame.
+
+AllocTracker::Counters sessionCounters;                   ///< All completed frames.
+AllocTracker::Counters sessionPhaseCounters[FRAME_PHASE_COUNT];
+std::uint64_t          framesTracked          = 0;
+std::uint64_t          maxFrameAllocations    = 0;
+std::uint64_t          maxFrameBytes          = 0;
+std::uint64_t          steadyFrames           = 0;
+std::uint64_t          steadyFramesAllocating = 0;
+
+bool                   assertSteadyState      = false;
+
+/**
+ * @brief Records one allocation of @p size bytes.
+ * @param size  Requested size in bytes.
+ */
+inline void noteAllocation(std::size_t size)
+{
+    totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (!tlsFrameThread)
+        return;
+
+    ++frameCounters.allocations;
+    frameCounters.bytes += size;
+
+    if (tlsPhase != NO_PHASE)
+    {
+        ++framePhaseCounters[tlsPhase].allocations;
+        framePhaseCounters[tlsPhase].bytes += size;
+    }
+}
+
+/**
+ * @brief Records one deallocation of a non-null pointer.
+ */
+inline void noteFree()
+{
+    totalFrees.fetch_add(1, std::memory_order_relaxed);
+
+    if (!tlsFrameThread)
+        return;
+
+    ++frameCounters.frees;
+    if (tlsPhase != NO_PHASE)
+        ++framePhaseCounters[tlsPhase].frees;
+}
+
+/**
+ * @brief malloc-backed allocation shared by all operator new overloads.
+ * @param size  Requested size in bytes (0 is rounded up to 1).
+ * @return void*  Allocated block, or nullptr on exhaustion.
+ */
+inline void* trackedAlloc(std::size_t size)
+{
+    void* block = std::malloc(size == 0 ? 1 : size);
+    if (block)
+        noteAllocation(size);
+    return block;
+}
+
+/**
+ * @brief free-backed deallocation shared by all operator delete overloads.
+ * @param block  Block to release; nullptr is ignored.
+ */
+inline void trackedFree(void* block)
+{
+    if (!block)
+        return;
+    noteFree();
+    std::free(block);
+}
+
+} // namespace
+
+// =============================================================================
+// Replacement global allocation functions
+// =============================================================================
+
+void* operator new(std::size_t size)
+{
+    if (void* block = trackedAlloc(size))
+        return block;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if (void* block = trackedAlloc(size))
+        return block;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return trackedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return trackedAlloc(size);
+}
+
+void operator delete(void* block) noexcept                        { trackedFree(block); }
+void operator delete[](void* block) noexcept                      { trackedFree(block); }
+void operator delete(void* block, std::size_t) noexcept           { trackedFree(block); }
+void operator delete[](void* block, std::size_t) noexcept         { trackedFree(block); }
+void operator delete(void* block, const std::nothrow_t&) noexcept { trackedFree(block); }
+void operator delete[](void* block, const std::nothrow_t&) noexcept { trackedFree(block); }
+
+// =============================================================================
+// AllocTracker – tracking build
+// =============================================================================
+
+AllocTracker::Zone::Zone(FramePhase phase)
+{
+    tlsPhase = static_cast<int>(phase);
+}
+
+AllocTracker::Zone::~Zone()
+{
+    tlsPhase = NO_PHASE;
+}
+
+bool AllocTracker::isEnabled()
+{
+    return true;
+}
+
+void AllocTracker::setSteadyStateAssertion(bool enabled)
+{
+    assertSteadyState = enabled;
+}
+
+void AllocTracker::beginFrame()
+{
+    tlsFrameThread = true;
+    frameCounters  = Counters();
+    for (Counters& phase : framePhaseCounters)
+        phase = Counters();
+}
+
+void AllocTracker::endFrame(bool steadyState)
+{
+    lastFrameCounters = frameCounters;
+
+    ++framesTracked;
+    sessionCounters.allocations += frameCounters.allocations;
+    sessionCounters.frees       += frameCounters.frees;
+    sessionCounters.bytes       += frameCounters.bytes;
+    for (std::size_t i = 0; i < FRAME_PHASE_COUNT; ++i)
+    {
+        sessionPhaseCounters[i].allocations += framePhaseCounters[i].allocations;
+        sessionPhaseCounters[i].frees       += framePhaseCounters[i].frees;
+        sessionPhaseCounters[i].bytes       += framePhaseCounters[i].bytes;
+    }
+    maxFrameAllocations = std::max(maxFrameAllocations, frameCounters.allocations);
+    maxFrameBytes       = std::max(maxFrameBytes, frameCounters.bytes);
+
+    if (!steadyState)
+        return;
+
+    ++steadyFrames;
+    if (frameCounters.allocations == 0)
+        return;
+
+    ++steadyFramesAllocating;
+
+    if (assertSteadyState)
+    {
+        // Use stdio rather than iostreams so the diagnostic itself does not
+        // depend on the allocator state being reported.
+        std::fprintf(stderr,
+            "[Breakout] ASSERTION: %llu allocation(s), %llu byte(s) during a "
+            "steady-state Playing frame (frame %llu).\n",
+            static_cast<unsigned long long>(frameCounters.allocations),
+            static_cast<unsigned long long>(frameCounters.bytes),
+            static_cast<unsigned long long>(framesTracked));
+        for (std::size_t i = 0; i < FRAME_PHASE_COUNT; ++i)
+        {
+            std::fprintf(stderr, "             %-7s %llu allocation(s), %llu byte(s)\n",
+                framePhaseName(static_cast<FramePhase>(i)),
+                static_cast<unsigned long long>(framePhaseCounters[i].allocations),
+                static_cast<unsigned long long>(framePhaseCounters[i].bytes));
+        }
+        std::abort();
+    }
+}
+
+AllocTracker::Counters AllocTracker::lastFrame()
+{
+    return lastFrameCounters;
+}
+
+AllocTracker::Counters AllocTracker::processTotals()
+{
+    Counters totals;
+    totals.allocations = totalAllocations.load(std::memory_order_relaxed);
+    totals.frees       = totalFrees.load(std::memory_order_relaxed);
+    totals.bytes       = totalBytes.load(std::memory_order_relaxed);
+    return totals;
+}
+
+void AllocTracker::writeReport(std::ostream& out)
+{
+    // Snapshot everything first: formatting below may itself allocate.
+    const std::uint64_t frames         = framesTracked;
+    const Counters      session        = sessionCounters;
+    const std::uint64_t maxAllocs      = maxFrameAllocations;
+    const std::uint64_t maxBytes       = maxFrameBytes;
+    const std::uint64_t steady         = steadyFrames;
+    const std::uint64_t steadyAllocing = steadyFramesAllocating;
+    Counters phases[FRAME_PHASE_COUNT];
+    for (std::size_t i = 0; i < FRAME_PHASE_COUNT; ++i)
+        phases[i] = sessionPhaseCounters[i];
+
+    const double perFrame = frames ? 1.0 / static_cast<double>(frames) : 0.0;
+
+    out << "[Breakout] Allocation report (" << frames << " frames):\n"
+        << std::fixed << std::setprecision(1)
+        << "  per frame: " << static_cast<double>(session.allocations) * perFrame
+        << " allocations, " << static_cast<double>(session.bytes) * perFrame
+        << " bytes (max " << maxAllocs << " allocations, " << maxBytes << " bytes)\n";
+
+    for (std::size_t i = 0; i < FRAME_PHASE_COUNT; ++i)
+    {
+        out << "  " << std::setw(7) << std::left << framePhaseName(static_cast<FramePhase>(i))
+            << std::right
+            << static_cast<double>(phases[i].allocations) * perFrame << " allocations, "
+            << static_cast<double>(phases[i].bytes) * perFrame << " bytes per frame\n";
+    }
+
+    out << "  steady-state Playing frames: " << steady
+        << " (" << steadyAllocing << " allocated)\n";
+}
+
+#else // !BREAKOUT_ALLOC_TRACKING
+
+// =============================================================================
+// AllocTracker – no-op build
+// =============================================================================
+
+AllocTracker::Zone::Zone(FramePhase) {}
+AllocTracker::Zone::~Zone() {}
+
+bool AllocTracker::isEnabled()                  { return false; }
+void AllocTracker::setSteadyStateAssertion(bool) {}
+void AllocTracker::beginFrame()                 {}
+void AllocTracker::endFrame(bool)               {}
+
+AllocTracker::Counters AllocTracker::lastFrame()     { return Counters(); }
+AllocTracker::Counters AllocTracker::processTotals() { return Counters(); }
+
+void AllocTracker::writeReport(std::ostream&) {}
+
+#endif // BREAKOUT_ALLOC_TRACKING
@@ -0,0 +1,114 @@
+/**
+ * @file AllocTracker.hpp
+ * @brief Declaration of AllocTracker — per-frame heap allocation accounting.
+ *
+ * When the build defines BREAKOUT_ALLOC_TRACKING (Debug builds do by default,
+ * see CMakeLists.txt) AllocTracker.cpp replaces the global operator new and
+ * operator delete with thin wrappers around malloc/free that count every
+ * allocation made by the main-loop thread.  Counts are attributed to the
+ * current frame and to the FramePhase that was active at the time.
+ *
+ * The steady-state assertion turns the tracker into a regression guard: once
+ * the hot loop is allocation-free, any frame of sustained Playing state that
+ * allocates aborts the program with a per-phase breakdown.
+ *
+ * Without BREAKOUT_ALLOC_TRACKING every method is an inexpensive no-op and
+ * the global allocation functions are left untouched.
+ *
+ * Over-aligned allocations (operator new with std::align_val_t) are not
+ * intercepted; the game does not use over-aligned types.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+
+#include "FramePhase.hpp"
+
+/**
+ * @brief Static facade over the global allocation counters.
+ *
+ * Only allocations made on the thread that calls beginFrame() are attributed
+ * to frames and phases; other threads contribute to the process-wide totals.
+ */
+class AllocTracker
+{
+public:
+    /**
+     * @brief Allocation count and requested byte total.
+     */
+    struct Counters
+    {
+        std::uint64_t allocations = 0; ///< Calls to operator new.
+        std::uint64_t frees       = 0; ///< Calls to operator delete.
+        std::uint64_t bytes       = 0; ///< Bytes requested from operator new.
+    };
+
+    /**
+     * @brief RAII guard that attributes allocations to a FramePhase.
+     *
+     * Phases do not nest; the guard restores "no phase" when destroyed.
+     */
+    class Zone
+    {
+    public:
+        /**
+         * @brief Enters @p phase for the lifetime of the guard.
+         * @param phase  Phase to which allocations are charged.
+         */
+        explicit Zone(FramePhase phase);
+
+        /// Leaves the phase.
+        ~Zone();
+
+        Zone(const Zone&)            = delete;
+        Zone& operator=(const Zone&) = delete;
+    };
+
+    /**
+     * @brief Reports whether allocation tracking was compiled in.
+     * @return true when built with BREAKOUT_ALLOC_TRACKING.
+     */
+    static bool isEnabled();
+
+    /**
+     * @brief Enables or disables the steady-state zero-allocation assertion.
+     * @param enabled  When true, endFrame(true) aborts if the frame allocated.
+     */
+    static void setSteadyStateAssertion(bool enabled);
+
+    /**
+     * @brief Starts a new frame on the calling thread.
+     *
+     * The calling thread becomes the tracked main-loop thread.
+     */
+    static void beginFrame();
+
+    /**
+     * @brief Closes the current frame and folds it into the session totals.
+     *
+     * @param steadyState  True when the frame belongs to sustained gameplay;
+     *                     with the assertion enabled, an allocating
+     *                     steady-state frame aborts the program.
+     */
+    static void endFrame(bool steadyState);
+
+    /**
+     * @brief Returns the counters of the most recently completed frame.
+     * @return Counters  Allocations, frees and bytes for that frame.
+     */
+    static Counters lastFrame();
+
+    /**
+     * @brief Returns process-wide counters across all threads.
+     * @return Counters  Totals since start-up.
+     */
+    static Counters processTotals();
+
+    /**
+     * @brief Writes the per-frame and per-phase summary to @p out.
+     * @param out  Destination stream.
+     */
+    static void writeReport(std::ostream& out);
+};
@@ -0,0 +1,88 @@
+/**
+ * @file Autopilot.cpp
+ * @brief Implementation of the Autopilot class.
+ */
+
+#include "Autopilot.hpp"
+#include "constants.hpp"
+
+#include <cmath> // std::abs
+
+/// Ticks the bot lingers on menus and end screens before pressing Launch.
+static constexpr int MENU_WAIT_TICKS = static_cast<int>(Constants::TICK_RATE);
+
+/// Pixels of slack before the bot starts moving the paddle while the ball
+/// is falling toward it, and while it is still rising and far away.  Like a
+/// player, the bot holds a key for a while rather than tapping every tick.
+static constexpr float DEAD_ZONE_FALLING = 8.0f;
+static constexpr float DEAD_ZONE_RISING  = 40.0f;
+
+// -----------------------------------------------------------------------------
+// Construction
+// -----------------------------------------------------------------------------
+
+Autopilot::Autopilot(std::uint32_t seed)
+    : rng(seed)
+    , waitTicks(MENU_WAIT_TICKS)
+    , aimOffset(0.0f)
+    , ballRising(false)
+    , heldDirection(0)
+{
+}
+
+// -----------------------------------------------------------------------------
+// Decision making
+// -----------------------------------------------------------------------------
+
+InputMask Autopilot::nextInput(const Simulation& sim)
+{
+    const Paddle& paddle = sim.getPaddle();
+    const Ball&   ball   = sim.getBall();
+
+    switch (sim.getState())
+    {
+    case GameState::MainMenu:
+    case GameState::GameOver:
+    case GameState::Victory:
+        // Start (or restart) the game after a short pause.
+        if (--waitTicks > 0)
+            return 0;
+        waitTicks = static_cast<int>(rng.uniform(0.1f, 0.6f) * Constants::TICK_RATE);
+        return Input::Launch;
+
+    case GameState::BallOnPaddle:
+        // Launch after a random pause; the launch angle itself is randomised
+        // by the simulation.
+        if (--waitTicks > 0)
+            return 0;
+        waitTicks = static_cast<int>(rng.uniform(0.1f, 0.6f) * Constants::TICK_RATE);
+        aimOffset = rng.uniform(-0.4f, 0.4f) * paddle.getWidth();
+        return Input::Launch;
+
+    case GameState::Playing:
+    {
+        // Pick a new aim point every time the ball turns back toward the
+        // paddle so consecutive rebounds head to different parts of the field.
+        bool rising = ball.getVelocity().y < 0.0f;
+        if (ballRising && !rising)
+            aimOffset = rng.uniform(-0.4f, 0.4f) * paddle.getWidth();
+        ballRising = rising;
+
+        float error = (ball.getPosition().x - aimOffset) - paddle.getCentreX();
+
+        // Keep moving until the target is reached (or passed); only start
+        // moving again once it is outside the dead zone.
+        if (heldDirection != 0 && error * static_cast<float>(heldDirection) > 0.0f)
+            return heldDirection < 0 ? Input::Left : Input::Right;
+
+        float deadZone = rising ? DEAD_ZONE_RISING : DEAD_ZONE_FALLING;
+        heldDirection = (std::abs(error) < deadZone) ? 0 : (error < 0.0f ? -1 : 1);
+        if (heldDirection == 0)
+            return 0;
+        return heldDirection < 0 ? Input::Left : Input::Right;
+    }
+
+    default:
+        return 0;
+    }
+}
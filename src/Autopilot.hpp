@@ -0,0 +1,50 @@
+/**
+ * @file Autopilot.hpp
+ * @brief Declaration of the Autopilot class — a deterministic bot player.
+ *
+ * Autopilot produces an InputMask for every simulation tick by looking at
+ * the current Simulation state, the same way a player looks at the screen.
+ * It starts games, launches the ball after a short random pause, and steers
+ * the paddle under the ball with a randomly chosen aim offset so rebounds
+ * cover the whole brick field.  It is good but not perfect: at high ball
+ * speeds it misses occasionally, so long sessions exercise life loss, game
+ * over and restarts as well as level transitions.
+ *
+ * All randomness comes from the Autopilot's own seed, so a Simulation and
+ * an Autopilot created with fixed seeds always play the same game.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "Input.hpp"
+#include "Random.hpp"
+#include "Simulation.hpp"
+
+/**
+ * @brief Bot that drives a Simulation through complete games.
+ */
+class Autopilot
+{
+public:
+    /**
+     * @brief Constructs a bot with its own random sequence.
+     * @param seed  Seed for aim offsets and launch delays.
+     */
+    explicit Autopilot(std::uint32_t seed);
+
+    /**
+     * @brief Chooses the input for the next tick of @p sim.
+     * @param sim  Simulation about to be stepped.
+     * @return InputMask  Input to pass to Simulation::step().
+     */
+    InputMask nextInput(const Simulation& sim);
+
+private:
+    Random        rng;           ///< Aim and delay random numbers.
+    int           waitTicks;     ///< Ticks to wait before the next Launch.
+    float         aimOffset;     ///< Paddle-centre offset from ball X, pixels.
+    bool          ballRising;    ///< Ball direction seen on the previous tick.
+    int           heldDirection; ///< -1 / 0 / +1: paddle key being held.
+};
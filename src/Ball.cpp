@@ -6,7 +6,6 @@
 #include "Ball.hpp"
 
 #include <cmath>
-#include <cstdlib>
 
 /// Mathematical constant π used for degree-to-radian conversions.
 static constexpr float PI = 3.14159265358979323846f;
@@ -55,25 +54,21 @@ void Ball::update(float deltaTime)
     shape.move(velocity * deltaTime);
 }
 
-void Ball::draw(sf::RenderWindow& window) const
+void Ball::draw(sf::RenderTarget& target) const
 {
-    window.draw(shape);
+    target.draw(shape);
 }
 
 // -----------------------------------------------------------------------------
 // Movement control
 // -----------------------------------------------------------------------------
 
-void Ball::launch(float speed)
+void Ball::launch(float speed, float angleOffsetDeg)
 {
     // Ignore repeated launch calls while the ball is already in flight.
     if (moving)
         return;
 
-    // Choose a random launch angle offset in [-45°, +45°] from straight up.
-    // std::rand is seeded once in main() via std::srand.
-    float angleOffsetDeg = static_cast<float>(std::rand() % 91) - 45.0f;
-
     // Straight upward in SFML is -90° (y-axis points down).
     float angleRad = toRadians(-90.0f + angleOffsetDeg);
 
@@ -94,6 +89,13 @@ void Ball::setPosition(float x, float y)
     shape.setPosition(x, y);
 }
 
+void Ball::restore(sf::Vector2f position, sf::Vector2f velocity, bool moving)
+{
+    shape.setPosition(position);
+    this->velocity = velocity;
+    this->moving   = moving;
+}
+
 // -----------------------------------------------------------------------------
 // Velocity manipulation
 // -----------------------------------------------------------------------------
@@ -47,21 +47,23 @@ public:
     void update(float deltaTime);
 
     /**
-     * @brief Draws the ball onto the given render window.
-     * @param window  The sf::RenderWindow to draw into.
+     * @brief Draws the ball onto the given render target.
+     * @param target  The window or offscreen texture to draw into.
      */
-    void draw(sf::RenderWindow& window) const;
+    void draw(sf::RenderTarget& target) const;
 
     /**
-     * @brief Launches the ball upward at a randomised angle.
+     * @brief Launches the ball upward.
      *
-     * The launch direction is between -45° and +45° from straight upward so
-     * the ball always moves toward the bricks.  The speed magnitude equals
-     * the @p speed parameter.  Has no effect if the ball is already moving.
+     * The launch direction is @p angleOffsetDeg from straight upward; the
+     * caller keeps it within ±45° so the ball always moves toward the
+     * bricks.  The speed magnitude equals the @p speed parameter.  Has no
+     * effect if the ball is already moving.
      *
-     * @param speed  Desired initial speed in pixels per second.
+     * @param speed           Desired initial speed in pixels per second.
+     * @param angleOffsetDeg  Launch angle relative to straight up, in degrees.
      */
-    void launch(float speed);
+    void launch(float speed, float angleOffsetDeg);
 
     /**
      * @brief Teleports the ball to (@p x, @p y) and stops all movement.
@@ -85,6 +87,17 @@ public:
      */
     void setPosition(float x, float y);
 
+    /**
+     * @brief Sets position, velocity and motion flag in one call.
+     *
+     * Used to restore a saved GameSnapshot.
+     *
+     * @param position  Centre position, in pixels.
+     * @param velocity  Velocity, in pixels per second.
+     * @param moving    Whether the ball is in flight.
+     */
+    void restore(sf::Vector2f position, sf::Vector2f velocity, bool moving);
+
     /**
      * @brief Negates the horizontal (X) component of velocity.
      *
@@ -1,111 +1,106 @@
 /**
  * @file Brick.cpp
- * @brief Implementation of the Brick class.
+ * @brief Implementation of the Brick and BrickPath record helpers.
  */
 
 #include "Brick.hpp"
+#include "constants.hpp"
 
-#include <cstdint> // uint8_t
+#include <algorithm>  // std::max
+#include <cmath>      // std::sin, std::cos, std::sqrt, std::abs
 
 // -----------------------------------------------------------------------------
-// Construction
+// Geometry
 // -----------------------------------------------------------------------------
 
-Brick::Brick(float x, float y, float width, float height,
-             sf::Color color, int hitPoints, int points)
-    : baseColor(color)
-    , hitPoints(hitPoints)
-    , maxHitPoints(hitPoints)
-    , points(points)
-    , destroyed(false)
+sf::FloatRect Brick::getBounds() const
 {
-    shape.setSize({width, height});
-    shape.setPosition(x, y);
-
-    // Thin dark outline to separate adjacent bricks visually.
-    shape.setOutlineThickness(1.5f);
-    shape.setOutlineColor(sf::Color(20, 20, 20, 200));
+    // The same rectangle sf::RectangleShape::getGlobalBounds() reports for
+    // an outlined brick, which is what collisions have always used.
+    return { x - OUTLINE_THICKNESS, y - OUTLINE_THICKNESS,
+             width + 2.0f * OUTLINE_THICKNESS, height + 2.0f * OUTLINE_THICKNESS };
+}
 
-    // Apply the initial (full-health) colour.
-    updateColor();
+sf::FloatRect Brick::getBlastBounds() const
+{
+    const sf::FloatRect bounds = getBounds();
+    const float         reachX = BLAST_REACH * width;
+    const float         reachY = BLAST_REACH * height;
+    return { bounds.left - reachX, bounds.top - reachY,
+             bounds.width + 2.0f * reachX, bounds.height + 2.0f * reachY };
 }
 
 // -----------------------------------------------------------------------------
-// Per-frame rendering
+// Appearance
 // -----------------------------------------------------------------------------
 
-void Brick::draw(sf::RenderWindow& window) const
+sf::Color Brick::getColor(int remaining) const
 {
-    if (destroyed)
-        return;
+    const sf::Color base(color);
 
-    window.draw(shape);
-}
+    // Compute a health fraction in [0, 1]; 1 = full health, 0 = nearly dead.
+    float healthFraction = static_cast<float>(remaining) / static_cast<float>(hitPoints);
 
-// -----------------------------------------------------------------------------
-// Game logic
-// -----------------------------------------------------------------------------
+    // Scale each channel from 40% (dim) at low health up to 100% at full health.
+    // This gives a clear visual progression without making any state look black.
+    float brightnessScale = 0.4f + 0.6f * healthFraction;
 
-void Brick::hit()
-{
-    if (destroyed)
-        return;
-
-    --hitPoints;
-
-    if (hitPoints <= 0)
-    {
-        hitPoints = 0;
-        destroyed = true;
-    }
-    else
-    {
-        // Update the visual colour to indicate the new damage level.
-        updateColor();
-    }
+    return sf::Color(static_cast<std::uint8_t>(base.r * brightnessScale),
+                     static_cast<std::uint8_t>(base.g * brightnessScale),
+                     static_cast<std::uint8_t>(base.b * brightnessScale),
+                     base.a);
 }
 
 // -----------------------------------------------------------------------------
-// Accessors
+// Paths
 // -----------------------------------------------------------------------------
 
-bool Brick::isDestroyed() const
-{
-    return destroyed;
-}
+static constexpr float TWO_PI = 6.28318531f;
 
-sf::FloatRect Brick::getBounds() const
+/// Angle of @p path at @p clock, in radians.
+static float pathAngle(const BrickPath& path, std::uint32_t clock)
 {
-    return shape.getGlobalBounds();
+    // Reduced to a whole cycle in integers first, so the angle is as exact
+    // after an hour of play as at the start.
+    std::uint32_t tick = clock % path.period + path.phase;
+    if (tick >= path.period)
+        tick -= path.period;
+    return TWO_PI * static_cast<float>(tick) / static_cast<float>(path.period);
 }
 
-int Brick::getPoints() const
+/// Angular speed of @p path, in radians per second.
+static float pathRate(const BrickPath& path)
 {
-    return points;
+    return TWO_PI * static_cast<float>(Constants::TICK_RATE) / static_cast<float>(path.period);
 }
 
-int Brick::getHitPoints() const
+sf::Vector2f BrickPath::getOffset(std::uint32_t clock) const
 {
-    return hitPoints;
-}
+    const float angle = pathAngle(*this, clock);
+    if (shape == PathShape::Orbit)
+        return { dx * std::cos(angle), dy * std::sin(angle) };
 
-// -----------------------------------------------------------------------------
-// Private helpers
-// -----------------------------------------------------------------------------
+    const float along = std::sin(angle);
+    return { dx * along, dy * along };
+}
 
-void Brick::updateColor()
+sf::Vector2f BrickPath::getVelocity(std::uint32_t clock) const
 {
-    // Compute a health fraction in [0, 1]; 1 = full health, 0 = nearly dead.
-    float healthFraction = static_cast<float>(hitPoints) /
-                           static_cast<float>(maxHitPoints);
+    const float angle = pathAngle(*this, clock);
+    const float rate  = pathRate(*this);
+    if (shape == PathShape::Orbit)
+        return { -dx * rate * std::sin(angle), dy * rate * std::cos(angle) };
 
-    // Scale each channel from 40% (dim) at low health up to 100% at full health.
-    // This gives a clear visual progression without making any state look black.
-    float brightnessScale = 0.4f + 0.6f * healthFraction;
-
-    uint8_t r = static_cast<uint8_t>(baseColor.r * brightnessScale);
-    uint8_t g = static_cast<uint8_t>(baseColor.g * brightnessScale);
-    uint8_t b = static_cast<uint8_t>(baseColor.b * brightnessScale);
+    const float along = rate * std::cos(angle);
+    return { dx * along, dy * along };
+}
 
-    shape.setFillColor(sf::Color(r, g, b));
+float BrickPath::getTopSpeed() const
+{
+    // A slide peaks at the centre of its line; an orbit where it crosses
+    // its longer axis.
+    const float reach = (shape == PathShape::Orbit)
+                      ? std::max(std::abs(dx), std::abs(dy))
+                      : std::sqrt(dx * dx + dy * dy);
+    return reach * pathRate(*this);
 }
@@ -1,105 +1,146 @@
 /**
  * @file Brick.hpp
- * @brief Declaration of the Brick class.
+ * @brief Declaration of Brick — one brick of a level layout.
  *
- * A Brick is a rectangular target that the ball must strike to destroy.
- * Bricks have a configurable number of hit points; multi-hit bricks appear
- * on higher difficulty levels.  The visual colour darkens proportionally as
- * the brick takes damage, giving the player clear feedback.
+ * A Brick is a plain record: where the brick is, how it looks, how many hits
+ * it takes and what it is worth.  Records never change during play; the
+ * Simulation keeps each brick's remaining hit points in a separate array,
+ * so a level's bricks can be shared by every simulation playing it and
+ * stored on disk exactly as they sit in memory (see Level.hpp).
+ *
+ * Moving bricks keep their record too.  The level lists a BrickPath for
+ * each, another plain record, and the brick's place at any tick is a pure
+ * function of the level clock: its record's position plus the path's offset
+ * at that tick.  Saving the clock saves every brick's position, and the
+ * simulation only has to track where the bricks are for its collision
+ * index (see MovingBricks.hpp).
+ *
+ * Colour feedback: a damaged brick is drawn in its base colour scaled down
+ * towards 40% brightness in proportion to the hit points it has lost, so a
+ * 3-HP brick visually progresses through three distinct shades.
+ *
+ * Explosive bricks (BrickType::Explosive) deal one hit to every brick their
+ * blast bounds touch when destroyed; an explosive brick destroyed by the blast
+ * explodes in turn, within the same tick (see Simulation::detonate()).
  */
 
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <type_traits>
 
 /**
- * @brief A single destructible brick in the Breakout playfield.
- *
- * Each brick tracks its remaining hit points.  When hit points reach zero the
- * brick is marked as destroyed and excluded from all subsequent rendering and
- * collision checks by the Game class.
+ * @brief What a brick does when it is destroyed.
+ */
+enum class BrickType : std::uint8_t
+{
+    Normal,     ///< Nothing more.
+    Explosive,  ///< Hits every brick its blast bounds touch.
+    Count       ///< Number of types; not a type.
+};
+
+/**
+ * @brief Immutable description of a single brick.
  *
- * Colour feedback: the brick fill is interpolated from its full base colour
- * down to 40% brightness as damage is accumulated, so a 3-HP brick visually
- * progresses through three distinct shades.
+ * The layout is part of the level file format; Level::FORMAT_VERSION must
+ * be bumped whenever it changes.
  */
-class Brick
+struct Brick
 {
-public:
-    /**
-     * @brief Constructs a Brick.
-     *
-     * @param x         Left edge of the brick, in pixels.
-     * @param y         Top edge of the brick, in pixels.
-     * @param width     Width of the brick, in pixels.
-     * @param height    Height of the brick, in pixels.
-     * @param color     Base fill colour at full health.
-     * @param hitPoints Number of hits required to destroy this brick (≥ 1).
-     * @param points    Score awarded to the player when the brick is destroyed.
-     */
-    Brick(float x, float y, float width, float height,
-          sf::Color color, int hitPoints, int points);
+    /// Thickness of the dark outline drawn around every brick, in pixels.
+    /// Collisions include it, so adjacent outlines close the gaps between
+    /// bricks for the ball.
+    static constexpr float OUTLINE_THICKNESS = 1.5f;
 
-    /**
-     * @brief Draws the brick onto the given render window.
-     *
-     * Does nothing if the brick has already been destroyed.
-     *
-     * @param window  The sf::RenderWindow to draw into.
-     */
-    void draw(sf::RenderWindow& window) const;
+    /// Reach of an explosion beyond the exploding brick's collision bounds,
+    /// as a fraction of its size: half its width to either side and half its
+    /// height above and below.  In a regular grid of any scale that is the
+    /// eight bricks around it and no further.
+    static constexpr float BLAST_REACH = 0.5f;
 
     /**
-     * @brief Registers one hit on this brick.
-     *
-     * Decrements hit points by one.  If hit points drop to zero the brick is
-     * flagged as destroyed and its colour is not updated further.  Otherwise
-     * the fill colour darkens to reflect the new damage level.
-     *
-     * Has no effect if the brick is already destroyed.
+     * @brief Returns the area an explosion of this brick damages.
+     * @return sf::FloatRect  Bounds in world coordinates.
      */
-    void hit();
+    sf::FloatRect getBlastBounds() const;
+
+    float         x;          ///< Left edge of the fill, pixels.
+    float         y;          ///< Top edge of the fill, pixels.
+    float         width;      ///< Fill width, pixels.
+    float         height;     ///< Fill height, pixels.
+    std::uint32_t color;      ///< Full-health colour as 0xRRGGBBAA.
+    std::int32_t  points;     ///< Score awarded when the brick is destroyed.
+    std::uint8_t  hitPoints;  ///< Hits needed to destroy the brick (≥ 1).
+    BrickType     type;       ///< What happens when it is destroyed.
+    std::uint8_t  reserved[2];///< Zero.
 
     /**
-     * @brief Returns whether this brick has been fully destroyed.
-     * @return true once hit points have reached zero; false while alive.
+     * @brief Returns the collision rectangle, outline included.
+     * @return sf::FloatRect  Bounds in world coordinates.
      */
-    bool isDestroyed() const;
+    sf::FloatRect getBounds() const;
 
     /**
-     * @brief Returns the brick's axis-aligned bounding rectangle.
+     * @brief Returns the fill colour for a brick with @p remaining hit points.
      *
-     * Only meaningful for collision purposes while isDestroyed() is false.
+     * Interpolates each RGB channel from 40% brightness (one hit left of
+     * many) up to 100% (full health); alpha is kept.
      *
-     * @return sf::FloatRect  Bounding rectangle in world coordinates.
+     * @param remaining  Remaining hit points (1 … hitPoints).
+     * @return sf::Color  Colour to draw the brick in.
      */
-    sf::FloatRect getBounds() const;
+    sf::Color getColor(int remaining) const;
+};
 
-    /**
-     * @brief Returns the score value awarded when this brick is destroyed.
-     * @return int  Point value (constant; unaffected by hit()).
-     */
-    int getPoints() const;
+static_assert(std::is_trivially_copyable<Brick>::value && sizeof(Brick) == 28,
+              "Brick is stored in level files byte for byte");
+
+/**
+ * @brief Shape of a moving brick's path.
+ */
+enum class PathShape : std::uint8_t
+{
+    Slide,  ///< Back and forth along a line, up to (dx, dy) either side.
+    Orbit,  ///< Round an ellipse with radii dx and dy, clockwise on screen.
+    Count   ///< Number of shapes; not a shape.
+};
+
+/**
+ * @brief How one brick of a level moves.
+ *
+ * The brick's position in its record is the centre of the path.  Motion
+ * is sinusoidal and exactly periodic in ticks, so a brick passes through
+ * the same positions every cycle however long the level is played.  Like
+ * Brick, the layout is part of the level file format.
+ */
+struct BrickPath
+{
+    std::uint32_t brick;      ///< Index of the brick that moves.
+    float         dx;         ///< Horizontal reach either side, pixels.
+    float         dy;         ///< Vertical reach either side, pixels.
+    std::uint32_t period;     ///< Ticks per cycle (≥ 1).
+    std::uint32_t phase;      ///< Ticks into the cycle at clock 0 (< period).
+    PathShape     shape;      ///< Slide or orbit.
+    std::uint8_t  reserved[3];///< Zero.
 
     /**
-     * @brief Returns the brick's remaining hit-point count.
-     * @return int  Remaining hit points (0 if destroyed).
+     * @brief Returns how far the brick is from its record's position.
+     * @param clock  Ticks the level has been played.
+     * @return sf::Vector2f  Offset in pixels.
      */
-    int getHitPoints() const;
+    sf::Vector2f getOffset(std::uint32_t clock) const;
 
-private:
     /**
-     * @brief Recomputes the fill colour to reflect the current damage level.
-     *
-     * Interpolates each RGB channel from 40% brightness (heavily damaged) up
-     * to 100% (full health), based on the ratio of remaining to maximum HP.
+     * @brief Returns the brick's velocity.
+     * @param clock  Ticks the level has been played.
+     * @return sf::Vector2f  Pixels per second.
      */
-    void updateColor();
-
-    sf::RectangleShape shape;       ///< Renderable rectangle.
-    sf::Color          baseColor;   ///< Full-health fill colour.
-    int                hitPoints;   ///< Current remaining hit points.
-    int                maxHitPoints;///< Starting hit points (for colour lerp).
-    int                points;      ///< Score awarded on destruction.
-    bool               destroyed;   ///< True once hit points reach zero.
+    sf::Vector2f getVelocity(std::uint32_t clock) const;
+
+    /// @return The brick's greatest speed along the path, pixels per second.
+    float getTopSpeed() const;
 };
+
+static_assert(std::is_trivially_copyable<BrickPath>::value && sizeof(BrickPath) == 24,
+              "BrickPath is stored in level files byte for byte");
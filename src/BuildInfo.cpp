@@ -0,0 +1,18 @@
+/**
+ * @file BuildInfo.cpp
+ * @brief Implementation of buildId().
+ *
+ * BREAKOUT_BUILD_ID is defined for this file only, so a changed revision
+ * recompiles a single translation unit.
+ */
+
+#include "BuildInfo.hpp"
+
+#ifndef BREAKOUT_BUILD_ID
+#define BREAKOUT_BUILD_ID "unknown"
+#endif
+
+const char* buildId()
+{
+    return BREAKOUT_BUILD_ID;
+}
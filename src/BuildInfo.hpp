@@ -0,0 +1,17 @@
+/**
+ * @file BuildInfo.hpp
+ * @brief Identification of the build, recorded in replays and reports.
+ */
+
+#pragma once
+
+/**
+ * @brief Returns the identifier of this build.
+ *
+ * The git revision the build was configured from (`git describe --always
+ * --dirty`), or "unknown" when built outside a git checkout.  CMake captures
+ * it at configure time, so re-run CMake after committing to refresh it.
+ *
+ * @return const char*  Null-terminated, static build identifier.
+ */
+const char* buildId();
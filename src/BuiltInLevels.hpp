@@ -0,0 +1,305 @@
+/**
+ * @file BuiltInLevels.hpp
+ * @brief The built-in campaign, laid out and indexed at compile time.
+ *
+ * Every built-in level is the same BRICK_ROWS × BRICK_COLS grid, centred
+ * horizontally; rows closer to the top are worth more points, and every
+ * level beyond the first adds one hit point to every brick.  Rather than
+ * working that out at startup, the brick records of all MAX_LEVELS levels
+ * and the collision index they share are computed here as constexpr
+ * tables, which the compiler places in read-only data.  Level::builtIn()
+ * copies them into a Level with three memcpys, as a compiled level file is
+ * loaded (see Level.hpp).
+ *
+ * The tables are checked where they are built: static_asserts reject a
+ * change to constants.hpp that pushes a brick out of the window, makes two
+ * bricks overlap or gives a brick more than 255 hit points.
+ *
+ * The index is built by the same counting sort as Level::buildIndex(), so
+ * a baked level is identical to one built from its bricks at run time.
+ * Every coordinate here is a multiple of half a pixel, which float holds
+ * exactly, so compile-time and run-time arithmetic cannot differ.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>    // std::index_sequence
+
+#include "Brick.hpp"
+#include "Level.hpp"
+#include "constants.hpp"
+
+namespace BuiltInLevels {
+
+    // =========================================================================
+    // Layout
+    // =========================================================================
+
+    /// Bricks in every built-in level.
+    constexpr std::size_t BRICK_COUNT =
+        static_cast<std::size_t>(Constants::BRICK_ROWS) * Constants::BRICK_COLS;
+
+    /// Width of the brick grid, gaps included.
+    constexpr float GRID_WIDTH =
+        static_cast<float>(Constants::BRICK_COLS) * Constants::BRICK_WIDTH +
+        static_cast<float>(Constants::BRICK_COLS - 1) * Constants::BRICK_PADDING;
+
+    /// Left edge of the first column, centring the grid in the window.
+    constexpr float GRID_LEFT = (static_cast<float>(Constants::WINDOW_WIDTH) - GRID_WIDTH) * 0.5f;
+
+    /**
+     * @brief Appearance and value of one brick row.
+     */
+    struct Row
+    {
+        std::uint32_t color;          ///< Fill colour as 0xRRGGBBAA.
+        int           points;         ///< Score per hit point of a brick.
+        int           baseHitPoints;  ///< Hit points at level 1.
+    };
+
+    /// @return An opaque colour as 0xRRGGBBAA (sf::Color::toInteger()).
+    constexpr std::uint32_t rgb(std::uint32_t red, std::uint32_t green, std::uint32_t blue)
+    {
+        return (red << 24) | (green << 16) | (blue << 8) | 0xFFu;
+    }
+
+    /// One entry per row, top row first.
+    constexpr Row ROWS[Constants::BRICK_ROWS] = {
+        { rgb(220,  45,  45), 60, 1 },  // Row 0 – Red     (highest value)
+        { rgb(230, 120,  20), 50, 1 },  // Row 1 – Orange
+        { rgb(210, 200,  20), 40, 1 },  // Row 2 – Yellow
+        { rgb( 45, 185,  45), 30, 1 },  // Row 3 – Green
+        { rgb( 45, 110, 225), 20, 1 },  // Row 4 – Blue
+        { rgb(135,  45, 205), 10, 1 },  // Row 5 – Purple  (lowest value)
+    };
+
+    /**
+     * @brief Lays out level @p number.
+     * @param number  Level number (1-based).
+     * @return The bricks, row by row from the top.
+     */
+    constexpr std::array<Brick, BRICK_COUNT> makeBricks(int number)
+    {
+        const int extraHitPoints = number > 1 ? number - 1 : 0;
+
+        std::array<Brick, BRICK_COUNT> bricks = {};
+        for (int row = 0; row < Constants::BRICK_ROWS; ++row)
+        {
+            for (int column = 0; column < Constants::BRICK_COLS; ++column)
+            {
+                Brick& brick = bricks[static_cast<std::size_t>(row * Constants::BRICK_COLS + column)];
+                brick.x = GRID_LEFT +
+                          static_cast<float>(column) * (Constants::BRICK_WIDTH + Constants::BRICK_PADDING);
+                brick.y = Constants::BRICK_TOP_OFFSET +
+                          static_cast<float>(row) * (Constants::BRICK_HEIGHT + Constants::BRICK_PADDING);
+                brick.width  = Constants::BRICK_WIDTH;
+                brick.height = Constants::BRICK_HEIGHT;
+
+                const int hitPoints = ROWS[row].baseHitPoints + extraHitPoints;
+                brick.hitPoints = static_cast<std::uint8_t>(hitPoints);
+                brick.points    = ROWS[row].points * hitPoints; // More HP → more points when destroyed.
+                brick.color     = ROWS[row].color;
+            }
+        }
+        return bricks;
+    }
+
+    // =========================================================================
+    // Checks
+    // =========================================================================
+
+    /// @return true if every brick of level @p number has 1 … 255 hit points.
+    constexpr bool hitPointsFit(int number)
+    {
+        for (const Row& row : ROWS)
+            if (row.baseHitPoints < 1 || row.baseHitPoints + number - 1 > 255)
+                return false;
+        return true;
+    }
+
+    /// @return true if every brick lies within the window.
+    constexpr bool fitsWindow(const std::array<Brick, BRICK_COUNT>& bricks)
+    {
+        for (const Brick& brick : bricks)
+        {
+            if (brick.x < 0.0f || brick.x + brick.width  > static_cast<float>(Constants::WINDOW_WIDTH) ||
+                brick.y < 0.0f || brick.y + brick.height > static_cast<float>(Constants::WINDOW_HEIGHT))
+                return false;
+        }
+        return true;
+    }
+
+    /// @return true if no two bricks' fills overlap.
+    constexpr bool disjoint(const std::array<Brick, BRICK_COUNT>& bricks)
+    {
+        for (std::size_t i = 0; i < BRICK_COUNT; ++i)
+        {
+            for (std::size_t j = i + 1; j < BRICK_COUNT; ++j)
+            {
+                const Brick& a = bricks[i];
+                const Brick& b = bricks[j];
+                if (a.x < b.x + b.width  && b.x < a.x + a.width &&
+                    a.y < b.y + b.height && b.y < a.y + a.height)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    // =========================================================================
+    // Collision index – Level::buildIndex() at compile time
+    // =========================================================================
+
+    /**
+     * @brief Placement of the index grid.
+     */
+    struct Grid
+    {
+        float         left;     ///< Left edge of cell column 0.
+        float         top;      ///< Top edge of cell row 0.
+        std::uint32_t columns;  ///< Cells per row.
+        std::uint32_t rows;     ///< Cell rows.
+    };
+
+    /// Collision bounds of a brick (Brick::getBounds(), which is not constexpr).
+    struct Bounds
+    {
+        float left, top, right, bottom;
+    };
+
+    constexpr Bounds boundsOf(const Brick& brick)
+    {
+        return { brick.x - Brick::OUTLINE_THICKNESS,
+                 brick.y - Brick::OUTLINE_THICKNESS,
+                 brick.x - Brick::OUTLINE_THICKNESS + (brick.width  + 2.0f * Brick::OUTLINE_THICKNESS),
+                 brick.y - Brick::OUTLINE_THICKNESS + (brick.height + 2.0f * Brick::OUTLINE_THICKNESS) };
+    }
+
+    /// std::floor, which is not constexpr, for the small values used here.
+    constexpr float floorOf(float value)
+    {
+        const float truncated = static_cast<float>(static_cast<long long>(value));
+        return truncated > value ? truncated - 1.0f : truncated;
+    }
+
+    /// Cells spanned along one axis, as Level.cpp's cellSpan().
+    constexpr bool cellSpan(float low, float high, float origin, std::uint32_t cells,
+                            std::uint32_t& first, std::uint32_t& last)
+    {
+        const float lowCell  = floorOf((low  - origin) / Level::CELL_SIZE);
+        const float highCell = floorOf((high - origin) / Level::CELL_SIZE);
+        const float maxCell  = static_cast<float>(cells - 1);
+
+        if (cells == 0 || highCell < 0.0f || lowCell > maxCell)
+            return false;
+
+        first = static_cast<std::uint32_t>(lowCell > 0.0f ? lowCell : 0.0f);
+        last  = static_cast<std::uint32_t>(highCell < maxCell ? highCell : maxCell);
+        return true;
+    }
+
+    /// @return The grid covering the union of every brick's bounds.
+    constexpr Grid makeGrid(const std::array<Brick, BRICK_COUNT>& bricks)
+    {
+        Bounds all = boundsOf(bricks[0]);
+        for (const Brick& brick : bricks)
+        {
+            const Bounds bounds = boundsOf(brick);
+            all.left   = bounds.left   < all.left   ? bounds.left   : all.left;
+            all.top    = bounds.top    < all.top    ? bounds.top    : all.top;
+            all.right  = bounds.right  > all.right  ? bounds.right  : all.right;
+            all.bottom = bounds.bottom > all.bottom ? bounds.bottom : all.bottom;
+        }
+        return { all.left, all.top,
+                 static_cast<std::uint32_t>((all.right  - all.left) / Level::CELL_SIZE) + 1,
+                 static_cast<std::uint32_t>((all.bottom - all.top)  / Level::CELL_SIZE) + 1 };
+    }
+
+    /**
+     * @brief Calls @p visit with every cell @p brick's bounds touch, in
+     *        ascending order.
+     */
+    template <typename Visit>
+    constexpr void forEachCell(const Grid& grid, const Brick& brick, Visit&& visit)
+    {
+        const Bounds bounds = boundsOf(brick);
+        std::uint32_t column0 = 0, column1 = 0, row0 = 0, row1 = 0;
+        if (!cellSpan(bounds.left, bounds.right,  grid.left, grid.columns, column0, column1) ||
+            !cellSpan(bounds.top,  bounds.bottom, grid.top,  grid.rows,    row0,    row1))
+            return;
+        for (std::uint32_t row = row0; row <= row1; ++row)
+            for (std::uint32_t column = column0; column <= column1; ++column)
+                visit(static_cast<std::size_t>(row) * grid.columns + column);
+    }
+
+    /// @return Entries of each cell, as offsets: cell c is [start[c], start[c + 1]).
+    template <std::size_t Cells>
+    constexpr std::array<std::uint32_t, Cells + 1> makeCellStart(const std::array<Brick, BRICK_COUNT>& bricks,
+                                                                 const Grid& grid)
+    {
+        std::array<std::uint32_t, Cells + 1> start = {};
+        for (const Brick& brick : bricks)
+            forEachCell(grid, brick, [&start](std::size_t cell) { ++start[cell + 1]; });
+        for (std::size_t cell = 0; cell < Cells; ++cell)
+            start[cell + 1] += start[cell];
+        return start;
+    }
+
+    /// @return Brick indices grouped by cell, ascending within each cell.
+    template <std::size_t Cells, std::size_t Entries>
+    constexpr std::array<std::uint32_t, Entries> makeCellBricks(const std::array<Brick, BRICK_COUNT>& bricks,
+                                                                const Grid& grid,
+                                                                const std::array<std::uint32_t, Cells + 1>& start)
+    {
+        std::array<std::uint32_t, Entries> entries = {};
+        std::array<std::uint32_t, Cells>   next    = {};
+        for (std::size_t cell = 0; cell < Cells; ++cell)
+            next[cell] = start[cell];
+        for (std::size_t i = 0; i < BRICK_COUNT; ++i)
+        {
+            forEachCell(grid, bricks[i], [&](std::size_t cell)
+            {
+                entries[next[cell]++] = static_cast<std::uint32_t>(i);
+            });
+        }
+        return entries;
+    }
+
+    // =========================================================================
+    // Baked tables
+    // =========================================================================
+
+    template <std::size_t... Index>
+    constexpr std::array<std::array<Brick, BRICK_COUNT>, sizeof...(Index)>
+    makeCampaign(std::index_sequence<Index...>)
+    {
+        return {{ makeBricks(static_cast<int>(Index) + 1)... }};
+    }
+
+    /// Bricks of every level; level n is LEVELS[n - 1].
+    constexpr std::array<std::array<Brick, BRICK_COUNT>, Constants::MAX_LEVELS> LEVELS =
+        makeCampaign(std::make_index_sequence<Constants::MAX_LEVELS>());
+
+    /// Index grid.  Levels differ only in hit points and points, so they
+    /// share one index.
+    constexpr Grid GRID = makeGrid(LEVELS[0]);
+
+    /// Index cells.
+    constexpr std::size_t CELLS = static_cast<std::size_t>(GRID.columns) * GRID.rows;
+
+    /// Entries of each cell, as offsets into CELL_BRICKS.
+    constexpr std::array<std::uint32_t, CELLS + 1> CELL_START = makeCellStart<CELLS>(LEVELS[0], GRID);
+
+    /// Brick indices grouped by cell.
+    constexpr std::array<std::uint32_t, CELL_START[CELLS]> CELL_BRICKS =
+        makeCellBricks<CELLS, CELL_START[CELLS]>(LEVELS[0], GRID, CELL_START);
+
+    static_assert(hitPointsFit(Constants::MAX_LEVELS),
+                  "built-in bricks must have 1 to 255 hit points on every level");
+    static_assert(fitsWindow(LEVELS[0]), "built-in bricks must lie within the window");
+    static_assert(disjoint(LEVELS[0]), "built-in bricks must not overlap");
+
+} // namespace BuiltInLevels
@@ -0,0 +1,233 @@
+/**
+ * @file EndlessField.cpp
+ * @brief Implementation of the EndlessField class.
+ */
+
+#include "EndlessField.hpp"
+#include "LevelGenerator.hpp"
+
+#include <algorithm>  // std::copy_n, std::fill_n
+
+// -----------------------------------------------------------------------------
+// Construction
+// -----------------------------------------------------------------------------
+
+EndlessField::EndlessField(std::uint32_t seed)
+    : seed(seed)
+    , clock(0)
+    , newest(0)
+    , filled(false)
+    , bricks(BRICK_COUNT)
+    , rowTops()
+    , feedRows(FEED_ROWS * COLUMNS)
+    , feedFirst(0)
+    , feedReady(0)
+    , feedEpoch(0)
+    , feedStop(false)
+{
+    seek(0);
+    feedThread = std::thread(&EndlessField::runFeed, this);
+}
+
+EndlessField::~EndlessField()
+{
+    {
+        std::lock_guard<std::mutex> lock(feedMutex);
+        feedStop = true;
+    }
+    feedWake.notify_one();
+    feedThread.join();
+}
+
+// -----------------------------------------------------------------------------
+// Movement
+// -----------------------------------------------------------------------------
+
+void EndlessField::seek(std::uint32_t now)
+{
+    const std::uint32_t target = START_ROWS - 1 + now / ROW_TICKS;
+
+    // Rows already in the ring stay; they would come out the same.
+    for (std::uint32_t age = 0; age < CAPACITY; ++age)
+    {
+        Brick* slot = &bricks[static_cast<std::size_t>((target + CAPACITY - age) % CAPACITY) * COLUMNS];
+        if (age > target)
+        {
+            // Before row 0, when the game has only just started: empty.
+            std::fill_n(slot, COLUMNS, Brick{});
+            continue;
+        }
+
+        const std::uint32_t row = target - age;
+        if (!filled || row > newest || row + CAPACITY <= newest)
+            LevelGenerator::generateRow(seed, row, slot);
+    }
+
+    if (!filled || target != newest)
+        restartFeed(target + 1);
+
+    clock  = now;
+    newest = target;
+    filled = true;
+    placeRows();
+}
+
+bool EndlessField::advance(std::uint32_t now)
+{
+    clock = now;
+
+    const std::uint32_t row     = START_ROWS - 1 + now / ROW_TICKS;
+    const bool          entered = row != newest;
+    if (entered)
+    {
+        newest = row;
+        take(row, &bricks[static_cast<std::size_t>(row % CAPACITY) * COLUMNS]);
+    }
+
+    placeRows();
+    return entered;
+}
+
+void EndlessField::placeRows()
+{
+    // A row's age in ticks is small, so this is exact however long the
+    // game has run.
+    static constexpr float PIXELS_PER_TICK = ROW_HEIGHT / static_cast<float>(ROW_TICKS);
+
+    for (std::uint32_t age = 0; age < CAPACITY; ++age)
+    {
+        const std::uint32_t ticks = clock % ROW_TICKS + age * ROW_TICKS;
+        rowTops[(newest + CAPACITY - age) % CAPACITY] = ENTRY_TOP + static_cast<float>(ticks) * PIXELS_PER_TICK;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Row feed
+// -----------------------------------------------------------------------------
+
+void EndlessField::take(std::uint32_t row, Brick* out)
+{
+    {
+        std::unique_lock<std::mutex> lock(feedMutex);
+        if (row >= feedFirst && row < feedReady)
+        {
+            std::copy_n(&feedRows[static_cast<std::size_t>(row % FEED_ROWS) * COLUMNS], COLUMNS, out);
+            feedFirst = row + 1;
+            lock.unlock();
+
+            // There is room for another row.
+            feedWake.notify_one();
+            return;
+        }
+    }
+
+    // The worker has fallen behind: make the row here and have it carry on
+    // after it.
+    LevelGenerator::generateRow(seed, row, out);
+    restartFeed(row + 1);
+}
+
+void EndlessField::restartFeed(std::uint32_t row)
+{
+    {
+        std::lock_guard<std::mutex> lock(feedMutex);
+        ++feedEpoch;
+        feedFirst = row;
+        feedReady = row;
+    }
+    feedWake.notify_one();
+}
+
+void EndlessField::runFeed()
+{
+    std::array<Brick, COLUMNS> generated;
+
+    std::unique_lock<std::mutex> lock(feedMutex);
+    for (;;)
+    {
+        feedWake.wait(lock, [this] { return feedStop || feedReady - feedFirst < FEED_ROWS; });
+        if (feedStop)
+            return;
+
+        // Generate without the lock; a restart meanwhile makes the row
+        // stale.
+        const std::uint32_t row   = feedReady;
+        const std::uint32_t epoch = feedEpoch;
+        lock.unlock();
+        LevelGenerator::generateRow(seed, row, generated.data());
+        lock.lock();
+
+        if (epoch == feedEpoch)
+        {
+            std::copy_n(generated.data(), COLUMNS, &feedRows[static_cast<std::size_t>(row % FEED_ROWS) * COLUMNS]);
+            ++feedReady;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Queries
+// -----------------------------------------------------------------------------
+
+std::uint32_t EndlessField::getNewestRow() const
+{
+    return newest;
+}
+
+std::uint32_t EndlessField::getRowStart(std::uint32_t row) const
+{
+    return (row % CAPACITY) * COLUMNS;
+}
+
+const std::vector<Brick>& EndlessField::getBricks() const
+{
+    return bricks;
+}
+
+Brick EndlessField::getBrick(std::uint32_t index) const
+{
+    Brick brick = bricks[index];
+    brick.y += rowTops[index / COLUMNS];
+    return brick;
+}
+
+sf::FloatRect EndlessField::getBounds(std::uint32_t index) const
+{
+    return getBrick(index).getBounds();
+}
+
+sf::Vector2f EndlessField::getVelocity() const
+{
+    return { 0.0f, ROW_HEIGHT * static_cast<float>(Constants::TICK_RATE) / static_cast<float>(ROW_TICKS) };
+}
+
+void EndlessField::findOverlapping(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const
+{
+    out.clear();
+
+    const float right  = area.left + area.width;
+    const float bottom = area.top  + area.height;
+
+    // A handful of rows and columns: test them all.
+    for (std::uint32_t age = CAPACITY; age-- > 0;)
+    {
+        if (age > newest)
+            continue;
+
+        const std::uint32_t slot = (newest - age) % CAPACITY;
+        const float         top  = rowTops[slot];
+        if (top - Brick::OUTLINE_THICKNESS >= bottom || top + ROW_HEIGHT + Brick::OUTLINE_THICKNESS <= area.top)
+            continue;
+
+        for (std::uint32_t index = slot * COLUMNS; index < (slot + 1) * COLUMNS; ++index)
+        {
+            if (bricks[index].hitPoints == 0)
+                continue;
+
+            const sf::FloatRect bounds = getBounds(index);
+            if (bounds.left < right && bounds.left + bounds.width  > area.left &&
+                bounds.top < bottom && bounds.top  + bounds.height > area.top)
+                out.push_back(index);
+        }
+    }
+}
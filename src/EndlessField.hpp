@@ -0,0 +1,179 @@
+/**
+ * @file EndlessField.hpp
+ * @brief Declaration of EndlessField — the streaming rows of endless mode.
+ *
+ * In endless mode (see LevelGenerator::endless()) the bricks never run
+ * out.  Rows of the classic brick grid come in above the window one at a
+ * time, and the whole field slides down by one row every ROW_TICKS ticks.
+ * A row still holding bricks when it reaches the deadline, DEADLINE_ROWS
+ * rows below where it came in, costs the player a life and is cleared, so
+ * a row that gets there is always forgotten.
+ *
+ * So no more than CAPACITY rows are ever in play, and the field keeps them
+ * in a ring: row n lives in slot n % CAPACITY, and its brick records are
+ * overwritten when row n + CAPACITY comes in.  Brick indices (slot ×
+ * COLUMNS + column) stay below BRICK_COUNT, the simulation's hit-point
+ * array keeps its size, and memory use is the same after an hour of play
+ * as after a minute.
+ *
+ * Rows are generated (LevelGenerator::generateRow()) on a worker thread,
+ * which keeps up to FEED_ROWS of them ready in a second ring, so a row
+ * coming in costs the game thread a copy of COLUMNS records, and nothing
+ * is allocated after construction.  A row depends only on the seed and
+ * its number, and where the rows are only on the level clock, so a row
+ * the worker has not finished, and every row after seek(), is simply
+ * generated on the spot, with the same result.
+ */
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Brick.hpp"
+#include "constants.hpp"
+
+/**
+ * @brief The ring of rows an endless game is played on.
+ *
+ * Not copyable: the worker thread belongs to the object.
+ */
+class EndlessField
+{
+public:
+    /// Bricks per row: the columns of the built-in levels.
+    static constexpr std::uint32_t COLUMNS = Constants::BRICK_COLS;
+
+    /// Height of one row, pixels.
+    static constexpr float ROW_HEIGHT = Constants::BRICK_HEIGHT + Constants::BRICK_PADDING;
+
+    /// Top of a row as it comes in, just above the window.
+    static constexpr float ENTRY_TOP = -ROW_HEIGHT;
+
+    /// Ticks between rows; the field slides down one row in this time.
+    static constexpr std::uint32_t ROW_TICKS = 6 * Constants::TICK_RATE;
+
+    /// Rows on the field when a game starts, row 0 lowest.
+    static constexpr std::uint32_t START_ROWS = 6;
+
+    /// Rows from the entry line to the deadline.
+    static constexpr std::uint32_t DEADLINE_ROWS = 18;
+
+    /// World y of the deadline: the bottom of a row that has come down
+    /// DEADLINE_ROWS rows.
+    static constexpr float DEADLINE = ENTRY_TOP + (DEADLINE_ROWS + 1) * ROW_HEIGHT;
+
+    /// Rows in the ring: those above the deadline and the one on it.
+    static constexpr std::uint32_t CAPACITY = DEADLINE_ROWS + 1;
+
+    /// Brick records in the ring.
+    static constexpr std::uint32_t BRICK_COUNT = CAPACITY * COLUMNS;
+
+    /// Rows the worker keeps ready.
+    static constexpr std::uint32_t FEED_ROWS = 16;
+
+    /// Rows per level: the level number, and the ball's speed with it,
+    /// rise each time this many more rows have come in.
+    static constexpr std::uint32_t ROWS_PER_LEVEL = 25;
+
+    /**
+     * @brief Creates the field for @p seed at clock 0 and starts its worker.
+     * @param seed  Row seed (see LevelGenerator::generateRow()).
+     */
+    explicit EndlessField(std::uint32_t seed);
+
+    /// Stops the worker.
+    ~EndlessField();
+
+    EndlessField(const EndlessField&)            = delete;
+    EndlessField& operator=(const EndlessField&) = delete;
+
+    /**
+     * @brief Puts the field where it is at level clock @p now.
+     *
+     * Generates the rows in play that are not already in the ring, on the
+     * calling thread, and points the worker at the rows after them; for
+     * starting a game and restoring snapshots.  The records come at full
+     * health, so the caller restores the bricks' hit points.
+     *
+     * @param now  Ticks the game has been played.
+     */
+    void seek(std::uint32_t now);
+
+    /**
+     * @brief Slides the field on to @p now, one tick after the last.
+     * @param now  Ticks the game has been played.
+     * @return true if a row came in: the slot of getNewestRow() holds its
+     *         records.
+     */
+    bool advance(std::uint32_t now);
+
+    /// @return Number of the newest row; row 0 is the lowest at the start.
+    std::uint32_t getNewestRow() const;
+
+    /**
+     * @brief Returns the index of the first brick of row @p row.
+     * @param row  A row in play: no more than CAPACITY - 1 rows older than
+     *             the newest.
+     */
+    std::uint32_t getRowStart(std::uint32_t row) const;
+
+    /// @return Brick records, COLUMNS per slot: x in playfield pixels and
+    ///         y from the top of the row.  Empty cells have no hit points.
+    const std::vector<Brick>& getBricks() const;
+
+    /// @return Brick @p index where it is now.
+    Brick getBrick(std::uint32_t index) const;
+
+    /// @return Collision bounds of brick @p index where it is now.
+    sf::FloatRect getBounds(std::uint32_t index) const;
+
+    /// @return Velocity of every brick, pixels per second.
+    sf::Vector2f getVelocity() const;
+
+    /**
+     * @brief Lists the bricks whose collision bounds overlap @p area where
+     *        they are now.
+     * @param area  Region to query, world coordinates.
+     * @param out   Cleared, then receives brick indices, lowest row first.
+     */
+    void findOverlapping(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const;
+
+private:
+    /// Copies row @p row from the worker into @p out, or generates it if
+    /// the worker does not have it.
+    void take(std::uint32_t row, Brick* out);
+
+    /// Drops the worker's rows and has it start again from row @p row.
+    void restartFeed(std::uint32_t row);
+
+    /// Body of the worker thread.
+    void runFeed();
+
+    /// Recomputes rowTops for the clock.
+    void placeRows();
+
+    const std::uint32_t seed;    ///< Row seed.
+    std::uint32_t       clock;   ///< Clock the field is at.
+    std::uint32_t       newest;  ///< Newest row in play.
+    bool                filled;  ///< Whether the ring holds the rows up to newest.
+
+    std::vector<Brick>               bricks;  ///< BRICK_COUNT records, row n in slot n % CAPACITY.
+    std::array<float, CAPACITY>      rowTops; ///< World y of the top of each slot's row.
+
+    // Shared with the worker, under feedMutex.
+    std::mutex              feedMutex;  ///< Guards the feed.
+    std::condition_variable feedWake;   ///< Wakes the worker for room or to stop.
+    std::vector<Brick>      feedRows;   ///< FEED_ROWS rows, row n in slot n % FEED_ROWS.
+    std::uint32_t           feedFirst;  ///< Next row the game will take.
+    std::uint32_t           feedReady;  ///< Rows [feedFirst, feedReady) are ready.
+    std::uint32_t           feedEpoch;  ///< Bumped on every restart; rows from before are stale.
+    bool                    feedStop;   ///< Set to end the worker.
+
+    std::thread             feedThread; ///< The worker; started last.
+};
@@ -0,0 +1,589 @@
+/**
+ * @file FlightRecorder.cpp
+ * @brief Implementation of the crash and hang flight recorder.
+ */
+
+#include "FlightRecorder.hpp"
+#include "BuildInfo.hpp"
+#include "Hash.hpp"
+#include "Simulation.hpp"
+
+#include <algorithm>  // std::max, std::min
+#include <chrono>     // std::chrono::steady_clock
+#include <csignal>    // std::raise, std::signal
+#include <cstring>    // std::memcpy, std::strlen
+#include <ctime>      // std::time
+#include <filesystem> // std::filesystem::create_directories
+#include <iostream>   // std::cerr
+#include <utility>    // std::swap
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#define BREAKOUT_HAVE_SIGACTION 1
+#else
+#include <cstdio> // std::fopen
+#endif
+
+/// firstTick value while nothing has been recorded.
+static constexpr std::uint32_t NO_TICK = 0xFFFFFFFFu;
+
+/// Build ids are cut to this length; Replay::load() rejects longer ones.
+static constexpr std::size_t MAX_BUILD_ID_BYTES = 256;
+
+/// Bytes per keyframe index entry (tick, offset, size).
+static constexpr std::size_t INDEX_ENTRY_BYTES = 12;
+
+/// How often the watchdog checks for heartbeats.
+static constexpr std::chrono::milliseconds WATCHDOG_POLL(250);
+
+/// Signals that trigger a crash dump.
+#ifdef BREAKOUT_HAVE_SIGACTION
+static constexpr int FATAL_SIGNALS[] = { SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT };
+#else
+static constexpr int FATAL_SIGNALS[] = { SIGSEGV, SIGFPE, SIGILL, SIGABRT };
+#endif
+static constexpr std::size_t FATAL_SIGNAL_COUNT = sizeof(FATAL_SIGNALS) / sizeof(FATAL_SIGNALS[0]);
+
+/// Recorder whose dump the signal handler writes; null when none is started.
+static std::atomic<FlightRecorder*> installedRecorder{ nullptr };
+
+// Handlers replaced by start(), restored by stop().  Only one recorder can
+// be installed, so they live here rather than in the class.
+#ifdef BREAKOUT_HAVE_SIGACTION
+static struct sigaction previousActions[FATAL_SIGNAL_COUNT];
+static stack_t          previousStack;
+
+/// Alternate signal stack size; a stack overflow leaves none to run on.
+static constexpr std::size_t SIGNAL_STACK_BYTES = 64 * 1024;
+#else
+using SignalHandler = void (*)(int);
+static SignalHandler previousHandlers[FATAL_SIGNAL_COUNT];
+#endif
+
+/// Largest clip encodeDump() can produce: one run byte per tick, every
+/// keyframe slot filled to @p slotBytes.
+static std::size_t worstCaseDumpBytes(std::size_t buildIdBytes, std::size_t slotBytes)
+{
+    return 64 + buildIdBytes + FlightRecorder::CAPACITY_TICKS +
+           FlightRecorder::KEYFRAME_SLOTS * (slotBytes + INDEX_ENTRY_BYTES);
+}
+
+// -----------------------------------------------------------------------------
+// Signal-safe encoding helpers
+// -----------------------------------------------------------------------------
+//
+// Replay.cpp's encoder appends to a std::vector; these write the same
+// little-endian layout through a cursor into preallocated memory.
+
+static void putU32(std::uint8_t*& out, std::uint32_t value)
+{
+    for (int shift = 0; shift < 32; shift += 8)
+        *out++ = static_cast<std::uint8_t>(value >> shift);
+}
+
+static void putVarint(std::uint8_t*& out, std::uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        *out++ = static_cast<std::uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<std::uint8_t>(value);
+}
+
+/// Writes one input run in the packed form Replay::encode() uses.
+static void putRun(std::uint8_t*& out, InputMask mask, std::uint32_t length)
+{
+    std::uint32_t extra = length - 1;
+    std::uint8_t  first = static_cast<std::uint8_t>(mask | ((extra & 0x7) << 4));
+    extra >>= 3;
+    if (extra == 0)
+    {
+        *out++ = first;
+    }
+    else
+    {
+        *out++ = static_cast<std::uint8_t>(first | 0x80);
+        putVarint(out, extra);
+    }
+}
+
+/// Writes @p message to stderr with write(2), which is async-signal-safe.
+static void writeStderr(const char* message)
+{
+#ifdef BREAKOUT_HAVE_SIGACTION
+    ssize_t ignored = ::write(STDERR_FILENO, message, std::strlen(message));
+    (void)ignored;
+#else
+    std::fputs(message, stderr);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// Construction
+// -----------------------------------------------------------------------------
+
+FlightRecorder::FlightRecorder()
+    : firstTick(NO_TICK)
+    , endTick(0)
+    , rewrites(0)
+    , slotBytes(0)
+    , dumping(false)
+    , heartbeats(0)
+    , stopping(false)
+    , active(false)
+{
+}
+
+FlightRecorder::~FlightRecorder()
+{
+    stop();
+}
+
+bool FlightRecorder::start(const std::string& dumpDirectory)
+{
+    if (active)
+        return true;
+
+    FlightRecorder* expected = nullptr;
+    if (!installedRecorder.compare_exchange_strong(expected, this))
+    {
+        std::cerr << "[Breakout] ERROR: Another flight recorder is already running.\n";
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(dumpDirectory, error);
+    if (error)
+    {
+        std::cerr << "[Breakout] ERROR: Could not create crash dump directory \""
+                  << dumpDirectory << "\": " << error.message() << "\n";
+        installedRecorder.store(nullptr);
+        return false;
+    }
+
+    inputs    = std::make_unique<std::atomic<std::uint8_t>[]>(CAPACITY_TICKS);
+    keyframes = std::make_unique<KeyframeSlot[]>(KEYFRAME_SLOTS);
+    firstTick.store(NO_TICK);
+    endTick.store(0);
+
+    buildIdCopy = ::buildId();
+    if (buildIdCopy.size() > MAX_BUILD_ID_BYTES)
+        buildIdCopy.resize(MAX_BUILD_ID_BYTES);
+
+    // Sized for the built-in levels up front; larger levels grow the slots
+    // when first recorded.
+    dumpEntries.resize(KEYFRAME_SLOTS);
+    slotBytes = GameSnapshot::fixedBytes() + Constants::BRICK_ROWS * Constants::BRICK_COLS;
+    for (std::uint32_t i = 0; i < KEYFRAME_SLOTS; ++i)
+        keyframes[i].packed.resize(slotBytes);
+    dumpBuffer.resize(worstCaseDumpBytes(buildIdCopy.size(), slotBytes));
+
+    directory = dumpDirectory;
+    crashPath = (std::filesystem::path(directory) /
+                 ("breakout-crash-" + std::to_string(std::time(nullptr)) + ".replay")).string();
+
+#ifdef BREAKOUT_HAVE_SIGACTION
+    signalStack.resize(SIGNAL_STACK_BYTES);
+    stack_t stack = {};
+    stack.ss_sp   = signalStack.data();
+    stack.ss_size = signalStack.size();
+    sigaltstack(&stack, &previousStack);
+
+    struct sigaction action = {};
+    action.sa_handler = &FlightRecorder::handleFatalSignal;
+    action.sa_flags   = SA_ONSTACK | SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+    for (std::size_t i = 0; i < FATAL_SIGNAL_COUNT; ++i)
+        sigaction(FATAL_SIGNALS[i], &action, &previousActions[i]);
+#else
+    for (std::size_t i = 0; i < FATAL_SIGNAL_COUNT; ++i)
+        previousHandlers[i] = std::signal(FATAL_SIGNALS[i], &FlightRecorder::handleFatalSignal);
+#endif
+
+    heartbeats.store(0);
+    stopping = false;
+    active   = true;
+    watchdog = std::thread(&FlightRecorder::watch, this);
+    return true;
+}
+
+void FlightRecorder::stop()
+{
+    if (!active)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(watchdogMutex);
+        stopping = true;
+    }
+    watchdogWake.notify_all();
+    watchdog.join();
+
+#ifdef BREAKOUT_HAVE_SIGACTION
+    for (std::size_t i = 0; i < FATAL_SIGNAL_COUNT; ++i)
+        sigaction(FATAL_SIGNALS[i], &previousActions[i], nullptr);
+    sigaltstack(&previousStack, nullptr);
+#else
+    for (std::size_t i = 0; i < FATAL_SIGNAL_COUNT; ++i)
+        std::signal(FATAL_SIGNALS[i], previousHandlers[i]);
+#endif
+
+    installedRecorder.store(nullptr);
+    active = false;
+}
+
+bool FlightRecorder::isActive() const
+{
+    return active;
+}
+
+// -----------------------------------------------------------------------------
+// Recording (main thread)
+// -----------------------------------------------------------------------------
+
+void FlightRecorder::record(const Simulation& sim, InputMask input)
+{
+    if (!active)
+        return;
+
+    const std::uint32_t tick = sim.getTick();
+    if (firstTick.load(std::memory_order_relaxed) == NO_TICK ||
+        tick != endTick.load(std::memory_order_relaxed))
+    {
+        // A jump in the tick count: the old window no longer leads here, so
+        // start a new one with a keyframe at its first tick.
+        firstTick.store(NO_TICK, std::memory_order_release);
+        rewrites.fetch_add(1, std::memory_order_release);
+        dropKeyframesFrom(0);
+        endTick.store(tick, std::memory_order_release);
+        storeKeyframe(sim);
+        firstTick.store(tick, std::memory_order_release);
+    }
+    else if (tick % Replay::KEYFRAME_INTERVAL == 0)
+    {
+        storeKeyframe(sim);
+    }
+
+    inputs[tick % CAPACITY_TICKS].store(static_cast<std::uint8_t>(input & Input::All),
+                                        std::memory_order_relaxed);
+    endTick.store(tick + 1, std::memory_order_release);
+}
+
+void FlightRecorder::truncate(std::uint32_t tick)
+{
+    if (!active || tick >= endTick.load(std::memory_order_relaxed))
+        return;
+
+    // The keyframe at the restored tick itself is still the right state.
+    rewrites.fetch_add(1, std::memory_order_release);
+    dropKeyframesFrom(tick + 1);
+    if (tick < firstTick.load(std::memory_order_relaxed))
+        firstTick.store(NO_TICK, std::memory_order_release);
+    endTick.store(tick, std::memory_order_release);
+}
+
+void FlightRecorder::heartbeat()
+{
+    heartbeats.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FlightRecorder::storeKeyframe(const Simulation& sim)
+{
+    sim.snapshot(keyframe);
+    const std::size_t size = keyframe.packedSize();
+
+    // Replace a keyframe of the same tick (left behind by a rewind), else
+    // fill an empty slot, else overwrite the oldest.
+    KeyframeSlot* target = nullptr;
+    for (std::uint32_t i = 0; i < KEYFRAME_SLOTS; ++i)
+    {
+        KeyframeSlot& slot = keyframes[i];
+        if (slot.used && slot.tick == keyframe.tick)
+        {
+            target = &slot;
+            break;
+        }
+        if (!target || (target->used && (!slot.used || slot.tick < target->tick)))
+            target = &slot;
+    }
+
+    if (size > target->packed.size() && !reserveKeyframe(*target, size))
+        return;
+
+    const std::uint32_t sequence = target->sequence.load(std::memory_order_relaxed);
+    target->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    keyframe.pack(target->packed.data());
+    target->tick   = keyframe.tick;
+    target->seed   = keyframe.seed;
+    target->levels = sim.getLevelPack()->getSource();
+    target->size   = size;
+    target->used   = true;
+    target->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool FlightRecorder::reserveKeyframe(KeyframeSlot& target, std::size_t size)
+{
+    // Resizing moves the bytes a dump may be copying, so dumps are held off
+    // meanwhile.  If one is running, this keyframe is skipped; the next one
+    // retries.
+    if (dumping.exchange(true, std::memory_order_acquire))
+        return false;
+
+    target.packed.resize(size);
+    if (size > slotBytes)
+    {
+        slotBytes = size;
+        dumpBuffer.resize(worstCaseDumpBytes(buildIdCopy.size(), slotBytes));
+    }
+
+    dumping.store(false, std::memory_order_release);
+    return true;
+}
+
+void FlightRecorder::dropKeyframesFrom(std::uint32_t tick)
+{
+    for (std::uint32_t i = 0; i < KEYFRAME_SLOTS; ++i)
+    {
+        KeyframeSlot& slot = keyframes[i];
+        if (!slot.used || slot.tick < tick)
+            continue;
+
+        const std::uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.used = false;
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Dumping (any thread, signal handlers)
+// -----------------------------------------------------------------------------
+
+bool FlightRecorder::readSlot(const KeyframeSlot& slot, DumpEntry& out)
+{
+    const std::uint32_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before & 1)
+        return false;
+    const bool used = slot.used;
+    out.tick   = slot.tick;
+    out.seed   = slot.seed;
+    out.levels = slot.levels;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return used && slot.sequence.load(std::memory_order_relaxed) == before;
+}
+
+std::size_t FlightRecorder::encodeDump()
+{
+    const std::uint32_t generation = rewrites.load(std::memory_order_acquire);
+    const std::uint32_t first      = firstTick.load(std::memory_order_acquire);
+    const std::uint32_t end        = endTick.load(std::memory_order_acquire);
+    if (first == NO_TICK || end < first)
+        return 0;
+
+    // Only ticks still in the input ring can be replayed, so the clip starts
+    // at the oldest keyframe inside it.
+    const std::uint32_t oldest = std::max(first, end > CAPACITY_TICKS ? end - CAPACITY_TICKS : 0u);
+
+    std::size_t count = 0;
+    for (std::uint32_t i = 0; i < KEYFRAME_SLOTS; ++i)
+    {
+        DumpEntry& entry = dumpEntries[count];
+        entry.slot = i;
+        if (readSlot(keyframes[i], entry) && entry.tick >= oldest && entry.tick <= end)
+            ++count;
+    }
+    if (count == 0)
+        return 0;
+
+    // Insertion sort: a few dozen entries, and std::sort is not guaranteed
+    // to be signal-safe.
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        for (std::size_t j = i; j > 0 && dumpEntries[j].tick < dumpEntries[j - 1].tick; --j)
+            std::swap(dumpEntries[j], dumpEntries[j - 1]);
+    }
+    const std::uint32_t start = dumpEntries[0].tick;
+
+    std::uint8_t* const begin = dumpBuffer.data();
+    std::uint8_t*       out   = begin;
+
+    std::memcpy(out, Replay::MAGIC, sizeof(Replay::MAGIC));
+    out += sizeof(Replay::MAGIC);
+    *out++ = Replay::FORMAT_VERSION;
+    putU32(out, dumpEntries[0].seed);
+    putU32(out, dumpEntries[0].levels);
+    putVarint(out, end);
+    putVarint(out, start);
+    putVarint(out, static_cast<std::uint32_t>(buildIdCopy.size()));
+    std::memcpy(out, buildIdCopy.data(), buildIdCopy.size());
+    out += buildIdCopy.size();
+
+    // Runs: counted first, since the count precedes them.
+    auto inputAt = [this](std::uint32_t tick) {
+        return static_cast<InputMask>(inputs[tick % CAPACITY_TICKS].load(std::memory_order_relaxed));
+    };
+    std::uint32_t runCount = 0;
+    for (std::uint32_t tick = start; tick < end; ++tick)
+    {
+        if (tick == start || inputAt(tick) != inputAt(tick - 1))
+            ++runCount;
+    }
+    putVarint(out, runCount);
+    for (std::uint32_t tick = start; tick < end;)
+    {
+        const InputMask mask   = inputAt(tick);
+        std::uint32_t   length = 1;
+        while (tick + length < end && inputAt(tick + length) == mask)
+            ++length;
+        putRun(out, mask, length);
+        tick += length;
+    }
+
+    // No state hashes: the recorder does not hash every tick.
+    putVarint(out, 0);
+
+    putVarint(out, static_cast<std::uint32_t>(count));
+    std::uint8_t* const blobStart = out;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // Copied under the slot's seqlock; a slot rewritten since it was
+        // chosen fails the whole dump, as the index is already decided.
+        DumpEntry&          entry  = dumpEntries[i];
+        const KeyframeSlot& slot   = keyframes[entry.slot];
+        const std::uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        if ((before & 1) || !slot.used || slot.tick != entry.tick)
+            return 0;
+        entry.size = static_cast<std::uint32_t>(std::min(slot.size, slot.packed.size()));
+        std::memcpy(out, slot.packed.data(), entry.size);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != before)
+            return 0;
+        out += entry.size;
+    }
+    const std::uint32_t indexOffset = static_cast<std::uint32_t>(out - begin);
+    std::uint32_t       offset      = static_cast<std::uint32_t>(blobStart - begin);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        putU32(out, dumpEntries[i].tick);
+        putU32(out, offset);
+        putU32(out, dumpEntries[i].size);
+        offset += dumpEntries[i].size;
+    }
+    putU32(out, indexOffset);
+    putU32(out, fnv1a(begin, static_cast<std::size_t>(out - begin)));
+
+    // If the main thread kept recording meanwhile (a watchdog dump of a loop
+    // that was only slow), the window must not have been rewritten or
+    // lapped by the ring.
+    if (rewrites.load(std::memory_order_acquire) != generation ||
+        endTick.load(std::memory_order_acquire) - start > CAPACITY_TICKS)
+    {
+        return 0;
+    }
+    return static_cast<std::size_t>(out - begin);
+}
+
+bool FlightRecorder::dump(const char* path)
+{
+    if (!active || dumping.exchange(true, std::memory_order_acquire))
+        return false;
+
+    const std::size_t size = encodeDump();
+    bool              ok   = size > 0;
+
+#ifdef BREAKOUT_HAVE_SIGACTION
+    if (ok)
+    {
+        const int file = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        ok = file >= 0;
+        std::size_t written = 0;
+        while (ok && written < size)
+        {
+            const ssize_t result = ::write(file, dumpBuffer.data() + written, size - written);
+            if (result > 0)
+                written += static_cast<std::size_t>(result);
+            else if (result < 0 && errno != EINTR)
+                ok = false;
+        }
+        if (file >= 0 && ::close(file) != 0)
+            ok = false;
+    }
+#else
+    // No signal-safe file API here; stdio is the best available.
+    if (ok)
+    {
+        std::FILE* file = std::fopen(path, "wb");
+        ok = file && std::fwrite(dumpBuffer.data(), 1, size, file) == size;
+        if (file && std::fclose(file) != 0)
+            ok = false;
+    }
+#endif
+
+    dumping.store(false, std::memory_order_release);
+    return ok;
+}
+
+void FlightRecorder::handleFatalSignal(int signal)
+{
+    FlightRecorder* recorder = installedRecorder.load();
+    if (recorder && recorder->dump(recorder->crashPath.c_str()))
+    {
+        writeStderr("[Breakout] ERROR: Crashed; the last minutes of play were saved to \"");
+        writeStderr(recorder->crashPath.c_str());
+        writeStderr("\".\n");
+    }
+
+    // The handler was reset to the default, so this terminates the process
+    // (with a core dump where enabled) exactly as the original signal would.
+#ifndef BREAKOUT_HAVE_SIGACTION
+    std::signal(signal, SIG_DFL);
+#endif
+    std::raise(signal);
+}
+
+// -----------------------------------------------------------------------------
+// Watchdog
+// -----------------------------------------------------------------------------
+
+void FlightRecorder::watch()
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::uint64_t     lastBeat   = heartbeats.load(std::memory_order_relaxed);
+    Clock::time_point lastChange = Clock::now();
+    bool              dumped     = false;
+
+    std::unique_lock<std::mutex> lock(watchdogMutex);
+    while (!watchdogWake.wait_for(lock, WATCHDOG_POLL, [this] { return stopping; }))
+    {
+        const std::uint64_t beat = heartbeats.load(std::memory_order_relaxed);
+        const Clock::time_point now = Clock::now();
+        if (beat != lastBeat)
+        {
+            lastBeat   = beat;
+            lastChange = now;
+            dumped     = false;
+            continue;
+        }
+
+        // Nothing to report before the first frame, and one dump per stall.
+        if (beat == 0 || dumped || now - lastChange < std::chrono::seconds(HANG_SECONDS))
+            continue;
+        dumped = true;
+
+        const std::string path = (std::filesystem::path(directory) /
+            ("breakout-hang-" + std::to_string(std::time(nullptr)) + ".replay")).string();
+        if (dump(path.c_str()))
+            std::cerr << "[Breakout] WARNING: The main loop has stalled for " << HANG_SECONDS
+                      << " seconds; the last minutes of play were saved to \"" << path << "\".\n";
+        else
+            std::cerr << "[Breakout] WARNING: The main loop has stalled for " << HANG_SECONDS
+                      << " seconds; the flight recorder could not save it.\n";
+    }
+}
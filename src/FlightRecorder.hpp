@@ -0,0 +1,218 @@
+/**
+ * @file FlightRecorder.hpp
+ * @brief Always-on recorder that saves the last minutes of play on a crash
+ *        or hang, as a replay clip.
+ *
+ * The game records every tick's input into a fixed ring of CAPACITY_TICKS
+ * bytes, and every Replay::KEYFRAME_INTERVAL ticks a packed snapshot into a
+ * small ring of keyframe slots.  Recording is a byte store and an atomic
+ * counter update per tick, so the recorder costs nothing noticeable.  The
+ * input ring is preallocated by start(); keyframe slots and the dump buffer
+ * grow on the main thread when a level with more bricks than any before it
+ * is recorded, and never otherwise.
+ *
+ * Dumping
+ * -------
+ * dump() writes the recorded window as a replay clip (see Replay.hpp): it
+ * starts at the oldest keyframe still covered by the input ring and carries
+ * every later keyframe, so the file opens in `Breakout --replay`, seeks, and
+ * re-simulates the moments before the problem exactly.  dump() allocates
+ * nothing and uses only async-signal-safe calls, so it runs from
+ *
+ *   - a handler for SIGSEGV, SIGBUS, SIGFPE, SIGILL and SIGABRT, which then
+ *     re-raises the signal so the process still dies (and dumps core) as it
+ *     would have; and
+ *   - a watchdog thread that dumps once whenever the main loop has not sent
+ *     a heartbeat() for HANG_SECONDS.
+ *
+ * Concurrency
+ * -----------
+ * The main thread is the only writer.  Inputs are stored with relaxed
+ * atomics and published by a release store of the end tick; each keyframe
+ * slot is a seqlock, so a dump that races a write (a signal arriving
+ * mid-copy, or the watchdog firing on a loop that was merely slow) skips
+ * the slot or fails instead of writing a torn snapshot.  Growing a slot
+ * moves its bytes, so the main thread only does so while holding the dump
+ * guard, and records that keyframe late if a dump is running.
+ *
+ * Seeks, resumed saves and other jumps in the tick count restart the window
+ * at the new tick; rewinding is reported through truncate() so history
+ * before the rewound span survives.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GameSnapshot.hpp"
+#include "Input.hpp"
+#include "Replay.hpp"
+#include "constants.hpp"
+
+class Simulation;
+
+/**
+ * @brief Ring buffer of recent inputs and keyframes, dumped as a replay.
+ *
+ * At most one recorder can be started at a time, since it owns the
+ * process's fatal-signal handlers.
+ */
+class FlightRecorder
+{
+public:
+    /// Ticks of input kept (three minutes of play).
+    static constexpr std::uint32_t CAPACITY_TICKS = 3 * 60 * Constants::TICK_RATE;
+
+    /// Keyframe slots: enough to cover the whole input ring, plus one being
+    /// overwritten and one at its oldest edge.
+    static constexpr std::uint32_t KEYFRAME_SLOTS =
+        CAPACITY_TICKS / Replay::KEYFRAME_INTERVAL + 2;
+
+    /// Seconds without a heartbeat before the watchdog dumps.
+    static constexpr std::uint32_t HANG_SECONDS = 5;
+
+    FlightRecorder();
+
+    /// Stops the recorder if it is running.
+    ~FlightRecorder();
+
+    FlightRecorder(const FlightRecorder&)            = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    /**
+     * @brief Allocates the rings, installs the signal handlers and starts
+     *        the watchdog.
+     *
+     * Crash dumps are named `breakout-crash-<time>.replay` after the start
+     * time, hang dumps `breakout-hang-<time>.replay` after the stall.
+     *
+     * @param dumpDirectory  Where dumps are written; created if missing.
+     * @return true on success; failures are reported to stderr and leave
+     *         the recorder off.
+     */
+    bool start(const std::string& dumpDirectory);
+
+    /**
+     * @brief Joins the watchdog and restores the previous signal handlers.
+     */
+    void stop();
+
+    /// @return true between a successful start() and stop().
+    bool isActive() const;
+
+    /**
+     * @brief Records the input of @p sim's next tick.
+     *
+     * Call immediately before stepping @p sim with @p input, like
+     * Replay::record().  Does nothing while the recorder is off.
+     *
+     * @param sim    Simulation about to be stepped.
+     * @param input  Mask it will be stepped with.
+     */
+    void record(const Simulation& sim, InputMask input);
+
+    /**
+     * @brief Discards every tick from @p tick onwards (the game rewound).
+     * @param tick  Tick the simulation was restored to.
+     */
+    void truncate(std::uint32_t tick);
+
+    /**
+     * @brief Tells the watchdog the main loop is alive; call once per frame.
+     */
+    void heartbeat();
+
+    /**
+     * @brief Writes the recorded window to @p path as a replay clip.
+     *
+     * Async-signal-safe.  Concurrent calls are not queued: a dump that
+     * starts while another is in progress fails.
+     *
+     * @param path  Destination file.
+     * @return true if the file was written.
+     */
+    bool dump(const char* path);
+
+private:
+    /// One packed keyframe, guarded by a sequence counter (odd while being
+    /// written).
+    struct KeyframeSlot
+    {
+        std::atomic<std::uint32_t> sequence{ 0 };
+        bool                       used = false;
+        std::uint32_t              tick   = 0; ///< Tick of the snapshot.
+        std::uint32_t              seed   = 0; ///< Seed of the snapshot.
+        std::uint32_t              levels = 0; ///< LevelPack::getSource() of its game.
+        std::size_t                size   = 0; ///< Packed bytes in use.
+        std::vector<std::uint8_t>  packed;     ///< Resized only under the dump guard.
+    };
+
+    /// A keyframe chosen for a dump.
+    struct DumpEntry
+    {
+        std::uint32_t tick;   ///< Keyframe tick.
+        std::uint32_t seed;   ///< Keyframe seed.
+        std::uint32_t levels; ///< Keyframe level source.
+        std::uint32_t slot;   ///< Index of its slot.
+        std::uint32_t size;   ///< Bytes copied into the dump.
+    };
+
+    /// Copies @p sim's state into the next keyframe slot.
+    void storeKeyframe(const Simulation& sim);
+
+    /// Empties every keyframe slot holding tick @p tick or a later one.
+    void dropKeyframesFrom(std::uint32_t tick);
+
+    /**
+     * @brief Grows slot @p target and the dump buffer to fit @p size bytes.
+     * @return false if a dump is running and nothing could be grown.
+     */
+    bool reserveKeyframe(KeyframeSlot& target, std::size_t size);
+
+    /// Reads @p slot's tick, seed and levels consistently.  @return false if empty
+    /// or mid-write.
+    static bool readSlot(const KeyframeSlot& slot, DumpEntry& out);
+
+    /// Encodes the window into dumpBuffer.  @return Encoded size, or 0.
+    std::size_t encodeDump();
+
+    /// Watchdog thread body.
+    void watch();
+
+    /// Fatal-signal handler: dumps to crashPath, then re-raises @p signal.
+    static void handleFatalSignal(int signal);
+
+    std::unique_ptr<std::atomic<std::uint8_t>[]> inputs;    ///< Input of tick t at t % CAPACITY_TICKS.
+    std::unique_ptr<KeyframeSlot[]>              keyframes; ///< KEYFRAME_SLOTS slots.
+
+    std::atomic<std::uint32_t> firstTick; ///< First tick of the current window (NO_TICK = none).
+    std::atomic<std::uint32_t> endTick;   ///< Tick after the last recorded one.
+    std::atomic<std::uint32_t> rewrites;  ///< Bumped whenever recorded ticks are discarded.
+
+    GameSnapshot               keyframe;      ///< Main-thread scratch snapshot.
+    std::size_t                slotBytes;     ///< Largest keyframe slot capacity.
+
+    std::vector<std::uint8_t>  dumpBuffer;    ///< Worst-case encoded size, preallocated.
+    std::vector<DumpEntry>     dumpEntries;   ///< Keyframes of the dump being written.
+    std::atomic<bool>          dumping;       ///< A dump is in progress (the dump guard).
+
+    std::string buildIdCopy; ///< Build id written into dumps.
+    std::string directory;   ///< Where dumps are written.
+    std::string crashPath;   ///< Dump file for fatal signals.
+
+    std::atomic<std::uint64_t> heartbeats;     ///< Frames reported by heartbeat().
+    std::thread                watchdog;       ///< Runs watch().
+    std::mutex                 watchdogMutex;  ///< Guards stopping.
+    std::condition_variable    watchdogWake;   ///< Signals stopping.
+    bool                       stopping;       ///< stop() was called.
+
+    std::vector<char>          signalStack;    ///< Alternate stack for stack-overflow crashes.
+    bool                       active;         ///< start() succeeded.
+};
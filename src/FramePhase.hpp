@@ -0,0 +1,45 @@
+/**
+ * @file FramePhase.hpp
+ * @brief Names the phases of one iteration of the main loop.
+ *
+ * Instrumentation (allocation tracking, hardware counters, benchmarks) uses
+ * these phases to attribute cost to the part of the frame that incurred it.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief The three steps Game::run performs every frame, in order.
+ */
+enum class FramePhase
+{
+    /// Draining the window event queue (Game::processEvents).
+    Events,
+
+    /// Fixed simulation ticks (Game::advanceSimulation, Simulation::step).
+    Update,
+
+    /// Drawing and presenting the frame (Game::render).
+    Render
+};
+
+/// Number of FramePhase values; sizes per-phase arrays.
+constexpr std::size_t FRAME_PHASE_COUNT = 3;
+
+/**
+ * @brief Returns a short lower-case label for @p phase, for reports.
+ * @param phase  Phase to name.
+ * @return const char*  Static string such as "update".
+ */
+inline const char* framePhaseName(FramePhase phase)
+{
+    switch (phase)
+    {
+    case FramePhase::Events: return "events";
+    case FramePhase::Update: return "update";
+    case FramePhase::Render: return "render";
+    }
+    return "?";
+}
@@ -4,74 +4,192 @@
  */
 
 #include "Game.hpp"
+#include "AllocTracker.hpp"
+#include "LevelGenerator.hpp"
+#include "SaveState.hpp"
 #include "constants.hpp"
 
 #include <SFML/Graphics.hpp>
 
-#include <algorithm>  // std::min, std::max
-#include <array>
-#include <cmath>      // std::sqrt, std::sin, std::cos
-#include <cstdlib>    // std::srand, std::rand
+#include <algorithm>  // std::min
+#include <cstdio>     // std::remove
 #include <ctime>      // std::time
-#include <iostream>   // std::cerr
-#include <sstream>    // std::ostringstream
+#include <filesystem> // std::filesystem::exists
+#include <iostream>   // std::cerr, std::cout
+#include <memory>     // std::make_shared
+#include <utility>    // std::move
+
+/// Ticks skipped by one press of the replay seek keys (five seconds).
+static constexpr std::uint32_t REPLAY_SEEK_TICKS = 5 * Constants::TICK_RATE;
+
+/// Consecutive Playing frames before the allocation tracker treats frames as
+/// steady state (about one second at the target frame rate).
+static constexpr int ALLOC_WARMUP_FRAMES = static_cast<int>(Constants::FRAME_RATE);
+
+/// True for the states that have no game in progress; leaving one of them
+/// for BallOnPaddle starts a new game.
+static bool isIdle(GameState state)
+{
+    return state == GameState::MainMenu || state == GameState::GameOver ||
+           state == GameState::Victory;
+}
 
 // =============================================================================
-// Brick layout data – one entry per row, top row first
+// Telemetry
 // =============================================================================
 
-/// Fill colours for each brick row.
-static const std::array<sf::Color, Constants::BRICK_ROWS> ROW_COLORS = {{
-    sf::Color(220,  45,  45),  // Row 0 – Red     (highest value)
-    sf::Color(230, 120,  20),  // Row 1 – Orange
-    sf::Color(210, 200,  20),  // Row 2 – Yellow
-    sf::Color( 45, 185,  45),  // Row 3 – Green
-    sf::Color( 45, 110, 225),  // Row 4 – Blue
-    sf::Color(135,  45, 205),  // Row 5 – Purple  (lowest value)
-}};
-
-/// Base score awarded per brick in each row (multiplied by hit-point count).
-static const std::array<int, Constants::BRICK_ROWS> ROW_POINTS = {{
-    60, 50, 40, 30, 20, 10
-}};
-
-/// Hit points for each brick row at level 1.  Higher levels add extras.
-static const std::array<int, Constants::BRICK_ROWS> ROW_BASE_HIT_POINTS = {{
-    1, 1, 1, 1, 1, 1
-}};
+Game::Telemetry::Telemetry(MetricsRegistry& registry)
+    : frameSeconds(registry.addHistogram(
+          "breakout_frame_seconds", "Wall-clock duration of each presented frame.",
+          { 0.004, 0.008, 0.012, 0.0167, 0.020, 0.025, 0.0333, 0.050, 0.100, 0.250 }))
+    , frames(registry.addCounter(
+          "breakout_frames_total", "Frames presented."))
+    , ticks(registry.addCounter(
+          "breakout_ticks_total", "Fixed simulation ticks executed."))
+    , heapAllocations(registry.addCounter(
+          "breakout_heap_allocations_total",
+          "Heap allocations made by the main loop (allocation-tracking builds only)."))
+    , gamesStarted(registry.addCounter(
+          "breakout_games_started_total", "Games started from the menu or an end screen."))
+    , gamesOver(registry.addCounter(
+          "breakout_games_over_total", "Games ended by losing the last life."))
+    , livesLost(registry.addCounter(
+          "breakout_lives_lost_total", "Balls lost past the paddle."))
+    , levelSeconds(registry.addHistogram(
+          "breakout_level_completion_seconds",
+          "Time in play from the start of a level until its last brick is destroyed.",
+          { 15.0, 30.0, 45.0, 60.0, 90.0, 120.0, 180.0, 300.0, 600.0 }))
+    , score(registry.addGauge("breakout_score", "Score of the current game."))
+    , level(registry.addGauge("breakout_level", "Level of the current game."))
+    , lives(registry.addGauge("breakout_lives", "Lives remaining in the current game."))
+{
+}
 
 // =============================================================================
 // Construction
 // =============================================================================
 
-Game::Game(const std::string& fontPath)
+Game::Game(const std::string& fontPath, const GameOptions& options)
     : window(
         sf::VideoMode(Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT),
         Constants::WINDOW_TITLE,
         sf::Style::Titlebar | sf::Style::Close)
-    , ball(
-        Constants::WINDOW_WIDTH  * 0.5f,
-        Constants::WINDOW_HEIGHT * 0.5f,
-        Constants::BALL_RADIUS)
-    , paddle(
-        (Constants::WINDOW_WIDTH  - Constants::PADDLE_WIDTH)  * 0.5f,
-        Constants::WINDOW_HEIGHT  - Constants::PADDLE_Y_OFFSET,
-        Constants::PADDLE_WIDTH,
-        Constants::PADDLE_HEIGHT,
-        Constants::PADDLE_SPEED)
-    , state(GameState::MainMenu)
-    , score(0)
-    , lives(Constants::INITIAL_LIVES)
-    , level(1)
-    , ballSpeed(Constants::BALL_INITIAL_SPEED)
-    , levelCompleteTimer(0.0f)
-    , bricksRemaining(0)
-    , previousState(GameState::MainMenu)
+    , levels(LevelPack::builtIn())
+    , sim(options.hasSeed ? options.seed : static_cast<std::uint32_t>(std::time(nullptr)))
+    , renderer(font)
+    , tickAccumulator(0.0f)
+    , pendingCommands(0)
+    , showingControls(false)
+    , latencyProbe(options.latencyTest, options.latencyLogPath)
+    , steadyPlayingFrames(0)
+    , telemetry(metrics)
+    , metricsServer(metrics)
+    , levelPlayTicks(0)
+    , recordPath(options.recordPath)
+    , player(playback)
+    , replaying(false)
+    , replayDesynced(false)
+    , rewind(Constants::REWIND_SECONDS * Constants::TICK_RATE)
+    , savePath(options.replayPath.empty() && options.recordPath.empty()
+                   ? options.savePath : std::string())
+    , ownsSave(false)
+    , ghostPlayer(ghostReplay)
+    , ghost(0)
+    , ghostStartTick(0)
+    , hasGhost(false)
+    , ghostRunning(false)
 {
     window.setFramerateLimit(Constants::FRAME_RATE);
 
-    // Seed the RNG used for ball launch-angle randomisation.
-    std::srand(static_cast<unsigned int>(std::time(nullptr)));
+    if (!options.levelsPath.empty())
+    {
+        std::shared_ptr<LevelPack> pack;
+        if (!LevelPack::loadDirectory(options.levelsPath, pack))
+        {
+            // Nothing was played, so leave any save-state alone.
+            savePath.clear();
+            window.close();
+            return;
+        }
+        // Start failures are reported by the watcher; the game then plays
+        // the levels as loaded.
+        if (options.watchLevels && levelWatcher.start(options.levelsPath, pack) &&
+            !options.recordPath.empty())
+            std::cerr << "[Breakout] WARNING: Level reloads are not recorded; the replay "
+                         "only plays back if no level changes.\n";
+
+        levels = std::move(pack);
+        sim    = Simulation(sim.getSeed(), levels);
+    }
+    else if (options.generateLevels)
+    {
+        levels = LevelGenerator::campaign(options.levelSeed);
+        sim    = Simulation(sim.getSeed(), levels);
+    }
+    else if (options.endless)
+    {
+        levels = LevelGenerator::endless(options.endlessSeed);
+        sim    = Simulation(sim.getSeed(), levels);
+    }
+
+    if (options.assertNoAllocations)
+    {
+        if (AllocTracker::isEnabled())
+            AllocTracker::setSteadyStateAssertion(true);
+        else
+            std::cerr << "[Breakout] WARNING: --assert-no-alloc needs a build with "
+                         "BREAKOUT_ALLOC_TRACKING (e.g. a Debug build); ignoring.\n";
+    }
+
+    // Failure to open the counters is reported inside open(); the game then
+    // simply runs without them.
+    if (options.perfCounters)
+        perfCounters.open();
+
+    // As with the counters, start failures are reported by the server and
+    // the game runs without an endpoint.
+    if (!options.metricsSocketPath.empty())
+        metricsServer.startUnix(options.metricsSocketPath);
+    else if (options.metricsPort > 0)
+        metricsServer.startTcp(options.metricsPort);
+
+    // Likewise, the game runs without a flight recorder if it cannot start.
+    if (!options.crashDirectory.empty())
+        flightRecorder.start(options.crashDirectory);
+
+    if (!options.replayPath.empty())
+    {
+        if (!Replay::load(options.replayPath, levels->getSource(), playback))
+        {
+            window.close();
+            return;
+        }
+        // Replays are only meaningful with the seed they were recorded with;
+        // clips start from their first keyframe.
+        sim       = Simulation(playback.getSeed(), levels);
+        player.seek(sim, playback.getStartTick());
+        replaying = true;
+    }
+
+    if (!recordPath.empty())
+    {
+        // Roughly an hour of typical play, so recording never allocates
+        // during a normal session.
+        static constexpr std::size_t RECORDING_RESERVE_RUNS = 1u << 15;
+        static constexpr std::size_t RECORDING_RESERVE_KEYFRAMES =
+            3600u * Constants::TICK_RATE / Replay::KEYFRAME_INTERVAL;
+
+        recording = Replay(sim.getSeed(), levels->getSource());
+        recording.reserveRuns(RECORDING_RESERVE_RUNS);
+        recording.reserveKeyframes(RECORDING_RESERVE_KEYFRAMES);
+        recording.reserveStateHashes(3600u * Constants::TICK_RATE);
+    }
+
+    if (!options.ghostPath.empty())
+        loadGhost(options.ghostPath);
+
+    if (!savePath.empty())
+        resumeSavedGame();
 
     if (!font.loadFromFile(fontPath))
     {
@@ -81,9 +199,6 @@ Game::Game(const std::string& fontPath)
         window.close();
         return;
     }
-
-    createBricks();
-    resetBallOnPaddle();
 }
 
 // =============================================================================
@@ -96,115 +211,64 @@ void Game::run()
     {
         // Measure the time elapsed since the last frame.
         float deltaTime = clock.restart().asSeconds();
+        flightRecorder.heartbeat();
 
-        // Cap deltaTime so that dragging the window, pausing in a debugger, or
-        // coming back from system sleep does not produce a huge physics jump.
-        deltaTime = std::min(deltaTime, 0.05f);
-
-        processEvents();
+        AllocTracker::beginFrame();
 
-        // Only run physics-related update() when there is meaningful activity.
-        switch (state)
         {
-        case GameState::Playing:
-        case GameState::BallOnPaddle:
-            update(deltaTime);
-            break;
-
-        case GameState::LevelComplete:
-            // Tick the post-level celebration timer.
-            levelCompleteTimer -= deltaTime;
-            if (levelCompleteTimer <= 0.0f)
-                advanceLevel();
-            break;
-
-        default:
-            break;
+            AllocTracker::Zone zone(FramePhase::Events);
+            PerfCounters::Scope counters(perfCounters, FramePhase::Events);
+            processEvents();
         }
 
-        render();
-    }
-}
-
-// =============================================================================
-// Initialisation helpers
-// =============================================================================
-
-void Game::createBricks()
-{
-    bricks.clear();
-
-    // Extra hit points are added to every brick for each level beyond the first,
-    // making later levels progressively harder without changing the layout.
-    int extraHitPoints = std::max(0, level - 1);
-
-    // Compute the total grid width so we can centre it within the window.
-    float totalGridWidth =
-        static_cast<float>(Constants::BRICK_COLS) * Constants::BRICK_WIDTH +
-        static_cast<float>(Constants::BRICK_COLS - 1) * Constants::BRICK_PADDING;
-
-    float gridStartX = (static_cast<float>(Constants::WINDOW_WIDTH) - totalGridWidth) * 0.5f;
-
-    for (int row = 0; row < Constants::BRICK_ROWS; ++row)
-    {
-        for (int col = 0; col < Constants::BRICK_COLS; ++col)
+        int ticks = 0;
         {
-            float x = gridStartX +
-                      static_cast<float>(col) * (Constants::BRICK_WIDTH + Constants::BRICK_PADDING);
-
-            float y = Constants::BRICK_TOP_OFFSET +
-                      static_cast<float>(row) * (Constants::BRICK_HEIGHT + Constants::BRICK_PADDING);
+            AllocTracker::Zone zone(FramePhase::Update);
+            PerfCounters::Scope counters(perfCounters, FramePhase::Update);
+            ticks = advanceSimulation(deltaTime);
+        }
 
-            int hp     = ROW_BASE_HIT_POINTS[row] + extraHitPoints;
-            int points = ROW_POINTS[row] * hp; // More HP → more points when destroyed.
+        // Whatever input arrived before these ticks has now been acted upon.
+        if (ticks > 0)
+            latencyProbe.onTickConsumed();
 
-            bricks.emplace_back(x, y,
-                                Constants::BRICK_WIDTH, Constants::BRICK_HEIGHT,
-                                ROW_COLORS[row], hp, points);
+        {
+            AllocTracker::Zone zone(FramePhase::Render);
+            PerfCounters::Scope counters(perfCounters, FramePhase::Render);
+            render();
         }
-    }
 
-    bricksRemaining = static_cast<int>(bricks.size());
-}
-
-void Game::resetBallOnPaddle()
-{
-    // Place the ball exactly on top of the paddle centre.
-    float ballX = paddle.getCentreX();
-    float ballY = paddle.getTopY() - Constants::BALL_RADIUS - 1.0f;
-    ball.reset(ballX, ballY);
+        perfCounters.endFrame(ticks);
 
-    state = GameState::BallOnPaddle;
-}
+        // Frames count as steady state once the ball has been in uninterrupted
+        // play long enough for one-off allocations (first-use caches, glyph
+        // uploads) to be behind us.
+        steadyPlayingFrames = (sim.getState() == GameState::Playing) ? steadyPlayingFrames + 1 : 0;
+        AllocTracker::endFrame(steadyPlayingFrames > ALLOC_WARMUP_FRAMES);
 
-void Game::restartGame()
-{
-    score     = 0;
-    lives     = Constants::INITIAL_LIVES;
-    level     = 1;
-    ballSpeed = Constants::BALL_INITIAL_SPEED;
+        recordFrameMetrics(deltaTime);
+    }
 
-    // Re-centre the paddle.
-    paddle.setPositionX(
-        (static_cast<float>(Constants::WINDOW_WIDTH) - Constants::PADDLE_WIDTH) * 0.5f);
+    metricsServer.stop();
 
-    createBricks();
-    resetBallOnPaddle();
-}
+    // Saving and reporting below do not send heartbeats.
+    flightRecorder.stop();
 
-void Game::advanceLevel()
-{
-    ++level;
+    if (!savePath.empty())
+        saveGame();
 
-    // Increase ball speed, but never exceed the maximum.
-    ballSpeed = std::min(ballSpeed + Constants::BALL_SPEED_STEP, Constants::BALL_MAX_SPEED);
+    if (!recordPath.empty())
+        recording.finish(sim);
 
-    // Re-centre the paddle for the new level.
-    paddle.setPositionX(
-        (static_cast<float>(Constants::WINDOW_WIDTH) - Constants::PADDLE_WIDTH) * 0.5f);
+    if (!recordPath.empty() && recording.save(recordPath))
+    {
+        std::cout << "[Breakout] Saved " << recording.getTickCount() << " ticks to replay \""
+                  << recordPath << "\".\n";
+    }
 
-    createBricks();
-    resetBallOnPaddle();
+    latencyProbe.writeReport(std::cout);
+    AllocTracker::writeReport(std::cout);
+    perfCounters.writeReport(std::cout);
 }
 
 // =============================================================================
@@ -224,53 +288,68 @@ void Game::processEvents()
 
         if (event.type == sf::Event::KeyPressed)
         {
+            // Timestamp gameplay keys for the latency test mode.
+            switch (event.key.code)
+            {
+            case sf::Keyboard::Left:
+            case sf::Keyboard::Right:
+            case sf::Keyboard::A:
+            case sf::Keyboard::D:
+            case sf::Keyboard::Space:
+            case sf::Keyboard::P:
+                latencyProbe.onInput();
+                break;
+
+            default:
+                break;
+            }
+
+            // During playback the arrow keys and Home scrub through the
+            // replay instead of reaching the (ignored) gameplay input.
+            if (replaying && !showingControls)
+            {
+                std::uint32_t position = player.getPosition();
+                if (event.key.code == sf::Keyboard::Left)
+                    player.seek(sim, position - std::min(position, REPLAY_SEEK_TICKS));
+                else if (event.key.code == sf::Keyboard::Right)
+                    player.seek(sim, position + REPLAY_SEEK_TICKS);
+                else if (event.key.code == sf::Keyboard::Home)
+                    player.seek(sim, playback.getStartTick());
+            }
+
             switch (event.key.code)
             {
             case sf::Keyboard::Escape:
                 // From the Controls screen, Esc returns to the previous state
                 // rather than quitting so the player doesn't lose their game.
-                if (state == GameState::Controls)
-                    state = previousState;
+                if (showingControls)
+                    showingControls = false;
                 else
                     window.close();
                 break;
 
             case sf::Keyboard::Space:
-                if (state == GameState::MainMenu)
-                {
-                    restartGame();
-                }
-                else if (state == GameState::BallOnPaddle)
-                {
-                    ball.launch(ballSpeed);
-                    state = GameState::Playing;
-                }
-                else if (state == GameState::GameOver ||
-                         state == GameState::Victory)
-                {
-                    restartGame();
-                }
+                // Start, launch, or restart – the simulation decides which.
+                if (!showingControls)
+                    pendingCommands |= Input::Launch;
                 break;
 
             case sf::Keyboard::P:
-                if (state == GameState::Playing)
-                    state = GameState::Paused;
-                else if (state == GameState::Paused)
-                    state = GameState::Playing;
+                if (!showingControls)
+                    pendingCommands |= Input::Pause;
                 break;
 
             case sf::Keyboard::H:
-                // Open the Controls screen from the main menu or while paused.
-                // Store the current state so we can return to the right place.
-                if (state == GameState::MainMenu || state == GameState::Paused)
+                // Open the Controls screen from the main menu or while paused;
+                // H also closes it again.
+                if (showingControls)
                 {
-                    previousState = state;
-                    state         = GameState::Controls;
+                    showingControls = false;
                 }
-                else if (state == GameState::Controls)
+                else if (sim.getState() == GameState::MainMenu ||
+                         sim.getState() == GameState::Paused)
                 {
-                    // H also closes the Controls screen.
-                    state = previousState;
+                    showingControls = true;
                 }
                 break;
 
@@ -281,650 +360,350 @@ void Game::processEvents()
     }
 }
 
-void Game::update(float deltaTime)
+int Game::advanceSimulation(float deltaTime)
 {
-    // Always move the paddle regardless of ball state so the player can
-    // position it before launching.
-    paddle.update(deltaTime, static_cast<float>(Constants::WINDOW_WIDTH));
-
-    // While the ball is on the paddle, keep it anchored to the paddle centre
-    // so it tracks along as the player moves.
-    if (state == GameState::BallOnPaddle)
-    {
-        float ballX = paddle.getCentreX();
-        float ballY = paddle.getTopY() - Constants::BALL_RADIUS - 1.0f;
-        ball.reset(ballX, ballY);
-        return;
-    }
+    // Cap the backlog so that dragging the window, pausing in a debugger, or
+    // coming back from system sleep drops time instead of fast-forwarding.
+    static constexpr float MAX_BACKLOG =
+        static_cast<float>(Constants::MAX_TICKS_PER_FRAME) * Constants::TICK_SECONDS;
+    tickAccumulator = std::min(tickAccumulator + deltaTime, MAX_BACKLOG);
 
-    // From here on the ball is in motion.
-    ball.update(deltaTime);
+    applyLevelReloads();
 
-    handleWallCollisions();
-    handlePaddleCollision();
-    handleBrickCollisions();
+    // The controls screen freezes the game underneath it.
+    InputMask held = showingControls ? InputMask(0) : sampleHeldInput();
+    bool      rewinding = isRewindHeld();
 
-    // Check for level-complete or overall victory.
-    if (bricksRemaining <= 0)
+    int           ticks       = 0;
+    std::uint32_t ghostRewind = 0;
+    while (tickAccumulator >= Constants::TICK_SECONDS)
     {
-        if (level >= Constants::MAX_LEVELS)
+        if (rewinding)
         {
-            state = GameState::Victory;
+            // Run backwards one tick at a time; stop at the oldest snapshot.
+            if (rewind.pop(tickSnapshot))
+            {
+                // The ghost moved on every undone tick that did not end
+                // paused.  Reloads clear the buffer, so every snapshot in it
+                // fits; one that does not ends the rewind like the oldest.
+                const bool paused = sim.getState() == GameState::Paused;
+                if (sim.restore(tickSnapshot))
+                {
+                    if (!paused)
+                        ++ghostRewind;
+                    if (!recordPath.empty())
+                        recording.truncate(sim.getTick());
+                    flightRecorder.truncate(sim.getTick());
+                }
+                else
+                {
+                    rewind.clear();
+                }
+            }
+            pendingCommands = 0;
+
+            tickAccumulator -= Constants::TICK_SECONDS;
+            ++ticks;
+            continue;
         }
-        else
+
+        // A finished replay leaves the game frozen on its last frame.
+        if (replaying && player.isFinished())
         {
-            state              = GameState::LevelComplete;
-            levelCompleteTimer = Constants::LEVEL_COMPLETE_DELAY;
+            tickAccumulator = 0.0f;
+            break;
         }
-    }
-}
 
-void Game::render()
-{
-    // Deep navy background.
-    window.clear(sf::Color(12, 12, 28));
+        // Report the first tick whose state differs from the recording.
+        if (replaying && !replayDesynced && !player.matchesRecording(sim))
+        {
+            player.reportDesync(sim, std::cerr);
+            replayDesynced = true;
+        }
 
-    // Draw all game objects even behind overlays so the background is visible.
-    for (const Brick& brick : bricks)
-        brick.draw(window);
+        InputMask input = replaying ? player.next() : InputMask(held | pendingCommands);
 
-    paddle.draw(window);
-    ball.draw(window);
+        if (!recordPath.empty())
+            recording.record(sim, input);
+        flightRecorder.record(sim, input);
 
-    // HUD is always shown except on the main menu and controls screen
-    // (neither has an active game to report on).
-    if (state != GameState::MainMenu && state != GameState::Controls)
-        drawHUD();
+        GameState previousState = sim.getState();
+        int       previousLives = sim.getLives();
 
-    // State-specific overlays and hints.
-    switch (state)
-    {
-    case GameState::MainMenu:
-    case GameState::Paused:
-    case GameState::LevelComplete:
-    case GameState::GameOver:
-    case GameState::Victory:
-        drawStateOverlay();
-        break;
-
-    case GameState::Controls:
-        drawControlsScreen();
-        break;
-
-    case GameState::BallOnPaddle:
-    {
-        // Small instruction hint at the very bottom of the screen.
-        sf::Text hint = makeText("Press SPACE to launch",
-                                 Constants::FONT_SIZE_SMALL,
-                                 sf::Color(180, 180, 180));
-        centreTextHorizontally(hint,
-            static_cast<float>(Constants::WINDOW_HEIGHT) - 26.0f);
-        window.draw(hint);
-        break;
-    }
+        if (!replaying)
+        {
+            sim.snapshot(tickSnapshot);
+            rewind.push(tickSnapshot);
+        }
 
-    case GameState::Playing:
-        // Active gameplay: no overlay.
-        break;
-    }
+        sim.step(input);
+        pendingCommands = 0;
 
-    window.display();
-}
+        recordTickMetrics(previousState, previousLives);
+        advanceGhost(previousState);
 
-// =============================================================================
-// Collision helpers
-// =============================================================================
-
-void Game::handleWallCollisions()
-{
-    sf::Vector2f pos    = ball.getPosition();
-    float        radius = ball.getRadius();
-    float        winW   = static_cast<float>(Constants::WINDOW_WIDTH);
-    float        winH   = static_cast<float>(Constants::WINDOW_HEIGHT);
+        if (replaying && player.isFinished())
+        {
+            std::cout << "[Breakout] Replay finished after " << player.getPosition()
+                      << " ticks (score " << sim.getScore() << ", level "
+                      << sim.getLevel() << ").\n";
+        }
 
-    // Left wall – reflect rightward.
-    if (pos.x - radius < 0.0f)
-    {
-        ball.setVelocityX(std::abs(ball.getVelocity().x));
-        ball.setPosition(radius, pos.y);
+        tickAccumulator -= Constants::TICK_SECONDS;
+        ++ticks;
     }
 
-    // Right wall – reflect leftward.
-    if (pos.x + radius > winW)
-    {
-        ball.setVelocityX(-std::abs(ball.getVelocity().x));
-        ball.setPosition(winW - radius, pos.y);
-    }
+    // One keyframe seek per frame, however many ticks were rewound.
+    if (ghostRewind > 0)
+        rewindGhost(ghostRewind);
 
-    // Top wall – reflect downward.
-    if (pos.y - radius < 0.0f)
-    {
-        ball.setVelocityY(std::abs(ball.getVelocity().y));
-        ball.setPosition(pos.x, radius);
-    }
+    return ticks;
+}
 
-    // Bottom boundary – player has missed the ball.
-    if (pos.y - radius > winH)
+void Game::applyLevelReloads()
+{
+    int number;
+    while (levelWatcher.poll(number))
     {
-        --lives;
-        if (lives <= 0)
-        {
-            lives = 0;
-            state = GameState::GameOver;
-        }
-        else
-        {
-            resetBallOnPaddle();
-        }
+        if (number != sim.getLevel())
+            continue;
+
+        sim.reloadLevel();
+        rewind.clear();
+        std::cout << "[Breakout] Restarted level " << number << " with its new layout.\n";
     }
 }
 
-void Game::handlePaddleCollision()
+void Game::recordTickMetrics(GameState previousState, int previousLives)
 {
-    // Only process collisions while the ball is heading downward; this prevents
-    // the ball from being deflected a second time while it is still passing
-    // through the paddle shape after the first bounce.
-    if (ball.getVelocity().y <= 0.0f)
-        return;
+    telemetry.ticks.increment();
 
-    sf::FloatRect paddleBounds = paddle.getBounds();
-    sf::Vector2f  ballPos      = ball.getPosition();
-    float         radius       = ball.getRadius();
+    GameState state = sim.getState();
 
-    // Broad-phase AABB check: expand the paddle rectangle by the ball radius
-    // in every direction, then test whether the ball centre falls inside.
-    sf::FloatRect expandedBounds = {
-        paddleBounds.left   - radius,
-        paddleBounds.top    - radius,
-        paddleBounds.width  + 2.0f * radius,
-        paddleBounds.height + 2.0f * radius
-    };
+    if (sim.getLives() < previousLives)
+        telemetry.livesLost.increment();
 
-    if (!expandedBounds.contains(ballPos))
-        return;
+    // A new game starts when Launch leaves the menu or an end screen.
+    if (isIdle(previousState) && state == GameState::BallOnPaddle)
+    {
+        telemetry.gamesStarted.increment();
+        levelPlayTicks = 0;
+    }
 
-    // Nudge the ball just above the paddle surface to prevent it sinking in.
-    ball.setPosition(ballPos.x, paddleBounds.top - radius - 0.5f);
+    if (state == GameState::Playing)
+        ++levelPlayTicks;
 
-    // Map the horizontal hit position to a deflection angle.
-    // hitOffset is in [-1, 1]: -1 = far left edge, 0 = centre, +1 = far right.
-    float hitOffset = (ballPos.x - paddle.getCentreX()) /
-                      (paddle.getWidth() * 0.5f);
-    hitOffset = std::max(-1.0f, std::min(1.0f, hitOffset));
+    // The last brick of a level moves Playing to LevelComplete, or to
+    // Victory on the final level.
+    if (previousState == GameState::Playing &&
+        (state == GameState::LevelComplete || state == GameState::Victory))
+    {
+        telemetry.levelSeconds.observe(levelPlayTicks * static_cast<double>(Constants::TICK_SECONDS));
+        levelPlayTicks = 0;
+    }
 
-    // Angles range from -75° (far left) to +75° (far right) relative to
-    // straight upward, giving the player meaningful directional control.
-    static constexpr float MAX_ANGLE_RAD = 75.0f * (3.14159265f / 180.0f);
-    float angle = hitOffset * MAX_ANGLE_RAD;
+    if (previousState != GameState::GameOver && state == GameState::GameOver)
+        telemetry.gamesOver.increment();
+}
 
-    float speed = ball.getSpeed();
-    ball.setVelocityX( speed * std::sin(angle));  // Positive = rightward.
-    ball.setVelocityY(-speed * std::cos(angle));  // Negative = upward in SFML.
+void Game::recordFrameMetrics(float deltaTime)
+{
+    telemetry.frameSeconds.observe(deltaTime);
+    telemetry.frames.increment();
+    telemetry.heapAllocations.increment(AllocTracker::lastFrame().allocations);
 
-    // Re-normalise to compensate for any floating-point error in sin/cos.
-    ball.normaliseSpeed(ballSpeed);
+    telemetry.score.set(sim.getScore());
+    telemetry.level.set(sim.getLevel());
+    telemetry.lives.set(sim.getLives());
 }
 
-void Game::handleBrickCollisions()
+InputMask Game::sampleHeldInput() const
 {
-    sf::Vector2f ballCenter = ball.getPosition();
-    float        radius     = ball.getRadius();
-
-    // Reflect the ball at most once per frame to avoid erratic behaviour when
-    // the ball grazes the corner shared by two adjacent bricks.
-    bool collisionResolvedThisFrame = false;
+    InputMask input = 0;
 
-    for (Brick& brick : bricks)
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left) ||
+        sf::Keyboard::isKeyPressed(sf::Keyboard::A))
     {
-        if (brick.isDestroyed())
-            continue;
-
-        sf::FloatRect rect = brick.getBounds();
-
-        // Nearest-point circle–AABB test:
-        // find the closest point on the brick rectangle to the ball centre.
-        float closestX = std::max(rect.left, std::min(ballCenter.x, rect.left + rect.width));
-        float closestY = std::max(rect.top,  std::min(ballCenter.y, rect.top  + rect.height));
-
-        float dx     = ballCenter.x - closestX;
-        float dy     = ballCenter.y - closestY;
-        float distSq = dx * dx + dy * dy;
-
-        // No intersection if the nearest point is farther than the radius.
-        if (distSq >= radius * radius)
-            continue;
-
-        // -----------------------------------------------------------------
-        // Collision confirmed – damage the brick.
-        // -----------------------------------------------------------------
-        brick.hit();
-
-        if (brick.isDestroyed())
-        {
-            score += brick.getPoints();
-            --bricksRemaining;
-        }
-
-        // -----------------------------------------------------------------
-        // Resolve the ball reflection (first hit only this frame).
-        // -----------------------------------------------------------------
-        if (!collisionResolvedThisFrame)
-        {
-            // Compute the collision normal from nearest-point to ball centre.
-            float dist = std::sqrt(distSq);
+        input |= Input::Left;
+    }
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right) ||
+        sf::Keyboard::isKeyPressed(sf::Keyboard::D))
+    {
+        input |= Input::Right;
+    }
+    return input;
+}
 
-            sf::Vector2f normal;
-            if (dist > 0.0001f)
-            {
-                normal = { dx / dist, dy / dist };
-            }
-            else
-            {
-                // The ball centre is exactly inside the rectangle – use
-                // a safe default upward normal.
-                normal = { 0.0f, -1.0f };
-            }
+bool Game::isRewindHeld() const
+{
+    return !replaying && !showingControls &&
+           sf::Keyboard::isKeyPressed(sf::Keyboard::R);
+}
 
-            reflectBall(normal);
+GameState Game::currentScreen() const
+{
+    return showingControls ? GameState::Controls : sim.getState();
+}
 
-            // Push the ball clear of the brick surface along the normal.
-            float penetrationDepth = radius - dist;
-            ball.setPosition(
-                ballCenter.x + normal.x * (penetrationDepth + 0.5f),
-                ballCenter.y + normal.y * (penetrationDepth + 0.5f));
+void Game::render()
+{
+    // The ghost is hidden once its own game (or its recording) has ended.
+    const bool drawGhost = ghostRunning && !isIdle(ghost.getState());
+    renderer.render(window, sim, currentScreen(), drawGhost ? &ghost : nullptr);
 
-            // Normalise speed to counteract accumulated floating-point drift.
-            ball.normaliseSpeed(ballSpeed);
+    if (latencyProbe.shouldDrawMarker())
+        drawLatencyMarker();
 
-            collisionResolvedThisFrame = true;
-        }
-    }
+    latencyProbe.onRenderSubmitted();
+    window.display();
+    latencyProbe.onBufferSwapped();
 }
 
-void Game::reflectBall(sf::Vector2f normal)
+void Game::drawLatencyMarker()
 {
-    // Standard specular reflection: r = v − 2(v·n)n
-    sf::Vector2f vel = ball.getVelocity();
-    float dot        = vel.x * normal.x + vel.y * normal.y;
+    // Large enough to cover a photodiode taped to the screen corner.
+    static constexpr float MARKER_SIZE = 48.0f;
 
-    ball.setVelocityX(vel.x - 2.0f * dot * normal.x);
-    ball.setVelocityY(vel.y - 2.0f * dot * normal.y);
+    sf::RectangleShape marker(sf::Vector2f(MARKER_SIZE, MARKER_SIZE));
+    marker.setFillColor(sf::Color::White);
+    marker.setPosition(0.0f, 0.0f);
+    window.draw(marker);
 }
 
 // =============================================================================
-// Render helpers
+// Ghost
 // =============================================================================
 
-void Game::drawHUD()
+void Game::loadGhost(const std::string& path)
 {
-    std::ostringstream oss;
-
-    // ---- Score (left-aligned) ----
-    oss << "Score: " << score;
-    sf::Text scoreText = makeText(oss.str(), Constants::FONT_SIZE_MEDIUM, sf::Color::White);
-    scoreText.setPosition(10.0f, 4.0f);
-    window.draw(scoreText);
-
-    // ---- Level (centred) ----
-    oss.str("");
-    oss << "Level: " << level;
-    sf::Text levelText = makeText(oss.str(), Constants::FONT_SIZE_MEDIUM, sf::Color::White);
-    centreTextHorizontally(levelText, 4.0f);
-    window.draw(levelText);
-
-    // ---- Life indicators – small circles at the bottom-right ----
-    float indicatorDiameter = Constants::LIFE_INDICATOR_RADIUS * 2.0f;
-    float totalIndicatorWidth =
-        static_cast<float>(Constants::INITIAL_LIVES) * indicatorDiameter +
-        static_cast<float>(Constants::INITIAL_LIVES - 1) * Constants::LIFE_INDICATOR_GAP;
-
-    float indicatorStartX =
-        static_cast<float>(Constants::WINDOW_WIDTH) - totalIndicatorWidth - 10.0f;
-    float indicatorY =
-        static_cast<float>(Constants::WINDOW_HEIGHT) - indicatorDiameter - 6.0f;
-
-    for (int i = 0; i < Constants::INITIAL_LIVES; ++i)
-    {
-        sf::CircleShape lifeCircle(Constants::LIFE_INDICATOR_RADIUS);
-        lifeCircle.setOrigin(Constants::LIFE_INDICATOR_RADIUS,
-                             Constants::LIFE_INDICATOR_RADIUS);
-
-        // Fill only the circles representing lives the player still has.
-        if (i < lives)
-        {
-            lifeCircle.setFillColor(sf::Color::White);
-            lifeCircle.setOutlineColor(sf::Color(180, 180, 180));
-        }
-        else
-        {
-            lifeCircle.setFillColor(sf::Color::Transparent);
-            lifeCircle.setOutlineColor(sf::Color(90, 90, 90));
-        }
-        lifeCircle.setOutlineThickness(1.5f);
+    // Load failures are reported by Replay::load(); the game runs without a ghost.
+    if (!Replay::load(path, levels->getSource(), ghostReplay))
+        return;
 
-        float x = indicatorStartX +
-                  static_cast<float>(i) *
-                  (indicatorDiameter + Constants::LIFE_INDICATOR_GAP) +
-                  Constants::LIFE_INDICATOR_RADIUS;
+    // Play the recording's menu ticks once to find where its game begins.
+    ghost = Simulation(ghostReplay.getSeed(), levels);
+    ghostPlayer.seek(ghost, ghostReplay.getStartTick());
+    while (!ghostPlayer.isFinished() && ghost.getState() == GameState::MainMenu)
+        ghost.step(ghostPlayer.next());
 
-        lifeCircle.setPosition(x, indicatorY + Constants::LIFE_INDICATOR_RADIUS);
-        window.draw(lifeCircle);
+    if (ghost.getState() == GameState::MainMenu)
+    {
+        std::cerr << "[Breakout] WARNING: Ghost replay \"" << path
+                  << "\" never starts a game; ignoring it.\n";
+        return;
     }
+    ghostStartTick = ghost.getTick();
+    hasGhost       = true;
 }
 
-void Game::drawStateOverlay()
+void Game::advanceGhost(GameState previousState)
 {
-    // Semi-transparent dark backdrop so game objects are still faintly visible.
-    sf::RectangleShape backdrop(
-        sf::Vector2f(static_cast<float>(Constants::WINDOW_WIDTH),
-                     static_cast<float>(Constants::WINDOW_HEIGHT)));
-    backdrop.setFillColor(sf::Color(0, 0, 0, 170));
-    window.draw(backdrop);
+    if (!hasGhost)
+        return;
 
-    float midY = static_cast<float>(Constants::WINDOW_HEIGHT) * 0.5f;
+    const GameState state = sim.getState();
 
-    switch (state)
+    // Every new game races the recording from the start of its game.
+    if (isIdle(previousState) && state == GameState::BallOnPaddle)
     {
-    // ---- Main Menu ----
-    case GameState::MainMenu:
-    {
-        sf::Text title = makeText("BREAKOUT", Constants::FONT_SIZE_LARGE, sf::Color::Yellow);
-        centreTextHorizontally(title, midY - 90.0f);
-        window.draw(title);
-
-        sf::Text startPrompt = makeText("Press SPACE to start",
-                                        Constants::FONT_SIZE_MEDIUM,
-                                        sf::Color::White);
-        centreTextHorizontally(startPrompt, midY - 15.0f);
-        window.draw(startPrompt);
-
-        sf::Text controlsHint = makeText("Press H for controls",
-                                          Constants::FONT_SIZE_MEDIUM,
-                                          sf::Color(100, 220, 255));
-        centreTextHorizontally(controlsHint, midY + 25.0f);
-        window.draw(controlsHint);
-
-        sf::Text quitHint = makeText("ESC to quit",
-                                      Constants::FONT_SIZE_SMALL,
-                                      sf::Color(130, 130, 130));
-        centreTextHorizontally(quitHint, midY + 68.0f);
-        window.draw(quitHint);
-        break;
+        ghostPlayer.seek(ghost, ghostStartTick);
+        ghostRunning = true;
+        return;
     }
 
-    // ---- Paused ----
-    case GameState::Paused:
+    if (!ghostRunning)
+        return;
+
+    if (isIdle(state) || ghostPlayer.isFinished())
     {
-        sf::Text pauseLabel = makeText("PAUSED", Constants::FONT_SIZE_LARGE, sf::Color::Cyan);
-        centreTextHorizontally(pauseLabel, midY - 50.0f);
-        window.draw(pauseLabel);
-
-        sf::Text resumeHint = makeText("P — Resume",
-                                       Constants::FONT_SIZE_MEDIUM,
-                                       sf::Color::White);
-        centreTextHorizontally(resumeHint, midY + 10.0f);
-        window.draw(resumeHint);
-
-        sf::Text controlsHint = makeText("H — Controls",
-                                          Constants::FONT_SIZE_MEDIUM,
-                                          sf::Color(100, 220, 255));
-        centreTextHorizontally(controlsHint, midY + 42.0f);
-        window.draw(controlsHint);
-        break;
+        ghostRunning = false;
+        return;
     }
 
-    // ---- Level Complete ----
-    case GameState::LevelComplete:
+    // Pausing the game pauses the ghost with it.
+    if (state != GameState::Paused)
+        ghost.step(ghostPlayer.next());
+}
+
+void Game::rewindGhost(std::uint32_t ticks)
+{
+    if (!ghostRunning)
+        return;
+
+    // Rewinding past the launch leaves no game for the ghost to race.
+    if (isIdle(sim.getState()))
     {
-        std::string message = "Level " + std::to_string(level) + " Complete!";
-        sf::Text levelDone = makeText(message, Constants::FONT_SIZE_LARGE, sf::Color::Green);
-        centreTextHorizontally(levelDone, midY - 30.0f);
-        window.draw(levelDone);
-
-        sf::Text nextLevel = makeText("Get ready for level " + std::to_string(level + 1) + "...",
-                                      Constants::FONT_SIZE_MEDIUM,
-                                      sf::Color(180, 255, 180));
-        centreTextHorizontally(nextLevel, midY + 25.0f);
-        window.draw(nextLevel);
-        break;
+        ghostRunning = false;
+        return;
     }
 
-    // ---- Game Over ----
-    case GameState::GameOver:
+    const std::uint32_t position = ghostPlayer.getPosition();
+    ghostPlayer.seek(ghost, position - std::min(ticks, position - ghostStartTick));
+}
+
+// =============================================================================
+// Save-states
+// =============================================================================
+
+void Game::resumeSavedGame()
+{
+    // A save this game cannot resume may belong to a game on other levels;
+    // it is left alone, neither replaced nor removed on exit.
+    std::error_code ignored;
+    if (!std::filesystem::exists(savePath, ignored))
     {
-        sf::Text gameOverLabel = makeText("GAME OVER",
-                                          Constants::FONT_SIZE_LARGE,
-                                          sf::Color(255, 60, 60));
-        centreTextHorizontally(gameOverLabel, midY - 65.0f);
-        window.draw(gameOverLabel);
-
-        std::ostringstream oss;
-        oss << "Final Score: " << score;
-        sf::Text finalScore = makeText(oss.str(),
-                                       Constants::FONT_SIZE_MEDIUM,
-                                       sf::Color::White);
-        centreTextHorizontally(finalScore, midY - 5.0f);
-        window.draw(finalScore);
-
-        sf::Text restartHint = makeText("Press SPACE to restart",
-                                        Constants::FONT_SIZE_MEDIUM,
-                                        sf::Color(200, 200, 200));
-        centreTextHorizontally(restartHint, midY + 40.0f);
-        window.draw(restartHint);
-        break;
+        ownsSave = true;
+        return;
     }
 
-    // ---- Victory ----
-    case GameState::Victory:
+    GameSnapshot snapshot;
+    if (!SaveState::load(savePath, levels->getSource(), snapshot))
     {
-        sf::Text victoryLabel = makeText("YOU WIN!",
-                                         Constants::FONT_SIZE_LARGE,
-                                         sf::Color::Yellow);
-        centreTextHorizontally(victoryLabel, midY - 65.0f);
-        window.draw(victoryLabel);
-
-        std::ostringstream oss;
-        oss << "Final Score: " << score;
-        sf::Text finalScore = makeText(oss.str(),
-                                       Constants::FONT_SIZE_MEDIUM,
-                                       sf::Color::White);
-        centreTextHorizontally(finalScore, midY - 5.0f);
-        window.draw(finalScore);
-
-        sf::Text playAgainHint = makeText("Press SPACE to play again",
-                                          Constants::FONT_SIZE_MEDIUM,
-                                          sf::Color(200, 200, 200));
-        centreTextHorizontally(playAgainHint, midY + 40.0f);
-        window.draw(playAgainHint);
-        break;
+        std::cerr << "[Breakout] WARNING: Starting a new game instead, which will not be saved\n"
+                     "           over the existing save.\n";
+        return;
     }
 
-    default:
-        break;
+    if (!sim.restore(snapshot))
+    {
+        std::cerr << "[Breakout] WARNING: Save file \"" << savePath << "\" does not fit the "
+                     "levels being played;\n"
+                     "           starting a new game instead, which will not be saved over it.\n";
+        return;
     }
+    ownsSave = true;
+    std::cout << "[Breakout] Resumed saved game (level " << sim.getLevel()
+              << ", score " << sim.getScore() << ").\n";
 }
 
-void Game::centreTextHorizontally(sf::Text& text, float y)
+void Game::saveGame()
 {
-    sf::FloatRect bounds = text.getGlobalBounds();
-    float x = (static_cast<float>(Constants::WINDOW_WIDTH) - bounds.width) * 0.5f;
-    text.setPosition(std::max(0.0f, x), y);
-}
+    if (!ownsSave)
+    {
+        std::cerr << "[Breakout] WARNING: Not saving over \"" << savePath
+                  << "\", which this game could not resume.\n";
+        return;
+    }
 
-sf::Text Game::makeText(const std::string& content,
-                         unsigned int characterSize,
-                         sf::Color color) const
-{
-    sf::Text text;
-    text.setFont(font);
-    text.setString(content);
-    text.setCharacterSize(characterSize);
-    text.setFillColor(color);
-    return text;
-}
+    GameSnapshot snapshot = sim.snapshot();
 
-void Game::drawControlsScreen()
-{
-    // -------------------------------------------------------------------------
-    // Full-screen dark backdrop.
-    // -------------------------------------------------------------------------
-    sf::RectangleShape backdrop(
-        sf::Vector2f(static_cast<float>(Constants::WINDOW_WIDTH),
-                     static_cast<float>(Constants::WINDOW_HEIGHT)));
-    backdrop.setFillColor(sf::Color(0, 0, 0, 210));
-    window.draw(backdrop);
-
-    // Fixed column X positions for the two-column key / description layout.
-    const float keyColumnX  = 170.0f;   ///< Right-edge of the key-label column.
-    const float descColumnX = 210.0f;   ///< Left-edge of the description column.
-
-    // -------------------------------------------------------------------------
-    // Helper lambda: draw a key label (right-aligned to keyColumnX) and its
-    // description (left-aligned at descColumnX) on the same row.
-    // -------------------------------------------------------------------------
-    auto drawRow = [&](const std::string& keyLabel,
-                       const std::string& description,
-                       float y,
-                       sf::Color keyColor   = sf::Color(255, 220, 80),
-                       sf::Color descColor  = sf::Color(220, 220, 220))
-    {
-        sf::Text keyText = makeText(keyLabel, Constants::FONT_SIZE_SMALL, keyColor);
-        // Right-align the key label so all keys end at the same X.
-        float keyWidth = keyText.getGlobalBounds().width;
-        keyText.setPosition(keyColumnX - keyWidth, y);
-        window.draw(keyText);
-
-        sf::Text descText = makeText(description, Constants::FONT_SIZE_SMALL, descColor);
-        descText.setPosition(descColumnX, y);
-        window.draw(descText);
-    };
-
-    // -------------------------------------------------------------------------
-    // Helper lambda: draw a thin horizontal separator rule.
-    // -------------------------------------------------------------------------
-    auto drawRule = [&](float y)
-    {
-        sf::RectangleShape rule(sf::Vector2f(
-            static_cast<float>(Constants::WINDOW_WIDTH) - 120.0f, 1.0f));
-        rule.setFillColor(sf::Color(80, 80, 80));
-        rule.setPosition(60.0f, y);
-        window.draw(rule);
-    };
-
-    // -------------------------------------------------------------------------
-    // Helper lambda: draw a section header, left-aligned at keyColumnX.
-    // -------------------------------------------------------------------------
-    auto drawSectionHeader = [&](const std::string& title, float y)
-    {
-        sf::Text header = makeText(title, Constants::FONT_SIZE_SMALL,
-                                   sf::Color(140, 200, 255));
-        header.setPosition(keyColumnX - header.getGlobalBounds().width, y);
-        window.draw(header);
-    };
-
-    // =========================================================================
-    // Title
-    // =========================================================================
-    sf::Text titleText = makeText("CONTROLS", Constants::FONT_SIZE_LARGE, sf::Color::White);
-    centreTextHorizontally(titleText, 18.0f);
-    window.draw(titleText);
-
-    drawRule(72.0f);
-
-    // =========================================================================
-    // Section: Movement
-    // =========================================================================
-    float y = 84.0f;
-    drawSectionHeader("MOVEMENT", y);
-    y += 26.0f;
-    drawRow("\u2190 / A", "Move paddle left",  y);
-    y += 24.0f;
-    drawRow("\u2192 / D", "Move paddle right", y);
-
-    y += 34.0f;
-    drawRule(y);
-
-    // =========================================================================
-    // Section: Game controls
-    // =========================================================================
-    y += 12.0f;
-    drawSectionHeader("GAME", y);
-    y += 26.0f;
-    drawRow("Space", "Launch ball  /  Start  /  Restart", y);
-    y += 24.0f;
-    drawRow("P",     "Pause / Resume",                    y);
-    y += 24.0f;
-    drawRow("H",     "Show / hide this screen",           y);
-    y += 24.0f;
-    drawRow("Esc",   "Close controls  /  Quit",           y);
-
-    y += 34.0f;
-    drawRule(y);
-
-    // =========================================================================
-    // Section: Scoring
-    // =========================================================================
-    y += 12.0f;
-    drawSectionHeader("SCORING", y);
-    y += 26.0f;
-
-    // One entry per brick row; colours match ROW_COLORS in the game.
-    struct ScoringEntry { sf::Color color; std::string label; int points; };
-    static const ScoringEntry scoringTable[] = {
-        { sf::Color(220,  45,  45), "Red    row", 60 },
-        { sf::Color(230, 120,  20), "Orange row", 50 },
-        { sf::Color(210, 200,  20), "Yellow row", 40 },
-        { sf::Color( 45, 185,  45), "Green  row", 30 },
-        { sf::Color( 45, 110, 225), "Blue   row", 20 },
-        { sf::Color(135,  45, 205), "Purple row", 10 },
-    };
-
-    const float dotRadius  = 5.0f;
-    const float rowSpacing = 22.0f;
-
-    for (const ScoringEntry& entry : scoringTable)
+    switch (snapshot.state)
     {
-        // Coloured dot matching the brick colour.
-        sf::CircleShape dot(dotRadius);
-        dot.setOrigin(dotRadius, dotRadius);
-        dot.setFillColor(entry.color);
-        dot.setPosition(keyColumnX - dotRadius * 2.0f - 2.0f,
-                        y + dotRadius + 1.0f);
-        window.draw(dot);
-
-        // Points value in key column colour.
-        std::string pointsStr = std::to_string(entry.points) + " pts";
-        sf::Text pointsText = makeText(pointsStr, Constants::FONT_SIZE_SMALL,
-                                       sf::Color(255, 220, 80));
-        float pw = pointsText.getGlobalBounds().width;
-        pointsText.setPosition(keyColumnX - dotRadius * 2.0f - 2.0f - pw - 6.0f, y);
-        window.draw(pointsText);
-
-        // Row label.
-        sf::Text labelText = makeText(entry.label, Constants::FONT_SIZE_SMALL,
-                                      sf::Color(220, 220, 220));
-        labelText.setPosition(descColumnX, y);
-        window.draw(labelText);
-
-        y += rowSpacing;
+        case GameState::MainMenu:
+        case GameState::GameOver:
+        case GameState::Victory:
+            // Nothing to resume; don't bring back a finished game next time.
+            std::remove(savePath.c_str());
+            return;
+
+        case GameState::Playing:
+            snapshot.state = GameState::Paused;
+            break;
+
+        default:
+            break;
     }
 
-    // Footnote explaining multi-hit bricks on higher levels.
-    y += 4.0f;
-    sf::Text footnote = makeText(
-        "Higher levels add hit points per brick; score = base x hit points.",
-        Constants::FONT_SIZE_SMALL - 2,
-        sf::Color(120, 120, 120));
-    centreTextHorizontally(footnote, y);
-    window.draw(footnote);
-
-    // =========================================================================
-    // Return hint at the bottom.
-    // =========================================================================
-    sf::Text returnHint = makeText("H or Esc  \u2014  Return",
-                                    Constants::FONT_SIZE_SMALL,
-                                    sf::Color(100, 220, 255));
-    centreTextHorizontally(returnHint,
-        static_cast<float>(Constants::WINDOW_HEIGHT) - 30.0f);
-    window.draw(returnHint);
+    if (SaveState::save(savePath, snapshot, levels->getSource()))
+        std::cout << "[Breakout] Saved game to \"" << savePath << "\".\n";
 }
@@ -2,38 +2,43 @@
  * @file Game.hpp
  * @brief Declaration of the Game class — the central game controller.
  *
- * Game owns every subsystem: the SFML window, game objects (Ball, Paddle,
- * Bricks), HUD text, and the game-state machine.  The public interface is a
- * single method, run(), which drives the main loop until the window is closed.
+ * Game owns every interactive subsystem: the SFML window, the Simulation
+ * that holds the game model, the Renderer that draws it, and the optional
+ * diagnostic probes.  The public interface is a single method, run(), which
+ * drives the main loop until the window is closed.
  *
  * Internal design
  * ---------------
- * The main loop (run()) delegates each frame to three private methods:
- *   1. processEvents()  – drains the SFML event queue; handles keyboard input
- *                         that drives state transitions.
- *   2. update()         – advances physics, paddle movement, and collision
- *                         detection; evaluates win/loss conditions.
- *   3. render()         – clears the back buffer and draws all visible objects,
- *                         then presents the finished frame.
- *
- * Collision detection
- * -------------------
- * Ball vs. walls, paddle, and bricks are resolved in separate helper methods.
- * Brick collisions use the circle–AABB nearest-point algorithm to produce a
- * physically plausible reflection normal.  Only the first brick collision is
- * resolved per frame to avoid double-reflections at brick corners.
+ * The main loop (run()) performs three steps each frame:
+ *   1. processEvents()      – drains the SFML event queue; turns key presses
+ *                             into simulation inputs or UI actions.
+ *   2. advanceSimulation()  – steps the Simulation in fixed ticks of
+ *                             Constants::TICK_SECONDS to catch up with real
+ *                             time (see Simulation for physics and collisions).
+ *   3. render()             – draws the Simulation via Renderer, then
+ *                             presents the finished frame.
  */
 
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <memory>
 #include <string>
-#include <vector>
 
+#include "FlightRecorder.hpp"
+#include "GameOptions.hpp"
 #include "GameState.hpp"
-#include "Ball.hpp"
-#include "Paddle.hpp"
-#include "Brick.hpp"
+#include "Input.hpp"
+#include "LatencyProbe.hpp"
+#include "Level.hpp"
+#include "LevelWatcher.hpp"
+#include "Metrics.hpp"
+#include "MetricsServer.hpp"
+#include "PerfCounters.hpp"
+#include "Renderer.hpp"
+#include "Replay.hpp"
+#include "RewindBuffer.hpp"
+#include "Simulation.hpp"
 
 /**
  * @brief Top-level game controller for the Breakout clone.
@@ -51,208 +56,200 @@ public:
      *
      * Actions performed during construction:
      *   - Opens the sf::RenderWindow at the size defined in Constants.
-     *   - Seeds the random-number generator.
+     *   - Creates the Simulation, seeded from --seed, the replay being played
+     *     back, or the current time.
      *   - Loads the font from @p fontPath; terminates the window on failure.
-     *   - Creates the initial brick grid.
-     *   - Positions the ball on the paddle (BallOnPaddle state).
      *
      * @param fontPath  Filesystem path to the TTF/OTF font file used for
      *                  all HUD and overlay text.
+     * @param options   Optional runtime modes selected on the command line.
      */
-    explicit Game(const std::string& fontPath);
+    Game(const std::string& fontPath, const GameOptions& options);
 
     /**
      * @brief Runs the main game loop until the window is closed.
      *
      * Each iteration:
-     *   1. Measures the frame delta time (capped at 50 ms to prevent
-     *      physics explosions after focus loss or debugger pauses).
-     *   2. Calls processEvents(), then update(), then render().
+     *   1. Measures the frame delta time.
+     *   2. Calls processEvents(), then advanceSimulation(), then render().
+     *
+     * Each step runs inside an AllocTracker::Zone and a PerfCounters::Scope
+     * so heap allocations and hardware counters can be attributed to it.
+     * Frame and tick metrics are published to the metrics registry.
+     * Latency, allocation and counter reports (when enabled) are printed
+     * when the loop ends.
      */
     void run();
 
 private:
     // =========================================================================
-    // Initialisation helpers
+    // Main loop steps
     // =========================================================================
 
     /**
-     * @brief Populates the brick grid for the current level.
+     * @brief Drains the SFML event queue and handles relevant events.
+     *
+     * Handles:
+     *   - sf::Event::Closed  → closes the window.
+     *   - Escape             → closes the controls screen, or the window.
+     *   - Space              → queues a Launch input (start, launch, restart).
+     *   - P                  → queues a Pause input.
+     *   - H                  → opens / closes the controls screen.
+     *   - R (held)           → rewinds; sampled per frame by advanceSimulation().
+     *   - ← / → / Home       → during replay playback, seeks back / forward
+     *                          five seconds or to the start.
      *
-     * Bricks are arranged in BRICK_ROWS × BRICK_COLS, centred horizontally.
-     * Rows closer to the top of the screen are worth more points.  On levels
-     * beyond the first, extra hit points are added to every brick row.
+     * Launch and Pause are delivered to the next simulation tick; the
+     * controls screen is presentation-only and never reaches the simulation.
      */
-    void createBricks();
+    void processEvents();
 
     /**
-     * @brief Places the ball on the paddle and enters BallOnPaddle state.
+     * @brief Runs as many fixed simulation ticks as real time demands.
+     *
+     * Adds @p deltaTime to the tick accumulator (capped at
+     * MAX_TICKS_PER_FRAME ticks' worth) and steps the simulation once per
+     * whole TICK_SECONDS.  Queued Launch / Pause inputs go to the first tick.
+     * During replay playback the recorded inputs are used instead, the
+     * state is checked against each recorded state hash (the first
+     * mismatch is reported), and the simulation stops when the replay ends.
+     * Every input stepped is appended to the recording when --record is
+     * active.
+     *
+     * Each tick pushes a snapshot into the rewind buffer before stepping.
+     * While R is held, ticks instead pop and restore one snapshot each, so the
+     * game runs backwards in real time; an active recording and the flight
+     * recorder are truncated to match, and play resumes from the restored
+     * tick on release.
+     *
+     * With --ghost, the ghost simulation is stepped once per tick alongside
+     * sim (see advanceGhost()) and follows it back when rewinding.
      *
-     * The ball centre is set just above the paddle's top edge so it appears
-     * to rest on the paddle surface until the player presses Space.
+     * @param deltaTime  Real time elapsed since the previous frame, in seconds.
+     * @return int  Number of ticks simulated this frame.
      */
-    void resetBallOnPaddle();
+    int advanceSimulation(float deltaTime);
 
     /**
-     * @brief Resets all game state and starts from level 1.
+     * @brief Applies level files reloaded by levelWatcher since the last
+     *        frame.
      *
-     * Resets score, lives, level, and ball speed; re-centres the paddle;
-     * rebuilds the brick grid; and calls resetBallOnPaddle().
+     * Called between ticks.  If the current level was reloaded its bricks
+     * restart from the new layout; the rewind buffer is emptied, since its
+     * snapshots describe the old one.
      */
-    void restartGame();
+    void applyLevelReloads();
 
     /**
-     * @brief Advances to the next level after the current one is cleared.
+     * @brief Updates per-tick metrics after one simulation step.
      *
-     * Increments the level counter, increases ball speed (capped at
-     * BALL_MAX_SPEED), rebuilds the brick grid, and resets the ball on paddle.
+     * Detects lives lost, games started and lost, and level completions by
+     * comparing the simulation with its state before the step.
+     *
+     * @param previousState  Simulation state before the step.
+     * @param previousLives  Lives remaining before the step.
      */
-    void advanceLevel();
-
-    // =========================================================================
-    // Main loop steps
-    // =========================================================================
+    void recordTickMetrics(GameState previousState, int previousLives);
 
     /**
-     * @brief Drains the SFML event queue and handles relevant events.
-     *
-     * Handles:
-     *   - sf::Event::Closed  → closes the window.
-     *   - Escape             → closes the window.
-     *   - Space              → starts, launches, or restarts depending on state.
-     *   - P                  → toggles pause while Playing or Paused.
+     * @brief Updates per-frame metrics at the end of a frame.
+     * @param deltaTime  Duration of the frame just finished, in seconds.
      */
-    void processEvents();
+    void recordFrameMetrics(float deltaTime);
 
     /**
-     * @brief Advances game logic by @p deltaTime seconds.
+     * @brief Samples the held movement keys into Input::Left / Input::Right.
      *
-     * - Moves the paddle according to live keyboard state.
-     * - In BallOnPaddle state: keeps the ball anchored to the paddle centre.
-     * - In Playing state: moves the ball, resolves all collisions, checks for
-     *   ball-lost and level-complete conditions.
+     * Accepts both the arrow keys and A/D so players can use either scheme.
      *
-     * @param deltaTime  Elapsed time since the previous frame, in seconds.
+     * @return InputMask  Movement bits for the current frame.
      */
-    void update(float deltaTime);
+    InputMask sampleHeldInput() const;
 
     /**
-     * @brief Clears the window and draws all visible game elements.
+     * @brief Returns true while the rewind key is held and rewinding is allowed.
      *
-     * Draw order: background colour → bricks → paddle → ball → HUD → overlay.
-     * The overlay is only drawn for non-playing states (menus, game-over, etc.).
+     * Rewinding is unavailable during replay playback (the replay defines
+     * the game) and while the controls screen is open.
+     *
+     * @return bool  True if this frame's ticks should run backwards.
      */
-    void render();
-
-    // =========================================================================
-    // Collision helpers
-    // =========================================================================
+    bool isRewindHeld() const;
 
     /**
-     * @brief Tests the ball against the four window walls and responds.
-     *
-     * - Left and right walls: reflect the ball horizontally.
-     * - Top wall: reflect the ball vertically.
-     * - Bottom boundary: deduct a life; either reset the ball or trigger
-     *   GameOver if no lives remain.
+     * @brief Returns the state that selects what is drawn this frame.
+     * @return GameState  Controls while the controls screen is open,
+     *                    otherwise the simulation's state.
      */
-    void handleWallCollisions();
+    GameState currentScreen() const;
 
     /**
-     * @brief Tests the ball against the paddle and responds if they intersect.
+     * @brief Draws the current frame and presents it.
      *
-     * Uses an AABB broad phase before computing the precise contact position.
-     * Collision response maps the horizontal hit offset (in [-1, 1] relative
-     * to the paddle centre) to a launch angle of up to ±75° from vertical,
-     * giving the player meaningful directional control.
-     *
-     * The ball is nudged above the paddle surface after each collision to
-     * prevent it from becoming trapped inside the shape.
+     * Delegates the scene to Renderer, adds the latency marker if required,
+     * and calls display().
      */
-    void handlePaddleCollision();
+    void render();
 
     /**
-     * @brief Tests the ball against every active brick and responds.
+     * @brief Draws the latency-test photodiode marker.
      *
-     * Uses the circle–AABB nearest-point method to find the collision normal.
-     * Only the first intersection resolved per frame reverses the ball's
-     * direction; subsequent bricks hit in the same frame are still damaged but
-     * do not cause additional reflections, preventing erratic multi-bounce
-     * behaviour at brick-cluster boundaries.
+     * A solid white square in the top-left corner, drawn last so nothing
+     * covers it, in every frame that consumed a probed input.
      */
-    void handleBrickCollisions();
+    void drawLatencyMarker();
 
     /**
-     * @brief Reflects the ball's velocity off a surface defined by @p normal.
+     * @brief Loads the --ghost replay and finds where its game starts.
      *
-     * Applies the standard specular-reflection formula:
-     *   r = v − 2(v·n)n
+     * The recording's menu ticks are played once; the tick after its first
+     * Launch becomes ghostStartTick.  Unreadable replays, and replays that
+     * never leave the menu, are reported and leave the ghost off.
      *
-     * @param normal  Unit vector perpendicular to the reflecting surface,
-     *                pointing away from the surface into the ball's half-space.
-     */
-    void reflectBall(sf::Vector2f normal);
-
-    // =========================================================================
-    // Render helpers
-    // =========================================================================
-
-    /**
-     * @brief Draws the heads-up display: score (left), level (centre),
-     *        and life indicators (right).
+     * @param path  Replay file to race.
      */
-    void drawHUD();
+    void loadGhost(const std::string& path);
 
     /**
-     * @brief Draws a semi-transparent overlay appropriate for the current state.
+     * @brief Steps the ghost in lockstep with the tick just simulated.
+     *
+     * When sim starts a new game the ghost seeks to ghostStartTick, so every
+     * game races the recorded one from its launch.  Afterwards the ghost
+     * advances one recorded tick per sim tick, except while sim is paused.
+     * It stops when sim's game ends or the recording runs out.
      *
-     * Used for all non-Playing states: MainMenu, Paused, LevelComplete,
-     * GameOver, and Victory.  Each state gets a dark backdrop plus a set of
-     * centred text strings with game-specific messaging.
+     * @param previousState  Simulation state before the tick.
      */
-    void drawStateOverlay();
+    void advanceGhost(GameState previousState);
 
     /**
-     * @brief Draws the full-screen controls reference card.
+     * @brief Moves the ghost back to match a rewind of the live game.
      *
-     * Shows every keyboard shortcut and the scoring table with colour-coded
-     * brick rows.  Triggered by pressing H from the main menu or pause screen;
-     * returns to the previous state when the player presses H or Esc.
+     * A single keyframe seek, so the cost per frame is bounded by the
+     * keyframe interval rather than by the number of ticks rewound.
      *
-     * Layout
-     * ------
-     * The screen is divided into three sections separated by faint horizontal
-     * rules: Movement, Game Controls, and Scoring.  Key labels are drawn in a
-     * fixed left column; descriptions in a fixed right column.  Brick-row
-     * score entries include a small filled circle in the matching brick colour.
+     * @param ticks  Rewound ticks during which the ghost had moved.
      */
-    void drawControlsScreen();
+    void rewindGhost(std::uint32_t ticks);
 
     /**
-     * @brief Horizontally centres an sf::Text object within the window.
+     * @brief Restores the game from savePath if a save exists there.
      *
-     * Sets the text's X position so its bounding box is centred, and its Y
-     * position to @p y.
-     *
-     * @param text  Text object to reposition (string must already be set).
-     * @param y     Desired Y coordinate of the top of the text, in pixels.
+     * A missing file is silently ignored; an unreadable or corrupt one, or
+     * one made on other levels, is reported and the game starts fresh.
+     * Sets ownsSave unless a file was there and could not be resumed.
      */
-    void centreTextHorizontally(sf::Text& text, float y);
+    void resumeSavedGame();
 
     /**
-     * @brief Creates a configured sf::Text ready for rendering.
-     *
-     * Convenience factory that assigns the shared font, a character size, and
-     * a fill colour in a single call.
+     * @brief Writes the current game to savePath on exit.
      *
-     * @param content        The string to display.
-     * @param characterSize  Point size passed to sf::Text::setCharacterSize.
-     * @param color          Fill colour of the text glyphs.
-     * @return sf::Text  Fully initialised text object.
+     * A game in progress is saved paused, so resuming never drops the player
+     * straight into a moving ball.  From the menu or an end screen there is
+     * nothing to resume and any existing save is deleted instead.  Does
+     * nothing unless ownsSave is set, so a save this game refused survives.
      */
-    sf::Text makeText(const std::string& content,
-                      unsigned int characterSize,
-                      sf::Color color) const;
+    void saveGame();
 
     // =========================================================================
     // Member data
@@ -262,21 +259,85 @@ private:
     sf::Font           font;               ///< Shared font for all text rendering.
     sf::Clock          clock;              ///< Measures per-frame delta time.
 
-    Ball               ball;              ///< The bouncing ball.
-    Paddle             paddle;            ///< Player-controlled paddle.
-    std::vector<Brick> bricks;            ///< All bricks in the current level.
+    std::shared_ptr<const LevelPack> levels; ///< Campaign played by every simulation here.
+    LevelWatcher       levelWatcher;      ///< Reloads edited level files (--watch-levels).
+
+    Simulation         sim;               ///< Headless game model.
+    Renderer           renderer;          ///< Draws sim into the window.
+
+    float              tickAccumulator;   ///< Real time not yet simulated (s).
+    InputMask          pendingCommands;   ///< Launch/Pause awaiting the next tick.
+
+    /// True while the controls reference card is shown.  Reachable by
+    /// pressing H from the main menu or while paused; the simulation keeps
+    /// its own state (MainMenu or Paused) underneath.
+    bool               showingControls;
+
+    LatencyProbe       latencyProbe;      ///< Input-to-photon timing (optional).
+
+    /// Consecutive frames spent in Playing state; drives the allocation
+    /// tracker's steady-state detection.
+    int                steadyPlayingFrames;
+
+    PerfCounters       perfCounters;      ///< Hardware counters per phase (optional).
+
+    /**
+     * @brief Metrics published by the game loop.
+     *
+     * Registered once at construction; updating them is a relaxed atomic
+     * operation, so they are maintained whether or not a server is running.
+     */
+    struct Telemetry
+    {
+        explicit Telemetry(MetricsRegistry& registry);
+
+        MetricsRegistry::Histogram& frameSeconds;    ///< Real frame durations.
+        MetricsRegistry::Counter&   frames;          ///< Frames presented.
+        MetricsRegistry::Counter&   ticks;           ///< Simulation ticks run.
+        MetricsRegistry::Counter&   heapAllocations; ///< Frame-thread allocations (tracking builds).
+        MetricsRegistry::Counter&   gamesStarted;    ///< New games begun.
+        MetricsRegistry::Counter&   gamesOver;       ///< Games ended by losing all lives.
+        MetricsRegistry::Counter&   livesLost;       ///< Balls lost.
+        MetricsRegistry::Histogram& levelSeconds;    ///< Play time to clear a level.
+        MetricsRegistry::Gauge&     score;           ///< Current score.
+        MetricsRegistry::Gauge&     level;           ///< Current level.
+        MetricsRegistry::Gauge&     lives;           ///< Current lives.
+    };
+
+    MetricsRegistry    metrics;           ///< Registry behind the metrics endpoint.
+    Telemetry          telemetry;         ///< Game-loop metrics in `metrics`.
+    MetricsServer      metricsServer;     ///< Background endpoint (optional).
+
+    /// Ticks spent in Playing since the current level began; observed into
+    /// Telemetry::levelSeconds when the level is cleared.
+    std::uint32_t      levelPlayTicks;
+
+    Replay             recording;         ///< Inputs of this session (--record).
+    std::string        recordPath;        ///< Where recording is saved; empty = off.
+    Replay             playback;          ///< Replay being played (--replay).
+    ReplayPlayer       player;            ///< Read position in playback.
+    bool               replaying;         ///< True while playback drives sim.
+    bool               replayDesynced;    ///< A state-hash mismatch was reported.
+
+    RewindBuffer       rewind;            ///< Last REWIND_SECONDS of snapshots.
+    GameSnapshot       tickSnapshot;      ///< Reused for every rewind push and pop.
+
+    /// Recent inputs and keyframes, dumped as a replay on a crash or hang.
+    FlightRecorder     flightRecorder;
 
-    GameState          state;             ///< Current logical game state.
-    int                score;             ///< Accumulated player score.
-    int                lives;             ///< Remaining player lives.
-    int                level;             ///< Current level number (1-based).
-    float              ballSpeed;         ///< Active ball speed in pixels/second.
+    /// Save-state resumed on launch and written on exit.  Empty when saving
+    /// is off, including during replay playback and recording, whose
+    /// inputs only make sense from the start of a fresh game.
+    std::string        savePath;
 
-    float              levelCompleteTimer;///< Countdown (seconds) before advancing.
-    int                bricksRemaining;   ///< Live brick count in current level.
+    /// savePath was empty or resumed by this game, so exiting may replace
+    /// or delete it.
+    bool               ownsSave;
 
-    /// State to return to when the player closes the Controls screen.
-    /// Set to MainMenu when H is pressed from the main menu, Paused when
-    /// pressed while the game is paused.
-    GameState          previousState;
+    Replay             ghostReplay;       ///< Recorded run raced by the ghost (--ghost).
+    ReplayPlayer       ghostPlayer;       ///< Read position in ghostReplay.
+    Simulation         ghost;             ///< Ghost game; drawn translucently over sim.
+    std::uint32_t      ghostStartTick;    ///< Ghost tick just after its game's launch.
+    bool               hasGhost;          ///< A usable ghost replay was loaded.
+    bool               ghostRunning;      ///< The ghost is racing the current game.
 };
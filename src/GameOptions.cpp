@@ -0,0 +1,246 @@
+/**
+ * @file GameOptions.cpp
+ * @brief Implementation of the command-line parser.
+ */
+
+#include "GameOptions.hpp"
+
+#include <cstdlib>  // std::atoi, std::strtoul
+#include <cstring>  // std::strcmp
+#include <iostream> // std::cout, std::cerr
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Prints the list of supported flags.
+ * @param program  Executable name (argv[0]) shown in the usage line.
+ */
+static void printUsage(const char* program)
+{
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --latency-test          Measure input-to-photon latency\n"
+              << "  --latency-log <file>    Write latency samples as CSV\n"
+              << "  --assert-no-alloc       Abort if steady-state play allocates\n"
+              << "  --perf-counters         Report CPU counters per phase (Linux)\n"
+              << "  --metrics-socket <path> Serve Prometheus metrics on a Unix socket\n"
+              << "  --metrics-port <port>   Serve Prometheus metrics on 127.0.0.1\n"
+              << "  --record <file>         Save this session as a replay\n"
+              << "  --replay <file>         Play back a replay\n"
+              << "  --ghost <file>          Race a replay's ball and paddle\n"
+              << "  --levels <dir>          Play the .brkl/.level files in <dir>\n"
+              << "  --watch-levels          Reload level files as they are saved\n"
+              << "  --generate <n>          Play levels generated from seed <n>\n"
+              << "  --endless <n>           Play endless rows generated from seed <n>\n"
+              << "  --seed <n>              Seed the game (default: current time)\n"
+              << "  --save-file <file>      Save/resume file (default: breakout.sav)\n"
+              << "  --no-save               Do not resume or save the game\n"
+              << "  --crash-dir <dir>       Where crash/hang replays go (default: .)\n"
+              << "  --no-crash-dump         Do not record crash/hang replays\n"
+              << "  --help                  Show this message\n";
+}
+
+// -----------------------------------------------------------------------------
+// Parsing
+// -----------------------------------------------------------------------------
+
+bool parseGameOptions(int argc, char* argv[], GameOptions& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+
+        // Fetches the value following a flag, reporting an error if absent.
+        auto nextValue = [&](const char*& value) -> bool
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << "[Breakout] ERROR: " << arg << " requires a value.\n";
+                return false;
+            }
+            value = argv[++i];
+            return true;
+        };
+
+        if (std::strcmp(arg, "--latency-test") == 0)
+        {
+            options.latencyTest = true;
+        }
+        else if (std::strcmp(arg, "--latency-log") == 0)
+        {
+            const char* value = nullptr;
+            if (!nextValue(value))
+                return false;
+            options.latencyTest    = true;
+            options.latencyLogPath = value;
+        }
+        else if (std::strcmp(arg, "--assert-no-alloc") == 0)
+        {
+            options.assertNoAllocations = true;
+        }
+        else if (std::strcmp(arg, "--perf-counters") == 0)
+        {
+            options.perfCounters = true;
+        }
+        else if (std::strcmp(arg, "--metrics-socket") == 0)
+        {
+            const char* value = nullptr;
+            if (!nextValue(value))
+                return false;
+            options.metricsSocketPath = value;
+        }
+        else if (std::strcmp(arg, "--metrics-port") == 0)
+        {
+            const char* value = nullptr;
+            if (!nextValue(value))
+                return false;
+            options.metricsPort = std::atoi(value);
+            if (options.metricsPort <= 0 || options.metricsPort > 65535)
+            {
+                std::cerr << "[Breakout] ERROR: Invalid port \"" << value << "\".\n";
+                return false;
+            }
+        }
+        else if (std::strcmp(arg, "--record") == 0)
+        {
+            const char* value = nullptr;
+            if (!nextValue(value))
+                return false;
+            options.recordPath = value;
+        }
+        else if (std::strcmp(arg, "--replay") == 0)
+        {
+            const char* value = nullptr;
+            if (!nextValue(value))
+                return false;
+            options.replayPath = value;
+        }
+        else if (std::strcmp(arg, "--ghost") == 0)
+        {
+            const char* value = nullptr;
+            if (!nextValue(value))
+                return false;
+            options.ghostPath = value;
+        }
+        else if (std::strcmp(arg, "--seed") == 0)
+        {
+            const char* value = nullptr;
+            if (!nextValue(value))
+                return false;
+            char* end = nullptr;
+            unsigned long seed = std::strtoul(value, &end, 0);
+            if (end == value || *end != '\0' || seed > 0xFFFFFFFFul)
+            {
+                std::cerr << "[Breakout] ERROR: Invalid seed \"" << value << "\".\n";
+                return false;
+            }
+            options.hasSeed = true;
+            options.seed    = static_cast<std::uint32_t>(seed);
+        }
+        else if (std::strcmp(arg, "--save-file") == 0)
+        {
+            const char* value = nullptr;
+            if (!nextValue(value))
+                return false;
+            options.savePath = value;
+        }
+        else if (std::strcmp(arg, "--no-save") == 0)
+        {
+            options.savePath.clear();
+        }
+        else if (std::strcmp(arg, "--levels") == 0)
+        {
+            const char* value = nullptr;
+            if (!nextValue(value))
+                return false;
+            options.levelsPath = value;
+        }
+        else if (std::strcmp(arg, "--watch-levels") == 0)
+        {
+            options.watchLevels = true;
+        }
+        else if (std::strcmp(arg, "--generate") == 0)
+        {
+            const char* value = nullptr;
+            if (!nextValue(value))
+                return false;
+            char* end = nullptr;
+            unsigned long seed = std::strtoul(value, &end, 0);
+            if (end == value || *end != '\0' || seed > 0xFFFFFFFFul)
+            {
+                std::cerr << "[Breakout] ERROR: Invalid level seed \"" << value << "\".\n";
+                return false;
+            }
+            options.generateLevels = true;
+            options.levelSeed      = static_cast<std::uint32_t>(seed);
+        }
+        else if (std::strcmp(arg, "--endless") == 0)
+        {
+            const char* value = nullptr;
+            if (!nextValue(value))
+                return false;
+            char* end = nullptr;
+            unsigned long seed = std::strtoul(value, &end, 0);
+            if (end == value || *end != '\0' || seed > 0xFFFFFFFFul)
+            {
+                std::cerr << "[Breakout] ERROR: Invalid endless seed \"" << value << "\".\n";
+                return false;
+            }
+            options.endless     = true;
+            options.endlessSeed = static_cast<std::uint32_t>(seed);
+        }
+        else if (std::strcmp(arg, "--crash-dir") == 0)
+        {
+            const char* value = nullptr;
+            if (!nextValue(value))
+                return false;
+            options.crashDirectory = value;
+        }
+        else if (std::strcmp(arg, "--no-crash-dump") == 0)
+        {
+            options.crashDirectory.clear();
+        }
+        else if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0)
+        {
+            printUsage(argv[0]);
+            return false;
+        }
+        else
+        {
+            std::cerr << "[Breakout] ERROR: Unknown option \"" << arg << "\".\n";
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+
+    if (!options.metricsSocketPath.empty() && options.metricsPort > 0)
+    {
+        std::cerr << "[Breakout] ERROR: Use either --metrics-socket or --metrics-port, not both.\n";
+        return false;
+    }
+
+    const int levelSources = (options.levelsPath.empty() ? 0 : 1) +
+                             (options.generateLevels ? 1 : 0) +
+                             (options.endless ? 1 : 0);
+    if (levelSources > 1)
+    {
+        std::cerr << "[Breakout] ERROR: Use only one of --levels, --generate and --endless.\n";
+        return false;
+    }
+
+    if (options.watchLevels && options.levelsPath.empty())
+    {
+        std::cerr << "[Breakout] ERROR: --watch-levels needs --levels.\n";
+        return false;
+    }
+
+    // A replay only plays back against the levels it was recorded with.
+    if (options.watchLevels && !options.replayPath.empty())
+    {
+        std::cerr << "[Breakout] ERROR: Use either --watch-levels or --replay, not both.\n";
+        return false;
+    }
+
+    return true;
+}
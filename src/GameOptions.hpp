@@ -0,0 +1,122 @@
+/**
+ * @file GameOptions.hpp
+ * @brief Command-line switches that select optional runtime modes.
+ *
+ * The default-constructed GameOptions reproduces the normal interactive game
+ * (which saves on exit, resumes on launch, and keeps a flight recorder for
+ * crashes); every other field enables a
+ * diagnostic or tooling feature that is off unless the matching flag is
+ * passed on the command line.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Runtime options parsed from the command line by main().
+ */
+struct GameOptions
+{
+    /// Enables the input-to-photon latency test mode (see LatencyProbe).
+    bool        latencyTest = false;
+
+    /// Optional CSV file receiving one row per latency sample.  Empty = none.
+    std::string latencyLogPath;
+
+    /// Abort if a steady-state Playing frame allocates (tracking builds only).
+    bool        assertNoAllocations = false;
+
+    /// Sample hardware performance counters per frame phase (Linux only).
+    bool        perfCounters = false;
+
+    /// Serve Prometheus metrics on this Unix domain socket.  Empty = off.
+    std::string metricsSocketPath;
+
+    /// Serve Prometheus metrics on 127.0.0.1 at this port.  0 = off.
+    int         metricsPort = 0;
+
+    /// Record every tick's input to this replay file on exit.  Empty = off.
+    std::string recordPath;
+
+    /// Play this replay file instead of reading the keyboard.  Empty = off.
+    std::string replayPath;
+
+    /// Replay whose ball and paddle are drawn translucently over each new
+    /// game, in lockstep with it.  Empty = off.
+    std::string ghostPath;
+
+    /// Directory of level files played instead of the built-in levels
+    /// (see Level.hpp).  Empty = built-in levels.
+    std::string levelsPath;
+
+    /// Reload files in levelsPath as they change (see LevelWatcher.hpp).
+    bool          watchLevels = false;
+
+    /// Play a procedurally generated campaign (see LevelGenerator.hpp)
+    /// instead of the built-in levels.
+    bool          generateLevels = false;
+
+    /// Campaign seed when generateLevels is set.
+    std::uint32_t levelSeed = 0;
+
+    /// Play endless mode (see EndlessField.hpp) instead of a campaign.
+    bool          endless = false;
+
+    /// Row seed when endless is set.
+    std::uint32_t endlessSeed = 0;
+
+    /// Use seed instead of the current time to seed the simulation.
+    bool          hasSeed = false;
+
+    /// Simulation seed when hasSeed is set.
+    std::uint32_t seed = 0;
+
+    /// Save-state written on exit and resumed on launch.  Empty = off.
+    std::string savePath = "breakout.sav";
+
+    /// Directory receiving flight-recorder replays of crashes and hangs.
+    /// Empty = recorder off.
+    std::string crashDirectory = ".";
+};
+
+/**
+ * @brief Parses command-line arguments into @p options.
+ *
+ * Recognised flags:
+ *   --latency-test          Enable the latency test mode.
+ *   --latency-log <file>    Also write every latency sample to a CSV file
+ *                           (implies --latency-test).
+ *   --assert-no-alloc       Abort when a steady-state frame allocates.
+ *   --perf-counters         Report hardware counters per phase on exit.
+ *   --metrics-socket <path> Serve Prometheus metrics on a Unix socket.
+ *   --metrics-port <port>   Serve Prometheus metrics on 127.0.0.1:<port>
+ *                           (mutually exclusive with --metrics-socket).
+ *   --record <file>         Save the session's inputs as a replay on exit.
+ *   --replay <file>         Play back a recorded replay.
+ *   --ghost <file>          Overlay a replay's ball and paddle on each game.
+ *   --levels <dir>          Play the level files in <dir>.
+ *   --watch-levels          Reload level files when they change
+ *                           (needs --levels; not with --replay).
+ *   --generate <n>          Play levels generated from seed <n>
+ *                           (mutually exclusive with --levels).
+ *   --endless <n>           Play endless rows generated from seed <n>
+ *                           (mutually exclusive with --levels and
+ *                           --generate).
+ *   --seed <n>              Seed the simulation with <n> instead of the time.
+ *   --save-file <file>      Save and resume the game in <file>.
+ *   --no-save               Neither resume nor save the game.
+ *   --crash-dir <dir>       Write crash and hang replays to <dir>.
+ *   --no-crash-dump         Turn the flight recorder off.
+ *   --help                  Print usage and return false.
+ *
+ * Unknown flags or missing values print a message to stderr.
+ *
+ * @param argc     Argument count as passed to main().
+ * @param argv     Argument vector as passed to main().
+ * @param options  Receives the parsed options.
+ * @return true if the game should start; false if it should exit (help was
+ *         requested or an argument was invalid).
+ */
+bool parseGameOptions(int argc, char* argv[], GameOptions& options);
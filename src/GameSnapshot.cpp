@@ -0,0 +1,108 @@
+/**
+ * @file GameSnapshot.cpp
+ * @brief Packing and unpacking of GameSnapshot.
+ */
+
+#include "GameSnapshot.hpp"
+
+#include <algorithm> // std::min
+#include <cstring>   // std::memcpy, std::memset
+#include <ostream>
+
+static_assert(std::is_standard_layout<GameSnapshot>::value,
+              "offsetof(GameSnapshot, ...) requires a standard-layout snapshot");
+
+/// Fixed fields are everything ahead of the brick array.
+static constexpr std::size_t FIXED_BYTES = offsetof(GameSnapshot, brickHitPoints);
+
+std::size_t GameSnapshot::fixedBytes()
+{
+    return FIXED_BYTES;
+}
+
+void GameSnapshot::reset()
+{
+    // The fixed fields are plain data ahead of the vector; the void* cast
+    // tells the compiler the partial write is intentional.
+    std::memset(static_cast<void*>(this), 0, FIXED_BYTES);
+    brickHitPoints.clear();
+}
+
+std::size_t GameSnapshot::packedSize() const
+{
+    return FIXED_BYTES + brickHitPoints.size();
+}
+
+void GameSnapshot::pack(std::uint8_t* out) const
+{
+    std::memcpy(out, this, FIXED_BYTES);
+    if (!brickHitPoints.empty())
+        std::memcpy(out + FIXED_BYTES, brickHitPoints.data(), brickHitPoints.size());
+}
+
+bool GameSnapshot::unpack(const std::uint8_t* data, std::size_t size, GameSnapshot& out)
+{
+    if (size < FIXED_BYTES)
+        return false;
+
+    std::memcpy(static_cast<void*>(&out), data, FIXED_BYTES);
+    out.brickHitPoints.assign(data + FIXED_BYTES, data + size);
+    return true;
+}
+
+int GameSnapshot::writeDifferences(std::ostream& out, const GameSnapshot& expected,
+                                   const GameSnapshot& actual)
+{
+    // Bricks listed individually before the rest are summarised.
+    static constexpr int MAX_LISTED_BRICKS = 16;
+
+    // Enough digits to tell apart any two distinct floats.
+    const std::streamsize previousPrecision = out.precision(9);
+
+    int differences = 0;
+    auto compare = [&](const char* name, auto expectedValue, auto actualValue)
+    {
+        if (expectedValue != actualValue)
+        {
+            out << "    " << name << ": expected " << +expectedValue
+                << ", got " << +actualValue << '\n';
+            ++differences;
+        }
+    };
+
+    compare("ball.x",             expected.ballX,              actual.ballX);
+    compare("ball.y",             expected.ballY,              actual.ballY);
+    compare("ball.velocityX",     expected.ballVelocityX,      actual.ballVelocityX);
+    compare("ball.velocityY",     expected.ballVelocityY,      actual.ballVelocityY);
+    compare("ball.moving",        expected.ballMoving,         actual.ballMoving);
+    compare("paddle.x",           expected.paddleX,            actual.paddleX);
+    compare("state",              static_cast<int>(expected.state), static_cast<int>(actual.state));
+    compare("score",              expected.score,              actual.score);
+    compare("lives",              expected.lives,              actual.lives);
+    compare("level",              expected.level,              actual.level);
+    compare("ballSpeed",          expected.ballSpeed,          actual.ballSpeed);
+    compare("levelCompleteTimer", expected.levelCompleteTimer, actual.levelCompleteTimer);
+    compare("bricksRemaining",    expected.bricksRemaining,    actual.bricksRemaining);
+    compare("brickClock",         expected.brickClock,         actual.brickClock);
+    compare("tick",               expected.tick,               actual.tick);
+    compare("rng",                expected.rng.getState(),     actual.rng.getState());
+    compare("brickCount",         expected.brickHitPoints.size(), actual.brickHitPoints.size());
+
+    int brickDifferences = 0;
+    const std::size_t bricks = std::min(expected.brickHitPoints.size(), actual.brickHitPoints.size());
+    for (std::size_t i = 0; i < bricks; ++i)
+    {
+        if (expected.brickHitPoints[i] == actual.brickHitPoints[i])
+            continue;
+        if (brickDifferences++ < MAX_LISTED_BRICKS)
+        {
+            out << "    brick[" << i << "].hitPoints: expected "
+                << +expected.brickHitPoints[i] << ", got " << +actual.brickHitPoints[i] << '\n';
+        }
+    }
+    if (brickDifferences > MAX_LISTED_BRICKS)
+        out << "    ... and " << brickDifferences - MAX_LISTED_BRICKS << " more bricks\n";
+
+    out.precision(previousPrecision);
+    return differences + brickDifferences;
+}
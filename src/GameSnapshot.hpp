@@ -0,0 +1,112 @@
+/**
+ * @file GameSnapshot.hpp
+ * @brief Declaration of GameSnapshot — the complete simulation state as POD.
+ *
+ * The live Simulation keeps its state inside SFML shapes and a brick vector.
+ * A GameSnapshot holds the same information as plain numbers: everything
+ * that influences future ticks, and nothing that can be recomputed (brick
+ * positions and colours follow from the level layout and brickClock, the
+ * paddle's Y from the constants).
+ *
+ * Snapshots are a fixed block of plain fields plus one hit-point byte per
+ * brick of the level.  Refilling an existing snapshot (reset() and
+ * Simulation::snapshot(GameSnapshot&)) reuses its brick array, so taking one
+ * every tick or cycling thousands through a ring buffer does not allocate
+ * once the arrays have grown to the level's size.  Restoring a snapshot with
+ * Simulation::restore() continues the game exactly as if it had never left
+ * that tick.  The packed form (pack() / unpack()) is what save-states and
+ * replay keyframes store on disk.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "GameState.hpp"
+#include "Random.hpp"
+
+/**
+ * @brief Plain-data copy of a Simulation at the start of one tick.
+ */
+struct GameSnapshot
+{
+    // ---- Ball ----
+    float         ballX;               ///< Ball centre X, pixels.
+    float         ballY;               ///< Ball centre Y, pixels.
+    float         ballVelocityX;       ///< Pixels per second.
+    float         ballVelocityY;       ///< Pixels per second.
+    bool          ballMoving;          ///< True once launched.
+
+    // ---- Paddle ----
+    float         paddleX;             ///< Paddle left edge, pixels.
+
+    // ---- Game progress ----
+    GameState     state;               ///< State machine position.
+    std::int32_t  score;               ///< Accumulated score.
+    std::int32_t  lives;               ///< Remaining lives.
+    std::int32_t  level;               ///< Current level (1-based).
+    float         ballSpeed;           ///< Active ball speed, pixels/second.
+    float         levelCompleteTimer;  ///< Seconds until the next level.
+    std::int32_t  bricksRemaining;     ///< Live brick count.
+    std::uint32_t brickClock;          ///< Ticks the level has been played; places moving bricks.
+
+    // ---- Determinism ----
+    std::uint32_t tick;                ///< Ticks simulated so far.
+    std::uint32_t seed;                ///< Construction seed.
+    Random        rng;                 ///< Generator position.
+
+    // ---- Bricks ----
+
+    /// Remaining hit points per brick in layout order; 0 = destroyed.
+    std::vector<std::uint8_t> brickHitPoints;
+
+    /**
+     * @brief Zeroes every fixed field and empties brickHitPoints, keeping
+     *        its capacity.
+     *
+     * Zeroing includes padding, so identical states pack to identical bytes.
+     */
+    void reset();
+
+    // ---- Packed form ----
+    //
+    // Files store a snapshot as its fixed fields copied verbatim (native
+    // byte order) followed by one byte per brick, so packing and unpacking
+    // are two memcpys.
+
+    /// @return Bytes of fixed fields in the packed form; changes whenever
+    ///         the layout does, so it doubles as a format fingerprint.
+    static std::size_t fixedBytes();
+
+    /// @return Size of this snapshot's packed form.
+    std::size_t packedSize() const;
+
+    /**
+     * @brief Writes the packed form to @p out.
+     * @param out  Destination of at least packedSize() bytes.
+     */
+    void pack(std::uint8_t* out) const;
+
+    /**
+     * @brief Reads a packed snapshot.
+     * @param data  Packed bytes.
+     * @param size  Number of bytes; everything after the fixed fields is
+     *              brick hit points.
+     * @param out   Receives the snapshot on success; untouched on failure.
+     * @return true if @p size covers the fixed fields.
+     */
+    static bool unpack(const std::uint8_t* data, std::size_t size, GameSnapshot& out);
+
+    /**
+     * @brief Lists every field in which @p actual differs from @p expected.
+     * @param out       Stream receiving one indented line per difference.
+     * @param expected  Reference state.
+     * @param actual    State to compare.
+     * @return int  Number of differing fields; each brick counts as one.
+     */
+    static int writeDifferences(std::ostream& out, const GameSnapshot& expected,
+                                const GameSnapshot& actual);
+};
@@ -2,8 +2,8 @@
  * @file GameState.hpp
  * @brief Defines every distinct logical state the game can occupy.
  *
- * The Game class maintains one active GameState at a time and drives all
- * rendering and update logic through it.  Transitions between states are
+ * The Simulation maintains one active GameState at a time and drives all
+ * update logic through it; Renderer uses it to choose what to draw.  Transitions between states are
  * triggered by player input (keyboard events) and in-game conditions
  * (ball lost, all bricks cleared, timer expiry).
  */
@@ -40,5 +40,7 @@ enum class GameState
 
     /// Full-screen controls reference card, reachable by pressing H from the
     /// main menu or the pause screen.  Press H or Esc to return.
+    /// Presentation-only: Game shows this screen while the Simulation stays
+    /// in MainMenu or Paused underneath.
     Controls
 };
@@ -0,0 +1,129 @@
+/**
+ * @file Hash.hpp
+ * @brief Non-cryptographic hashes: file checksums and simulation state.
+ *
+ * FNV-1a is tiny, has no tables, and detects the truncation and bit-rot that
+ * file checksums are meant to catch.
+ *
+ * hashWords() hashes a handful of 64-bit words in a few nanoseconds, for the
+ * per-tick simulation state hash; brickStateKey() gives the per-brick terms
+ * of its brick-damage component.  It uses the 64×64→128-bit multiply-fold
+ * mix of wyhash: each pair of words is folded by one independent multiply,
+ * so the multiplies overlap in the pipeline instead of forming the long
+ * serial chain of xxHash64's short-input path.  foldHash16() shortens such
+ * a hash for replays, which store one for every tick.
+ *
+ * Neither is a cryptographic hash or offers protection against deliberate
+ * tampering.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__SIZEOF_INT128__)
+#include <intrin.h> // _umul128
+#endif
+
+/// FNV-1a starting value; pass a previous result instead to hash in pieces.
+constexpr std::uint32_t FNV1A_OFFSET_BASIS = 2166136261u;
+
+/**
+ * @brief Hashes @p count bytes starting at @p data.
+ * @param data   Bytes to hash.
+ * @param count  Number of bytes.
+ * @param hash   Running hash (FNV1A_OFFSET_BASIS for a fresh hash).
+ * @return std::uint32_t  Updated hash.
+ */
+inline std::uint32_t fnv1a(const void* data, std::size_t count,
+                           std::uint32_t hash = FNV1A_OFFSET_BASIS)
+{
+    const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/// Mixing constants (the wyhash "secret").
+constexpr std::uint64_t HASH_SECRET[4] = {
+    0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL,
+    0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL,
+};
+
+/**
+ * @brief Multiplies @p a by @p b to 128 bits and folds the halves together.
+ */
+inline std::uint64_t hashFold(std::uint64_t a, std::uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 Product;
+    Product product = static_cast<Product>(a) * b;
+    return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    std::uint64_t high;
+    std::uint64_t low = _umul128(a, b, &high);
+    return low ^ high;
+#else
+    // Portable 64×64→128 from four 32×32 partial products.
+    std::uint64_t aLow = a & 0xFFFFFFFFu, aHigh = a >> 32;
+    std::uint64_t bLow = b & 0xFFFFFFFFu, bHigh = b >> 32;
+    std::uint64_t ll = aLow * bLow,  lh = aLow * bHigh;
+    std::uint64_t hl = aHigh * bLow, hh = aHigh * bHigh;
+    std::uint64_t middle = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+    std::uint64_t low    = (middle << 32) | (ll & 0xFFFFFFFFu);
+    std::uint64_t high   = hh + (lh >> 32) + (hl >> 32) + (middle >> 32);
+    return low ^ high;
+#endif
+}
+
+/**
+ * @brief Returns the key of brick @p index at @p hitPoints.
+ *
+ * The simulation's brick hash is the XOR of every brick's key at its
+ * current hit points, so a hit updates it with two XORs.
+ */
+inline std::uint64_t brickStateKey(std::size_t index, int hitPoints)
+{
+    std::uint64_t id = (static_cast<std::uint64_t>(index) << 8) | static_cast<std::uint8_t>(hitPoints);
+    return hashFold(id ^ HASH_SECRET[2], HASH_SECRET[3]);
+}
+
+/**
+ * @brief Hashes @p count 64-bit words.
+ *
+ * Words are folded pairwise with position-dependent constants and the
+ * results combined, so the cost is roughly one multiply per two words.
+ * An odd final word is paired with zero.
+ *
+ * @param words  Words to hash.
+ * @param count  Number of words.
+ * @param seed   Distinguishes independent uses of the hash.
+ * @return std::uint64_t  Hash.
+ */
+inline std::uint64_t hashWords(const std::uint64_t* words, std::size_t count,
+                               std::uint64_t seed = 0)
+{
+    std::uint64_t accumulator = seed ^ HASH_SECRET[0];
+    for (std::size_t i = 0; i < count; i += 2)
+    {
+        std::uint64_t salt   = HASH_SECRET[1] * (i + 1);
+        std::uint64_t second = (i + 1 < count) ? words[i + 1] : 0;
+        accumulator ^= hashFold(words[i] ^ salt ^ HASH_SECRET[2], second ^ salt ^ HASH_SECRET[3]);
+    }
+    return hashFold(accumulator ^ HASH_SECRET[0], static_cast<std::uint64_t>(count) ^ HASH_SECRET[1]);
+}
+
+/**
+ * @brief Folds @p hash to 16 bits by XOR-ing its four 16-bit lanes.
+ *
+ * Every bit of a hashWords() result is well mixed, so two different states
+ * collide in the folded hash with probability 1 in 65 536.
+ */
+inline std::uint16_t foldHash16(std::uint64_t hash)
+{
+    return static_cast<std::uint16_t>(hash ^ (hash >> 16) ^ (hash >> 32) ^ (hash >> 48));
+}
@@ -0,0 +1,39 @@
+/**
+ * @file Input.hpp
+ * @brief Per-tick player input as a compact bitmask.
+ *
+ * The simulation never reads the keyboard itself.  Game samples the keyboard
+ * and event queue once per frame and hands every simulation tick an InputMask
+ * describing what the player is doing, so the same simulation can be driven
+ * by a live player, a bot, or a recorded session.
+ *
+ * Left and Right are level-triggered (set for as long as the key is held).
+ * Launch and Pause are edge-triggered: each key press sets the bit on exactly
+ * one tick.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/// Bitmask of Input flags for a single simulation tick.
+using InputMask = std::uint8_t;
+
+namespace Input {
+
+    /// Move the paddle left (held).
+    constexpr InputMask Left   = 1u << 0;
+
+    /// Move the paddle right (held).
+    constexpr InputMask Right  = 1u << 1;
+
+    /// Launch the ball, or restart after game over / victory (pressed).
+    constexpr InputMask Launch = 1u << 2;
+
+    /// Toggle pause (pressed).
+    constexpr InputMask Pause  = 1u << 3;
+
+    /// All bits that carry meaning; anything else is ignored.
+    constexpr InputMask All    = Left | Right | Launch | Pause;
+
+} // namespace Input
@@ -0,0 +1,195 @@
+/**
+ * @file LatencyProbe.cpp
+ * @brief Implementation of the LatencyProbe class.
+ */
+
+#include "LatencyProbe.hpp"
+
+#include <algorithm> // std::sort, std::min
+#include <iomanip>   // std::setw, std::setprecision
+#include <iostream>  // std::cerr
+#include <ostream>
+
+// -----------------------------------------------------------------------------
+// Construction
+// -----------------------------------------------------------------------------
+
+LatencyProbe::LatencyProbe(bool enabled, const std::string& logPath)
+    : enabled(enabled)
+    , startTime(Clock::now())
+    , pendingInputs()
+    , pendingCount(0)
+    , tickStamped(false)
+    , tickTime()
+    , submitTime()
+    , frameIndex(0)
+{
+    if (!enabled)
+        return;
+
+    // Reserve the whole sample store up front so recording never allocates
+    // inside the frame being measured.
+    samples.reserve(MAX_SAMPLES);
+
+    if (!logPath.empty())
+    {
+        log.open(logPath);
+        if (!log)
+        {
+            std::cerr << "[Breakout] WARNING: Could not open latency log \""
+                      << logPath << "\".\n";
+        }
+        else
+        {
+            log << "frame,input_us,tick_us,submit_us,swap_us\n";
+        }
+    }
+}
+
+bool LatencyProbe::isEnabled() const
+{
+    return enabled;
+}
+
+// -----------------------------------------------------------------------------
+// Stage timestamps
+// -----------------------------------------------------------------------------
+
+void LatencyProbe::onInput()
+{
+    if (!enabled || pendingCount >= MAX_PENDING_INPUTS)
+        return;
+
+    pendingInputs[pendingCount++] = Clock::now();
+}
+
+void LatencyProbe::onTickConsumed()
+{
+    if (!enabled || pendingCount == 0)
+        return;
+
+    tickTime    = Clock::now();
+    tickStamped = true;
+}
+
+void LatencyProbe::onRenderSubmitted()
+{
+    if (!enabled || !tickStamped)
+        return;
+
+    submitTime = Clock::now();
+}
+
+void LatencyProbe::onBufferSwapped()
+{
+    if (!enabled)
+        return;
+
+    ++frameIndex;
+
+    if (!tickStamped)
+        return;
+
+    TimePoint swapTime = Clock::now();
+
+    for (std::size_t i = 0; i < pendingCount; ++i)
+    {
+        const TimePoint inputTime = pendingInputs[i];
+
+        if (samples.size() < MAX_SAMPLES)
+        {
+            Sample sample;
+            sample.inputToTick  = toMicros(tickTime)   - toMicros(inputTime);
+            sample.tickToSubmit = toMicros(submitTime) - toMicros(tickTime);
+            sample.submitToSwap = toMicros(swapTime)   - toMicros(submitTime);
+            sample.inputToSwap  = toMicros(swapTime)   - toMicros(inputTime);
+            samples.push_back(sample);
+        }
+
+        if (log.is_open())
+        {
+            log << frameIndex               << ','
+                << toMicros(inputTime)      << ','
+                << toMicros(tickTime)       << ','
+                << toMicros(submitTime)     << ','
+                << toMicros(swapTime)       << '\n';
+        }
+    }
+
+    pendingCount = 0;
+    tickStamped  = false;
+}
+
+bool LatencyProbe::shouldDrawMarker() const
+{
+    return enabled && tickStamped;
+}
+
+// -----------------------------------------------------------------------------
+// Reporting
+// -----------------------------------------------------------------------------
+
+void LatencyProbe::writeReport(std::ostream& out) const
+{
+    if (!enabled)
+        return;
+
+    out << "[Breakout] Latency report (" << samples.size() << " inputs, "
+        << frameIndex << " frames), milliseconds:\n";
+
+    if (samples.empty())
+    {
+        out << "  no gameplay input was recorded\n";
+        return;
+    }
+
+    struct Stage { const char* name; std::int64_t Sample::* field; };
+    static const Stage stages[] = {
+        { "input  -> tick  ", &Sample::inputToTick  },
+        { "tick   -> submit", &Sample::tickToSubmit },
+        { "submit -> swap  ", &Sample::submitToSwap },
+        { "input  -> swap  ", &Sample::inputToSwap  },
+    };
+
+    out << "  stage               min     mean      p50      p95      p99      max\n";
+
+    std::vector<std::int64_t> values(samples.size());
+
+    for (const Stage& stage : stages)
+    {
+        std::int64_t total = 0;
+        for (std::size_t i = 0; i < samples.size(); ++i)
+        {
+            values[i] = samples[i].*stage.field;
+            total    += values[i];
+        }
+        std::sort(values.begin(), values.end());
+
+        // Nearest-rank percentile over the sorted samples.
+        auto percentile = [&](double p)
+        {
+            std::size_t rank = static_cast<std::size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+            return static_cast<double>(values[std::min(rank, values.size() - 1)]) / 1000.0;
+        };
+
+        double mean = static_cast<double>(total) / static_cast<double>(values.size()) / 1000.0;
+
+        out << "  " << stage.name << std::fixed << std::setprecision(3)
+            << std::setw(9) << static_cast<double>(values.front()) / 1000.0
+            << std::setw(9) << mean
+            << std::setw(9) << percentile(0.50)
+            << std::setw(9) << percentile(0.95)
+            << std::setw(9) << percentile(0.99)
+            << std::setw(9) << static_cast<double>(values.back()) / 1000.0
+            << '\n';
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Private helpers
+// -----------------------------------------------------------------------------
+
+std::int64_t LatencyProbe::toMicros(TimePoint t) const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(t - startTime).count();
+}
@@ -0,0 +1,138 @@
+/**
+ * @file LatencyProbe.hpp
+ * @brief Declaration of the LatencyProbe class — input-to-photon timing.
+ *
+ * In latency test mode every gameplay key press is followed through the four
+ * stages of the main loop that stand between the player and the screen:
+ *
+ *   input   – the event was returned by sf::Window::pollEvent.
+ *   tick    – the update step that acted on the input has finished.
+ *   submit  – all draw calls for the frame have been issued (just before
+ *             sf::Window::display()).
+ *   swap    – display() returned, i.e. the buffer swap (and any frame-rate
+ *             limiter sleep) is complete.
+ *
+ * On exit the probe prints the distribution of each stage-to-stage delay.
+ * For photodiode measurements the game draws a white marker square in the
+ * top-left corner of every frame that consumed a probed input; the optional
+ * CSV log records the swap timestamp of each of those frames so an external
+ * capture can be aligned with the software timeline.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Timestamps gameplay input as it travels through one frame.
+ *
+ * All methods are cheap no-ops when the probe is disabled, so Game calls them
+ * unconditionally from the main loop.
+ */
+class LatencyProbe
+{
+public:
+    /**
+     * @brief Constructs a probe.
+     *
+     * @param enabled  When false every method returns immediately.
+     * @param logPath  Optional CSV file for per-sample rows; empty = no log.
+     */
+    LatencyProbe(bool enabled, const std::string& logPath);
+
+    /**
+     * @brief Returns whether latency test mode is active.
+     * @return true if samples are being recorded.
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Records the arrival of a gameplay key event.
+     *
+     * Call as soon as the event is returned by pollEvent.  Inputs that arrive
+     * while earlier ones in the same frame are still pending are recorded
+     * individually and share the later stage timestamps.
+     */
+    void onInput();
+
+    /**
+     * @brief Marks the end of the update step for the current frame.
+     *
+     * Every pending input is considered consumed by this tick.
+     */
+    void onTickConsumed();
+
+    /**
+     * @brief Marks the point where the frame's draw calls are complete.
+     */
+    void onRenderSubmitted();
+
+    /**
+     * @brief Marks the return from display() and completes pending samples.
+     */
+    void onBufferSwapped();
+
+    /**
+     * @brief Reports whether the frame being rendered consumed probed input.
+     *
+     * Game draws the photodiode marker when this returns true.
+     *
+     * @return true between onTickConsumed() and onBufferSwapped() of a frame
+     *         that had at least one pending input.
+     */
+    bool shouldDrawMarker() const;
+
+    /**
+     * @brief Writes per-stage latency statistics to @p out.
+     *
+     * Each stage lists the sample count, minimum, mean, median, 95th and 99th
+     * percentile, and maximum in milliseconds.
+     *
+     * @param out  Destination stream.
+     */
+    void writeReport(std::ostream& out) const;
+
+private:
+    using Clock     = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    /// Inputs buffered per frame; extras in a single frame are dropped.
+    static constexpr std::size_t MAX_PENDING_INPUTS = 32;
+
+    /// Upper bound on stored samples so a long session cannot grow unbounded.
+    static constexpr std::size_t MAX_SAMPLES = 1u << 18;
+
+    /// Stage durations of a single input, in microseconds.
+    struct Sample
+    {
+        std::int64_t inputToTick;
+        std::int64_t tickToSubmit;
+        std::int64_t submitToSwap;
+        std::int64_t inputToSwap;
+    };
+
+    /**
+     * @brief Converts a time point to microseconds since the probe started.
+     * @param t  Time point to convert.
+     * @return std::int64_t  Microseconds elapsed since construction.
+     */
+    std::int64_t toMicros(TimePoint t) const;
+
+    bool                                  enabled;      ///< Latency mode active.
+    TimePoint                             startTime;    ///< Origin of CSV timestamps.
+    std::array<TimePoint, MAX_PENDING_INPUTS> pendingInputs; ///< Inputs awaiting swap.
+    std::size_t                           pendingCount; ///< Valid entries in pendingInputs.
+    bool                                  tickStamped;  ///< Tick seen for pending inputs.
+    TimePoint                             tickTime;     ///< Tick timestamp this frame.
+    TimePoint                             submitTime;   ///< Submit timestamp this frame.
+    std::uint64_t                         frameIndex;   ///< Frames since start.
+    std::vector<Sample>                   samples;      ///< Completed samples.
+    std::ofstream                         log;          ///< Optional CSV output.
+};
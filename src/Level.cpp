@@ -0,0 +1,1235 @@
+/**
+ * @file Level.cpp
+ * @brief Implementation of Level and LevelPack: built-in layouts, the level
+ *        source parser, compiled level files and the collision index.
+ */
+
+#include "Level.hpp"
+#include "BuiltInLevels.hpp"
+#include "Hash.hpp"
+#include "constants.hpp"
+
+#include <algorithm>  // std::min, std::max, std::sort, std::unique, std::any_of
+#include <array>
+#include <cctype>     // std::isspace
+#include <cmath>      // std::floor, std::round, std::abs, std::isfinite
+#include <cstring>    // std::memcpy, std::memcmp
+#include <filesystem>
+#include <fstream>
+#include <future>     // std::async
+#include <iostream>   // std::cerr
+#include <iterator>   // std::istreambuf_iterator
+#include <limits>
+#include <map>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BREAKOUT_HAVE_MMAP 1
+#endif
+
+using Header = Level::FileHeader;
+
+/// File signature.
+static const char MAGIC[4] = { 'B', 'R', 'K', 'L' };
+
+/// Largest level accepted, in bricks.
+static constexpr std::uint32_t MAX_LEVEL_BRICKS = 1u << 22;
+
+/// Tallest playfield a level source may declare, in pixels.
+static constexpr float MAX_FIELD_HEIGHT = 1.0e6f;
+
+/// Fastest a brick may move, in pixels per second: no faster than the
+/// slowest ball, so a ball bounced off a moving brick always gets away.
+static constexpr float MAX_BRICK_SPEED = Constants::BALL_INITIAL_SPEED;
+
+/// Longest cycle a moving brick may have, in seconds.
+static constexpr float MAX_PATH_SECONDS = 3600.0f;
+
+static_assert(sizeof(Header) == 48, "level file header layout changed");
+
+// =============================================================================
+// Index helpers
+// =============================================================================
+
+/**
+ * @brief Finds the index cells spanned by [@p low, @p high] along one axis.
+ * @param low     Low edge of the span.
+ * @param high    High edge of the span.
+ * @param origin  Low edge of cell 0.
+ * @param cells   Number of cells along the axis.
+ * @param first   Receives the first cell.
+ * @param last    Receives the last cell.
+ * @return false if the span misses every cell.
+ */
+static bool cellSpan(float low, float high, float origin, std::uint32_t cells,
+                     std::uint32_t& first, std::uint32_t& last)
+{
+    // Clamp in floating point so spans far outside the grid cannot overflow
+    // the conversion.
+    const float lowCell  = std::floor((low  - origin) / Level::CELL_SIZE);
+    const float highCell = std::floor((high - origin) / Level::CELL_SIZE);
+    const float maxCell  = static_cast<float>(cells - 1);
+
+    if (cells == 0 || highCell < 0.0f || lowCell > maxCell)
+        return false;
+
+    first = static_cast<std::uint32_t>(std::max(lowCell, 0.0f));
+    last  = static_cast<std::uint32_t>(std::min(highCell, maxCell));
+    return true;
+}
+
+// =============================================================================
+// Construction
+// =============================================================================
+
+Level::Level()
+    : fieldTop(0.0f)
+    , gridLeft(0.0f)
+    , gridTop(0.0f)
+    , gridColumns(0)
+    , gridRows(0)
+    , cellStart(1, 0)
+    , initialBrickHash(0)
+    , explosiveCount(0)
+{
+}
+
+Level Level::builtIn(int number)
+{
+    namespace Baked = BuiltInLevels;
+
+    const int clamped = std::min(std::max(number, 1), Constants::MAX_LEVELS);
+    const std::array<Brick, Baked::BRICK_COUNT>& layout = Baked::LEVELS[static_cast<std::size_t>(clamped - 1)];
+
+    // Laid out and indexed at compile time: copy the tables in, as a
+    // compiled level file is loaded.
+    Level level;
+    level.gridLeft    = Baked::GRID.left;
+    level.gridTop     = Baked::GRID.top;
+    level.gridColumns = Baked::GRID.columns;
+    level.gridRows    = Baked::GRID.rows;
+    level.bricks.resize(layout.size());
+    level.cellStart.resize(Baked::CELL_START.size());
+    level.cellBricks.resize(Baked::CELL_BRICKS.size());
+
+    std::memcpy(level.bricks.data(), layout.data(), sizeof(layout));
+    std::memcpy(level.cellStart.data(), Baked::CELL_START.data(), sizeof(Baked::CELL_START));
+    std::memcpy(level.cellBricks.data(), Baked::CELL_BRICKS.data(), sizeof(Baked::CELL_BRICKS));
+
+    level.buildBlastTargets();
+    level.buildInitialState();
+    return level;
+}
+
+void Level::setBricks(std::vector<Brick> layout, std::vector<BrickPath> motion)
+{
+    bricks = std::move(layout);
+    paths  = std::move(motion);
+    buildIndex();
+    buildBlastTargets();
+    buildInitialState();
+}
+
+const std::vector<Brick>& Level::getBricks() const
+{
+    return bricks;
+}
+
+const std::vector<BrickPath>& Level::getPaths() const
+{
+    return paths;
+}
+
+float Level::getTop() const
+{
+    return fieldTop;
+}
+
+void Level::setTop(float edge)
+{
+    fieldTop = std::min(edge, 0.0f);
+}
+
+const std::vector<std::uint8_t>& Level::getInitialHitPoints() const
+{
+    return initialHitPoints;
+}
+
+std::uint64_t Level::getInitialBrickHash() const
+{
+    return initialBrickHash;
+}
+
+std::size_t Level::getExplosiveCount() const
+{
+    return explosiveCount;
+}
+
+std::size_t Level::getIndexSize() const
+{
+    return cellBricks.size();
+}
+
+void Level::buildInitialState()
+{
+    // Done once per level, wherever it is loaded, so starting it in the
+    // simulation is a copy and an assignment.
+    initialHitPoints.resize(bricks.size());
+    initialBrickHash = 0;
+    explosiveCount   = 0;
+    for (std::size_t i = 0; i < bricks.size(); ++i)
+    {
+        initialHitPoints[i] = bricks[i].hitPoints;
+        initialBrickHash ^= brickStateKey(i, bricks[i].hitPoints);
+        if (bricks[i].type == BrickType::Explosive)
+            ++explosiveCount;
+    }
+}
+
+// =============================================================================
+// Collision index
+// =============================================================================
+
+void Level::buildIndex()
+{
+    gridLeft    = 0.0f;
+    gridTop     = 0.0f;
+    gridColumns = 0;
+    gridRows    = 0;
+    cellStart.assign(1, 0);
+    cellBricks.clear();
+
+    // Moving bricks are indexed by the simulation as they move.
+    std::vector<bool> moving(bricks.size(), false);
+    for (const BrickPath& path : paths)
+        moving[path.brick] = true;
+
+    if (paths.size() == bricks.size())
+        return;
+
+    // The grid covers the union of every other brick's collision bounds.
+    float left   =  std::numeric_limits<float>::max();
+    float top    =  std::numeric_limits<float>::max();
+    float right  = -std::numeric_limits<float>::max();
+    float bottom = -std::numeric_limits<float>::max();
+    for (std::size_t i = 0; i < bricks.size(); ++i)
+    {
+        if (moving[i])
+            continue;
+        sf::FloatRect bounds = bricks[i].getBounds();
+        left   = std::min(left,   bounds.left);
+        top    = std::min(top,    bounds.top);
+        right  = std::max(right,  bounds.left + bounds.width);
+        bottom = std::max(bottom, bounds.top  + bounds.height);
+    }
+
+    gridLeft    = left;
+    gridTop     = top;
+    gridColumns = static_cast<std::uint32_t>((right  - left) / CELL_SIZE) + 1;
+    gridRows    = static_cast<std::uint32_t>((bottom - top)  / CELL_SIZE) + 1;
+
+    // Counting sort by cell: count each cell's entries, turn the counts into
+    // start offsets, then drop every brick into the cells it spans.  Bricks
+    // are visited in order, so each cell lists its bricks ascending.
+    const std::size_t cells = static_cast<std::size_t>(gridColumns) * gridRows;
+    cellStart.assign(cells + 1, 0);
+
+    auto forEachCell = [this](const Brick& brick, auto&& visit)
+    {
+        sf::FloatRect bounds = brick.getBounds();
+        std::uint32_t column0, column1, row0, row1;
+        if (!cellSpan(bounds.left, bounds.left + bounds.width, gridLeft, gridColumns, column0, column1) ||
+            !cellSpan(bounds.top,  bounds.top + bounds.height, gridTop,  gridRows,    row0,    row1))
+            return;
+        for (std::uint32_t row = row0; row <= row1; ++row)
+            for (std::uint32_t column = column0; column <= column1; ++column)
+                visit(static_cast<std::size_t>(row) * gridColumns + column);
+    };
+
+    for (std::size_t i = 0; i < bricks.size(); ++i)
+    {
+        if (!moving[i])
+            forEachCell(bricks[i], [this](std::size_t cell) { ++cellStart[cell + 1]; });
+    }
+
+    for (std::size_t cell = 0; cell < cells; ++cell)
+        cellStart[cell + 1] += cellStart[cell];
+
+    cellBricks.resize(cellStart.back());
+    std::vector<std::uint32_t> next(cellStart.begin(), cellStart.end() - 1);
+    for (std::size_t i = 0; i < bricks.size(); ++i)
+    {
+        if (moving[i])
+            continue;
+        forEachCell(bricks[i], [&](std::size_t cell)
+        {
+            cellBricks[next[cell]++] = static_cast<std::uint32_t>(i);
+        });
+    }
+}
+
+void Level::findBricks(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const
+{
+    out.clear();
+
+    std::uint32_t column0, column1, row0, row1;
+    if (!cellSpan(area.left, area.left + area.width,  gridLeft, gridColumns, column0, column1) ||
+        !cellSpan(area.top,  area.top  + area.height, gridTop,  gridRows,    row0,    row1))
+        return;
+
+    for (std::uint32_t row = row0; row <= row1; ++row)
+    {
+        for (std::uint32_t column = column0; column <= column1; ++column)
+        {
+            const std::size_t cell = static_cast<std::size_t>(row) * gridColumns + column;
+            out.insert(out.end(), cellBricks.begin() + cellStart[cell],
+                                  cellBricks.begin() + cellStart[cell + 1]);
+        }
+    }
+
+    // A brick spanning several queried cells is listed once per cell.
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void Level::cullBricks(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const
+{
+    out.clear();
+
+    std::uint32_t column0, column1, row0, row1;
+    if (!cellSpan(area.left, area.left + area.width,  gridLeft, gridColumns, column0, column1) ||
+        !cellSpan(area.top,  area.top  + area.height, gridTop,  gridRows,    row0,    row1))
+        return;
+
+    if (column0 == 0 && row0 == 0 && column1 + 1 == gridColumns && row1 + 1 == gridRows)
+    {
+        // Every brick the index holds: all but the moving ones.
+        out.resize(bricks.size() - paths.size());
+        auto path = paths.begin();
+        for (std::uint32_t i = 0, listed = 0; listed < out.size(); ++i)
+        {
+            if (path != paths.end() && path->brick == i)
+                ++path;
+            else
+                out[listed++] = i;
+        }
+        return;
+    }
+
+    for (std::uint32_t row = row0; row <= row1; ++row)
+    {
+        for (std::uint32_t column = column0; column <= column1; ++column)
+        {
+            const std::size_t cell = static_cast<std::size_t>(row) * gridColumns + column;
+            for (std::uint32_t entry = cellStart[cell]; entry < cellStart[cell + 1]; ++entry)
+            {
+                // List a brick only from the first of its cells the area
+                // covers; the grid was built from the same spans.
+                const std::uint32_t index  = cellBricks[entry];
+                sf::FloatRect       bounds = bricks[index].getBounds();
+                std::uint32_t brickColumn, lastColumn, brickRow, lastRow;
+                cellSpan(bounds.left, bounds.left + bounds.width,  gridLeft, gridColumns, brickColumn, lastColumn);
+                cellSpan(bounds.top,  bounds.top  + bounds.height, gridTop,  gridRows,    brickRow,    lastRow);
+                if (std::max(brickColumn, column0) == column && std::max(brickRow, row0) == row)
+                    out.push_back(index);
+            }
+        }
+    }
+}
+
+void Level::findOverlapping(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const
+{
+    out.clear();
+
+    const float right  = area.left + area.width;
+    const float bottom = area.top  + area.height;
+
+    std::uint32_t column0, column1, row0, row1;
+    if (!cellSpan(area.left, right,  gridLeft, gridColumns, column0, column1) ||
+        !cellSpan(area.top,  bottom, gridTop,  gridRows,    row0,    row1))
+        return;
+
+    for (std::uint32_t row = row0; row <= row1; ++row)
+    {
+        for (std::uint32_t column = column0; column <= column1; ++column)
+        {
+            const std::size_t cell = static_cast<std::size_t>(row) * gridColumns + column;
+            for (std::uint32_t entry = cellStart[cell]; entry < cellStart[cell + 1]; ++entry)
+            {
+                // Brick::getBounds() written out, as this loop is hot.
+                const std::uint32_t index = cellBricks[entry];
+                const Brick&        brick = bricks[index];
+                if (brick.x - Brick::OUTLINE_THICKNESS < right &&
+                    brick.x + brick.width + Brick::OUTLINE_THICKNESS > area.left &&
+                    brick.y - Brick::OUTLINE_THICKNESS < bottom &&
+                    brick.y + brick.height + Brick::OUTLINE_THICKNESS > area.top)
+                    out.push_back(index);
+            }
+        }
+    }
+
+    // A brick spanning several queried cells is listed once per cell.
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+const std::uint32_t* Level::getBlastTargets(std::uint32_t index, std::size_t& count) const
+{
+    if (blastStart.empty())
+    {
+        count = 0;
+        return nullptr;
+    }
+    count = blastStart[index + 1] - blastStart[index];
+    return blastTargets.data() + blastStart[index];
+}
+
+void Level::buildBlastTargets()
+{
+    blastStart.clear();
+    blastTargets.clear();
+
+    const bool explosive = std::any_of(bricks.begin(), bricks.end(), [](const Brick& brick)
+    {
+        return brick.type == BrickType::Explosive;
+    });
+    if (!explosive)
+        return;
+
+    // Done once per level, on whichever thread loads it, so detonating a
+    // whole screen of explosive bricks in one tick is a walk over lists.
+    blastStart.reserve(bricks.size() + 1);
+    blastStart.push_back(0);
+    std::vector<std::uint32_t> found;
+    auto path = paths.begin();
+    for (std::size_t i = 0; i < bricks.size(); ++i)
+    {
+        // Moving bricks explode wherever they happen to be.
+        const bool moves = path != paths.end() && path->brick == i;
+        if (moves)
+            ++path;
+        else if (bricks[i].type == BrickType::Explosive)
+        {
+            findOverlapping(bricks[i].getBlastBounds(), found);
+            for (std::uint32_t target : found)
+                if (target != i)
+                    blastTargets.push_back(target);
+        }
+        blastStart.push_back(static_cast<std::uint32_t>(blastTargets.size()));
+    }
+}
+
+// =============================================================================
+// Level sources
+// =============================================================================
+
+/**
+ * @brief Parses a colour of the form #RRGGBB or #RRGGBBAA.
+ * @param text   Colour text.
+ * @param color  Receives 0xRRGGBBAA.
+ * @return true if @p text is a valid colour.
+ */
+static bool parseColor(const std::string& text, std::uint32_t& color)
+{
+    if ((text.size() != 7 && text.size() != 9) || text[0] != '#')
+        return false;
+
+    std::uint32_t value = 0;
+    for (std::size_t i = 1; i < text.size(); ++i)
+    {
+        const char c = text[i];
+        std::uint32_t digit;
+        if (c >= '0' && c <= '9')
+            digit = static_cast<std::uint32_t>(c - '0');
+        else if (c >= 'a' && c <= 'f')
+            digit = static_cast<std::uint32_t>(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F')
+            digit = static_cast<std::uint32_t>(c - 'A' + 10);
+        else
+            return false;
+        value = (value << 4) | digit;
+    }
+
+    // Colours without alpha are opaque.
+    color = (text.size() == 7) ? (value << 8) | 0xFFu : value;
+    return true;
+}
+
+/**
+ * @brief A brick as a `brick` or `legend` statement declares it.
+ */
+struct BrickKind
+{
+    Brick     brick;  ///< The record.
+    BrickPath path;   ///< How it moves; a period of 0 if it does not.
+};
+
+/**
+ * @brief Checks that a brick read from a source is playable.
+ * @param kind         Brick to check, in source coordinates.
+ * @param fieldHeight  Height of the playfield.
+ * @param error        Receives the problem on failure.
+ * @return true if the brick is valid.
+ */
+static bool checkBrick(const BrickKind& kind, float fieldHeight, std::string& error)
+{
+    const Brick& brick = kind.brick;
+    if (!std::isfinite(brick.x) || !std::isfinite(brick.y) ||
+        !std::isfinite(brick.width) || !std::isfinite(brick.height))
+    {
+        error = "brick position and size must be numbers";
+        return false;
+    }
+    if (brick.width <= 0.0f || brick.height <= 0.0f)
+    {
+        error = "brick width and height must be positive";
+        return false;
+    }
+
+    // A moving brick must stay inside at either end of its reach.
+    const bool  moves  = kind.path.period != 0;
+    const float reachX = moves ? std::abs(kind.path.dx) : 0.0f;
+    const float reachY = moves ? std::abs(kind.path.dy) : 0.0f;
+    if (brick.x - reachX < 0.0f || brick.x + brick.width + reachX > static_cast<float>(Constants::WINDOW_WIDTH) ||
+        brick.y - reachY < 0.0f || brick.y + brick.height + reachY > fieldHeight)
+    {
+        error = moves ? "brick's path leaves the playfield" : "brick lies outside the playfield";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads the rest of a `move` or `orbit` option into @p path.
+ * @param line   Stream positioned after the option's name.
+ * @param shape  Shape the option names.
+ * @param path   Receives the path, except its brick.
+ * @param error  Receives the problem on failure.
+ * @return true on success.
+ */
+static bool readPath(std::istringstream& line, PathShape shape, BrickPath& path, std::string& error)
+{
+    const char* name = (shape == PathShape::Orbit) ? "orbit" : "move";
+    if (path.period != 0)
+    {
+        error = "a brick can only have one move or orbit";
+        return false;
+    }
+
+    float dx, dy, seconds;
+    if (!(line >> dx >> dy >> seconds))
+    {
+        error = std::string("expected ") + name + " <dx> <dy> <seconds> [<phase>]";
+        return false;
+    }
+
+    // The phase is optional: if the next word is not a number, it is the
+    // next option.
+    float                phase = 0.0f;
+    const std::streampos next  = line.tellg();
+    if (!(line >> phase))
+    {
+        line.clear();
+        line.seekg(next);
+        phase = 0.0f;
+    }
+
+    if (!std::isfinite(dx) || !std::isfinite(dy))
+    {
+        error = std::string(name) + " distances must be numbers";
+        return false;
+    }
+    if (!(seconds > 0.0f) || seconds > MAX_PATH_SECONDS)
+    {
+        error = std::string(name) + " cycle must be longer than 0 and at most " +
+                std::to_string(static_cast<int>(MAX_PATH_SECONDS)) + " seconds";
+        return false;
+    }
+    if (!(phase >= 0.0f && phase <= 1.0f))
+    {
+        error = std::string(name) + " phase must be from 0 to 1";
+        return false;
+    }
+
+    const float ticks = std::round(seconds * static_cast<float>(Constants::TICK_RATE));
+    path.dx     = dx;
+    path.dy     = dy;
+    path.shape  = shape;
+    path.period = static_cast<std::uint32_t>(std::max(ticks, 1.0f));
+    path.phase  = static_cast<std::uint32_t>(std::round(phase * static_cast<float>(path.period))) % path.period;
+
+    if (path.getTopSpeed() > MAX_BRICK_SPEED)
+    {
+        error = std::string(name) + " is faster than " + std::to_string(static_cast<int>(MAX_BRICK_SPEED)) +
+                " pixels per second (lengthen the cycle or shorten the distances)";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads the hit points, points, colour and options shared by
+ *        `brick` and `legend` statements, up to the end of the line.
+ * @param line   Stream positioned at the hit points.
+ * @param kind   Receives the values.
+ * @param error  Receives the problem on failure.
+ * @return true on success.
+ */
+static bool readBrickKind(std::istringstream& line, BrickKind& kind, std::string& error)
+{
+    Brick&      brick = kind.brick;
+    int         hitPoints;
+    int         points;
+    std::string color;
+    if (!(line >> hitPoints >> points >> color))
+    {
+        error = "expected <hit points> <points> <colour>";
+        return false;
+    }
+    if (hitPoints < 1 || hitPoints > 255)
+    {
+        error = "hit points must be between 1 and 255";
+        return false;
+    }
+    if (!parseColor(color, brick.color))
+    {
+        error = "bad colour \"" + color + "\" (expected #RRGGBB or #RRGGBBAA)";
+        return false;
+    }
+    brick.hitPoints = static_cast<std::uint8_t>(hitPoints);
+    brick.points    = points;
+
+    std::string option;
+    while (line >> option)
+    {
+        if (option == "explosive")
+            brick.type = BrickType::Explosive;
+        else if (option == "move" || option == "orbit")
+        {
+            const PathShape shape = (option == "orbit") ? PathShape::Orbit : PathShape::Slide;
+            if (!readPath(line, shape, kind.path, error))
+                return false;
+        }
+        else
+        {
+            error = "unknown brick option \"" + option + "\" (expected explosive, move or orbit)";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Level::parse(const std::string& source, Level& out, std::string& error)
+{
+    std::vector<Brick>        layout;
+    std::vector<BrickPath>    motion;
+    std::map<char, BrickKind> legend;
+
+    // Sources measure from the top of the playfield; the world keeps its
+    // bottom at the bottom of the window.
+    float fieldHeight = static_cast<float>(Constants::WINDOW_HEIGHT);
+    bool  placed      = false;
+    auto  place = [&](BrickKind kind)
+    {
+        if (!checkBrick(kind, fieldHeight, error))
+            return false;
+        kind.brick.y += static_cast<float>(Constants::WINDOW_HEIGHT) - fieldHeight;
+        if (kind.path.period != 0)
+        {
+            kind.path.brick = static_cast<std::uint32_t>(layout.size());
+            motion.push_back(kind.path);
+        }
+        layout.push_back(kind.brick);
+        placed = true;
+        return true;
+    };
+
+    // Active grid statement, if any.
+    bool  inGrid = false;
+    float gridX = 0.0f, gridY = 0.0f, cellWidth = 0.0f, cellHeight = 0.0f, gap = 0.0f;
+    int   gridRow = 0;
+
+    std::istringstream lines(source);
+    std::string        text;
+    int                lineNumber = 0;
+
+    auto fail = [&](const std::string& problem)
+    {
+        error = "line " + std::to_string(lineNumber) + ": " + problem;
+        return false;
+    };
+
+    while (std::getline(lines, text))
+    {
+        ++lineNumber;
+
+        // '#' followed by a blank or the end of the line starts a comment;
+        // colours never contain one.
+        for (std::size_t hash = text.find('#'); hash != std::string::npos;
+             hash = text.find('#', hash + 1))
+        {
+            if (hash + 1 == text.size() || std::isspace(static_cast<unsigned char>(text[hash + 1])))
+            {
+                text.erase(hash);
+                break;
+            }
+        }
+
+        std::istringstream line(text);
+        std::string        keyword;
+        if (!(line >> keyword))
+            continue;
+
+        if (inGrid)
+        {
+            if (keyword == "end")
+            {
+                inGrid = false;
+                continue;
+            }
+
+            // Every non-blank character is a cell; '.' leaves it empty.
+            int column = 0;
+            for (char symbol : text)
+            {
+                if (std::isspace(static_cast<unsigned char>(symbol)))
+                    continue;
+                if (symbol != '.')
+                {
+                    auto kind = legend.find(symbol);
+                    if (kind == legend.end())
+                        return fail(std::string("symbol '") + symbol + "' has no legend");
+
+                    BrickKind cell    = kind->second;
+                    cell.brick.x      = gridX + static_cast<float>(column) * (cellWidth + gap);
+                    cell.brick.y      = gridY + static_cast<float>(gridRow) * (cellHeight + gap);
+                    cell.brick.width  = cellWidth;
+                    cell.brick.height = cellHeight;
+                    if (!place(cell))
+                        return fail(error);
+                }
+                ++column;
+            }
+            ++gridRow;
+            continue;
+        }
+        else if (keyword == "brick")
+        {
+            BrickKind kind = {};
+            Brick&    brick = kind.brick;
+            if (!(line >> brick.x >> brick.y >> brick.width >> brick.height))
+                return fail("expected brick <x> <y> <width> <height> <hit points> <points> <colour> [options]");
+            if (!readBrickKind(line, kind, error) || !place(kind))
+                return fail(error);
+        }
+        else if (keyword == "legend")
+        {
+            std::string symbol;
+            BrickKind   kind = {};
+            if (!(line >> symbol) || symbol.size() != 1 || symbol == "." || symbol == "#")
+                return fail("expected legend <symbol> <hit points> <points> <colour> [options], "
+                            "with a one-character symbol other than '.' and '#'");
+            if (!readBrickKind(line, kind, error))
+                return fail(error);
+            legend[symbol[0]] = kind;
+        }
+        else if (keyword == "grid")
+        {
+            if (!(line >> gridX >> gridY >> cellWidth >> cellHeight >> gap))
+                return fail("expected grid <x> <y> <cell width> <cell height> <gap>");
+            if (!std::isfinite(gap) || gap < 0.0f)
+                return fail("grid gap must be a non-negative number");
+            inGrid  = true;
+            gridRow = 0;
+        }
+        else if (keyword == "height")
+        {
+            if (placed)
+                return fail("height must come before the first brick");
+            if (!(line >> fieldHeight) || !std::isfinite(fieldHeight) ||
+                fieldHeight < static_cast<float>(Constants::WINDOW_HEIGHT) || fieldHeight > MAX_FIELD_HEIGHT)
+                return fail("expected height <pixels>, from " + std::to_string(Constants::WINDOW_HEIGHT) +
+                            " to " + std::to_string(static_cast<long>(MAX_FIELD_HEIGHT)));
+        }
+        else
+        {
+            return fail("unknown statement \"" + keyword + "\"");
+        }
+
+        std::string extra;
+        if (line >> extra)
+            return fail("unexpected \"" + extra + "\"");
+
+        if (layout.size() > MAX_LEVEL_BRICKS)
+            return fail("level has more than " + std::to_string(MAX_LEVEL_BRICKS) + " bricks");
+    }
+
+    if (inGrid)
+        return fail("grid is missing its \"end\"");
+    if (layout.empty())
+    {
+        error = "level has no bricks";
+        return false;
+    }
+
+    Level level;
+    level.setBricks(std::move(layout), std::move(motion));
+    level.setTop(static_cast<float>(Constants::WINDOW_HEIGHT) - fieldHeight);
+    out = std::move(level);
+    return true;
+}
+
+// =============================================================================
+// Compiled level files
+// =============================================================================
+
+bool Level::readImage(const std::uint8_t* data, std::size_t size, Level& out, std::string& error)
+{
+    Header header;
+    if (size < sizeof(Header))
+    {
+        error = "not a level file";
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(Header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        error = "not a level file";
+        return false;
+    }
+    if (header.version != FORMAT_VERSION || header.brickBytes != sizeof(Brick))
+    {
+        error = "compiled by an incompatible version of the game (recompile the source)";
+        return false;
+    }
+
+    // The grid is empty only when every brick moves.
+    const bool gridEmpty = header.gridColumns == 0 || header.gridRows == 0;
+    if (header.brickCount == 0 || header.brickCount > MAX_LEVEL_BRICKS || header.pathCount > header.brickCount ||
+        gridEmpty != (header.pathCount == header.brickCount) ||
+        !std::isfinite(header.gridLeft) || !std::isfinite(header.gridTop) ||
+        !std::isfinite(header.fieldTop) || header.fieldTop > 0.0f)
+    {
+        error = "invalid header";
+        return false;
+    }
+
+    // Computed in 64 bits: the header is not trusted yet.
+    const std::uint64_t cells      = static_cast<std::uint64_t>(header.gridColumns) * header.gridRows;
+    const std::uint64_t brickBytes = static_cast<std::uint64_t>(header.brickCount) * sizeof(Brick);
+    const std::uint64_t startBytes = (cells + 1) * sizeof(std::uint32_t);
+    const std::uint64_t entryBytes = static_cast<std::uint64_t>(header.cellEntries) * sizeof(std::uint32_t);
+    const std::uint64_t pathBytes  = static_cast<std::uint64_t>(header.pathCount) * sizeof(BrickPath);
+    if (size != sizeof(Header) + brickBytes + startBytes + entryBytes + pathBytes)
+    {
+        error = "file size does not match its header (truncated level)";
+        return false;
+    }
+
+    const std::uint8_t* body = data + sizeof(Header);
+    if (fnv1a(body, size - sizeof(Header)) != header.checksum)
+    {
+        error = "checksum mismatch (file is corrupt)";
+        return false;
+    }
+
+    Level level;
+    level.fieldTop    = header.fieldTop;
+    level.gridLeft    = header.gridLeft;
+    level.gridTop     = header.gridTop;
+    level.gridColumns = header.gridColumns;
+    level.gridRows    = header.gridRows;
+    level.bricks.resize(header.brickCount);
+    level.cellStart.resize(static_cast<std::size_t>(cells) + 1);
+    level.cellBricks.resize(header.cellEntries);
+    level.paths.resize(header.pathCount);
+
+    std::memcpy(level.bricks.data(), body, brickBytes);
+    std::memcpy(level.cellStart.data(), body + brickBytes, startBytes);
+    std::memcpy(level.cellBricks.data(), body + brickBytes + startBytes, entryBytes);
+    if (pathBytes != 0)
+        std::memcpy(level.paths.data(), body + brickBytes + startBytes + entryBytes, pathBytes);
+
+    // The checksum catches damage, not a hand-made file; queries index
+    // with these, so they are bounds-checked before use.
+    bool indexValid = level.cellStart.front() == 0 && level.cellStart.back() == header.cellEntries;
+    for (std::size_t cell = 0; indexValid && cell < cells; ++cell)
+        indexValid = level.cellStart[cell] <= level.cellStart[cell + 1];
+    for (std::size_t i = 0; indexValid && i < level.cellBricks.size(); ++i)
+        indexValid = level.cellBricks[i] < header.brickCount;
+    if (!indexValid)
+    {
+        error = "invalid collision index";
+        return false;
+    }
+    for (const Brick& brick : level.bricks)
+    {
+        if (brick.type >= BrickType::Count)
+        {
+            error = "invalid brick type";
+            return false;
+        }
+        // Every brick counts towards bricksRemaining, so a brick that starts
+        // destroyed would leave the level unfinishable.
+        if (brick.hitPoints == 0)
+        {
+            error = "brick without hit points";
+            return false;
+        }
+        if (!std::isfinite(brick.x) || !std::isfinite(brick.y) ||
+            !(brick.width > 0.0f) || !(brick.height > 0.0f) ||
+            !std::isfinite(brick.width) || !std::isfinite(brick.height))
+        {
+            error = "invalid brick geometry";
+            return false;
+        }
+    }
+
+    // Paths name their bricks in ascending order, and getOffset() divides
+    // by the period.
+    for (std::size_t i = 0; i < level.paths.size(); ++i)
+    {
+        const BrickPath& path = level.paths[i];
+        if (path.brick >= header.brickCount || (i > 0 && path.brick <= level.paths[i - 1].brick) ||
+            path.shape >= PathShape::Count || path.period == 0 || path.phase >= path.period ||
+            !std::isfinite(path.dx) || !std::isfinite(path.dy))
+        {
+            error = "invalid brick path";
+            return false;
+        }
+    }
+
+    level.buildBlastTargets();
+    level.buildInitialState();
+    out = std::move(level);
+    return true;
+}
+
+bool Level::save(const std::string& path) const
+{
+    const std::size_t brickBytes = bricks.size() * sizeof(Brick);
+    const std::size_t startBytes = cellStart.size() * sizeof(std::uint32_t);
+    const std::size_t entryBytes = cellBricks.size() * sizeof(std::uint32_t);
+    const std::size_t pathBytes  = paths.size() * sizeof(BrickPath);
+
+    std::vector<std::uint8_t> image(sizeof(Header) + brickBytes + startBytes + entryBytes + pathBytes);
+    std::uint8_t* body = image.data() + sizeof(Header);
+    std::memcpy(body, bricks.data(), brickBytes);
+    std::memcpy(body + brickBytes, cellStart.data(), startBytes);
+    std::memcpy(body + brickBytes + startBytes, cellBricks.data(), entryBytes);
+    if (pathBytes != 0)
+        std::memcpy(body + brickBytes + startBytes + entryBytes, paths.data(), pathBytes);
+
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version     = FORMAT_VERSION;
+    header.brickBytes  = sizeof(Brick);
+    header.brickCount  = static_cast<std::uint32_t>(bricks.size());
+    header.fieldTop    = fieldTop;
+    header.gridLeft    = gridLeft;
+    header.gridTop     = gridTop;
+    header.gridColumns = gridColumns;
+    header.gridRows    = gridRows;
+    header.cellEntries = static_cast<std::uint32_t>(cellBricks.size());
+    header.pathCount   = static_cast<std::uint32_t>(paths.size());
+    header.checksum    = fnv1a(body, image.size() - sizeof(Header));
+    std::memcpy(image.data(), &header, sizeof(Header));
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(image.data()),
+               static_cast<std::streamsize>(image.size()));
+    if (!file)
+    {
+        std::cerr << "[Breakout] ERROR: Could not write level \"" << path << "\".\n";
+        return false;
+    }
+    return true;
+}
+
+bool Level::load(const std::string& path, Level& out)
+{
+    std::string error;
+    bool        ok = false;
+
+    if (std::filesystem::path(path).extension() == ".level")
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "[Breakout] ERROR: Could not open level \"" << path << "\".\n";
+            return false;
+        }
+        const std::string source((std::istreambuf_iterator<char>(file)),
+                                 std::istreambuf_iterator<char>());
+        ok = parse(source, out, error);
+    }
+    else
+    {
+#ifdef BREAKOUT_HAVE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            std::cerr << "[Breakout] ERROR: Could not open level \"" << path << "\".\n";
+            return false;
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size <= 0)
+        {
+            error = "not a level file";
+        }
+        else
+        {
+            std::size_t size    = static_cast<std::size_t>(info.st_size);
+            void*       mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED)
+            {
+                error = "could not map the file";
+            }
+            else
+            {
+                ok = readImage(static_cast<const std::uint8_t*>(mapping), size, out, error);
+                ::munmap(mapping, size);
+            }
+        }
+        ::close(fd);
+#else
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "[Breakout] ERROR: Could not open level \"" << path << "\".\n";
+            return false;
+        }
+        std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                                        std::istreambuf_iterator<char>());
+        ok = readImage(bytes.data(), bytes.size(), out, error);
+#endif
+    }
+
+    if (!ok)
+        std::cerr << "[Breakout] ERROR: Level \"" << path << "\": " << error << ".\n";
+    return ok;
+}
+
+// =============================================================================
+// LevelPack
+// =============================================================================
+
+std::shared_ptr<const LevelPack> LevelPack::builtIn()
+{
+    static const std::shared_ptr<const LevelPack> pack = []
+    {
+        auto campaign = std::make_shared<LevelPack>();
+        for (int number = 1; number <= Constants::MAX_LEVELS; ++number)
+            campaign->add(Level::builtIn(number));
+        campaign->setSource(makeSource("built-in"));
+        return campaign;
+    }();
+    return pack;
+}
+
+bool LevelPack::listDirectory(const std::string& directory, std::vector<std::string>& paths)
+{
+    namespace fs = std::filesystem;
+
+    // Level files by name without extension; a compiled file replaces a
+    // source of the same name.
+    std::map<std::string, fs::path> files;
+    std::error_code error;
+    for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+    {
+        const fs::path& path = it->path();
+        const fs::path  extension = path.extension();
+        if (extension != ".brkl" && extension != ".level")
+            continue;
+
+        auto inserted = files.emplace(path.stem().string(), path);
+        if (!inserted.second && extension == ".brkl")
+            inserted.first->second = path;
+    }
+    if (error)
+    {
+        std::cerr << "[Breakout] ERROR: Could not read level directory \"" << directory
+                  << "\": " << error.message() << ".\n";
+        return false;
+    }
+
+    paths.clear();
+    for (const auto& file : files)
+        paths.push_back(file.second.string());
+    return true;
+}
+
+bool LevelPack::loadDirectory(const std::string& directory, std::shared_ptr<LevelPack>& out)
+{
+    std::vector<std::string> files;
+    if (!listDirectory(directory, files))
+        return false;
+    if (files.empty())
+    {
+        std::cerr << "[Breakout] ERROR: No .brkl or .level files in \"" << directory << "\".\n";
+        return false;
+    }
+    // The directory is known by its level names rather than its path, so
+    // a copy elsewhere is still the same levels.
+    std::string names;
+    for (const std::string& path : files)
+        names += std::filesystem::path(path).filename().string() + '\n';
+
+    auto pack = std::make_shared<LevelPack>();
+    pack->setSource(makeSource("levels", names));
+    int  number = 0;
+    for (const std::string& path : files)
+    {
+        ++number;
+
+        // The first level is read now: a broken pack fails before anything
+        // is played, and the menu has a level to show.
+        if (number == 1)
+        {
+            Level first;
+            if (!Level::load(path, first))
+                return false;
+            pack->add(std::move(first));
+            continue;
+        }
+
+        pack->add([path, number]
+        {
+            Level level;
+            if (!Level::load(path, level))
+            {
+                // Already reported.  The file was listed when the pack was
+                // opened, so this is rare; a substitute keeps the game going.
+                const int substitute = std::min(number, Constants::MAX_LEVELS);
+                std::cerr << "[Breakout] WARNING: Playing built-in level " << substitute
+                          << " instead.\n";
+                level = Level::builtIn(substitute);
+            }
+            return level;
+        });
+    }
+
+    out = std::move(pack);
+    return true;
+}
+
+void LevelPack::add(Level level)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.push_back({ nullptr, std::make_shared<const Level>(std::move(level)), {} });
+}
+
+void LevelPack::add(std::function<Level()> build)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.push_back({ std::move(build), nullptr, {} });
+}
+
+void LevelPack::replace(int number, Level level)
+{
+    auto replacement = std::make_shared<const Level>(std::move(level));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (number < 1 || number > static_cast<int>(entries.size()))
+        return;
+
+    // A build still running is left to finish; getLevel() keeps this layout
+    // over its result.
+    Entry& entry = entries[static_cast<std::size_t>(number - 1)];
+    entry.build  = nullptr;
+    entry.level  = std::move(replacement);
+}
+
+int LevelPack::getLevelCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(entries.size());
+}
+
+std::uint32_t LevelPack::makeSource(const std::string& kind, const std::string& key)
+{
+    // The terminator keeps ("ab", "c") apart from ("a", "bc").
+    return fnv1a(key.data(), key.size(), fnv1a(kind.c_str(), kind.size() + 1));
+}
+
+void LevelPack::setSource(std::uint32_t id)
+{
+    source = id;
+}
+
+std::uint32_t LevelPack::getSource() const
+{
+    return source;
+}
+
+void LevelPack::setEndless(std::uint32_t seed)
+{
+    endless     = true;
+    endlessSeed = seed;
+}
+
+bool LevelPack::isEndless() const
+{
+    return endless;
+}
+
+std::uint32_t LevelPack::getEndlessSeed() const
+{
+    return endlessSeed;
+}
+
+void LevelPack::startBuild(Entry& entry, std::launch policy)
+{
+    // The future owns the builder from here on, so it runs at most once.
+    entry.loading = std::async(policy, [build = std::move(entry.build)]
+    {
+        return std::make_shared<const Level>(build());
+    }).share();
+    entry.build = nullptr;
+}
+
+void LevelPack::prefetch(int number) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (number < 1 || number > static_cast<int>(entries.size()))
+        return;
+
+    Entry& entry = entries[static_cast<std::size_t>(number - 1)];
+    if (entry.level || entry.loading.valid())
+        return;
+    startBuild(entry, std::launch::async);
+}
+
+std::shared_ptr<const Level> LevelPack::getLevel(int number) const
+{
+    std::shared_future<std::shared_ptr<const Level>> loading;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        number = std::max(1, std::min(number, static_cast<int>(entries.size())));
+
+        Entry& entry = entries[static_cast<std::size_t>(number - 1)];
+        if (entry.level)
+            return entry.level;
+
+        // Not prefetched: build it on this thread, through a deferred future
+        // so that concurrent callers wait for the one build.
+        if (!entry.loading.valid())
+            startBuild(entry, std::launch::deferred);
+        loading = entry.loading;
+    }
+
+    std::shared_ptr<const Level> level = loading.get();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry& entry = entries[static_cast<std::size_t>(number - 1)];
+    if (!entry.level)
+        entry.level = std::move(level);
+    entry.loading = {};
+    return entry.level;
+}
@@ -0,0 +1,482 @@
+/**
+ * @file Level.hpp
+ * @brief Level layouts: brick records, their spatial index, and level files.
+ *
+ * A Level is an immutable list of Brick records plus a uniform-grid index
+ * over them, so the ball only tests the bricks in the cells it overlaps,
+ * and the renderer only draws the bricks in view, no matter how many bricks
+ * the level has.  A level may also be taller than the window: its playfield
+ * then extends upwards from the usual one, to getTop(), and the view
+ * scrolls to follow the ball.  Bricks that move (getPaths()) are left out
+ * of the index, since where they are depends on the tick; the simulation
+ * indexes them as they move (see MovingBricks.hpp).  Levels come from
+ * three places:
+ *
+ *   - the built-in campaign (builtIn()), laid out and indexed at compile
+ *     time (see BuiltInLevels.hpp);
+ *   - level source files (`.level`), a line-based text format meant to be
+ *     written by hand (see parse());
+ *   - compiled level files (`.brkl`), produced from sources by
+ *     breakout_levelc and loaded with a single mmap.
+ *
+ * Compiled level files
+ * --------------------
+ * A fixed-layout binary image in native byte order, like save-states:
+ *
+ *   Level::FileHeader   magic "BRKL", format version, record size, brick
+ *                       and path counts, playfield top, index dimensions,
+ *                       FNV-1a checksum of everything after the header
+ *   bricks              brickCount Brick records, byte for byte
+ *   cell starts         (columns × rows + 1) uint32 offsets into the entries
+ *   cell entries        uint32 brick indices, grouped by cell
+ *   paths               pathCount BrickPath records, byte for byte
+ *
+ * The index is stored as built, so loading a level is a checksum pass,
+ * three memcpys and one pass over the bricks for their starting state
+ * (plus one index query per explosive brick, see getBlastTargets());
+ * nothing is parsed or rebuilt, and a level of a hundred thousand bricks
+ * loads in a few milliseconds.  Files are only
+ * portable between builds with the same Brick layout and byte order;
+ * anything else is rejected, and the source recompiled.
+ *
+ * A LevelPack is the ordered list of levels a game plays through.  Packs
+ * loaded from a directory read each level on first use (generated packs,
+ * see LevelGenerator.hpp, build them on first use), and the simulation
+ * asks for the next one while the "Level Complete" banner is up, so large
+ * levels load on a worker thread instead of stalling the transition.  An
+ * endless pack (LevelGenerator::endless()) instead streams generated rows
+ * through a single playfield for as long as the game lasts.  Each pack
+ * carries an identity of where its levels came from (getSource()), which
+ * save-states store so a game is only resumed on the levels it was saved
+ * on.
+ */
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Brick.hpp"
+
+/**
+ * @brief One level's bricks and their collision index.
+ */
+class Level
+{
+public:
+    /// Bump whenever Brick, BrickPath or FileHeader changes.
+    static constexpr std::uint32_t FORMAT_VERSION = 4;
+
+    /// Side of one index cell, in pixels.  About a third of a classic brick,
+    /// so the ball overlaps at most four cells.
+    static constexpr float CELL_SIZE = 32.0f;
+
+    /**
+     * @brief On-disk header of a compiled level file.
+     */
+    struct FileHeader
+    {
+        char          magic[4];     ///< "BRKL".
+        std::uint32_t version;      ///< FORMAT_VERSION of the writer.
+        std::uint32_t brickBytes;   ///< sizeof(Brick) of the writer.
+        std::uint32_t brickCount;   ///< Brick records after the header.
+        float         fieldTop;     ///< Level::getTop().
+        float         gridLeft;     ///< Left edge of index cell column 0.
+        float         gridTop;      ///< Top edge of index cell row 0.
+        std::uint32_t gridColumns;  ///< Index cells per row.
+        std::uint32_t gridRows;     ///< Index cell rows.
+        std::uint32_t cellEntries;  ///< Brick indices in the cell entries.
+        std::uint32_t pathCount;    ///< BrickPath records after the entries.
+        std::uint32_t checksum;     ///< FNV-1a of every byte after the header.
+    };
+
+    /// Creates a level with no bricks.
+    Level();
+
+    /**
+     * @brief Builds level @p number of the built-in campaign.
+     *
+     * BRICK_ROWS × BRICK_COLS bricks centred horizontally; rows closer to
+     * the top are worth more points, and every level beyond the first adds
+     * one hit point to every brick.  Copied from tables baked at compile
+     * time, so nothing is computed.
+     *
+     * @param number  Level number (1 … Constants::MAX_LEVELS; clamped).
+     * @return Level  The layout.
+     */
+    static Level builtIn(int number);
+
+    /**
+     * @brief Reads a level source.
+     *
+     * One statement per line; `#` followed by a blank starts a comment.
+     * Coordinates are pixels from the top-left of the playfield, colours
+     * `#RRGGBB` or `#RRGGBBAA`.
+     *
+     *     brick <x> <y> <width> <height> <hit points> <points> <colour> [options]
+     *
+     * places a single brick.  The options, in any order, are
+     *
+     *     explosive                          hits its neighbours when destroyed
+     *     move <dx> <dy> <seconds> [<phase>]  slides up to (dx, dy) either way
+     *     orbit <dx> <dy> <seconds> [<phase>] circles with radii dx and dy
+     *
+     * (see BrickType and BrickPath): a moving brick's position is the centre
+     * of its path, `seconds` the time of one cycle and `phase` how far into
+     * the cycle it starts, from 0 to 1.  For regular layouts, symbols
+     * declared with
+     *
+     *     legend <symbol> <hit points> <points> <colour> [options]
+     *
+     * are drawn as a grid: every line after `grid` up to `end` is a row of
+     * symbols, `.` leaving a cell empty.  Moving symbols of a grid move
+     * together.
+     *
+     *     grid <x> <y> <cell width> <cell height> <gap>
+     *
+     * Bricks must lie within the playfield along their whole path, and
+     * move no faster than the slowest ball; a level needs at least one
+     * brick.  The playfield is the window, 800 × 600, unless the source
+     * starts with
+     *
+     *     height <pixels>
+     *
+     * to make it taller; coordinates are still measured from its top-left
+     * corner, and the bottom of the playfield, where the paddle is, stays
+     * at the bottom of the window.
+     *
+     * @param source  Text of the level source.
+     * @param out     Receives the level on success.
+     * @param error   Receives "line N: problem" on failure.
+     * @return true on success.
+     */
+    static bool parse(const std::string& source, Level& out, std::string& error);
+
+    /**
+     * @brief Loads a compiled (`.brkl`) or source (`.level`) level file.
+     *
+     * Compiled files are memory-mapped and validated by their header,
+     * checksum, index bounds and brick records (a known type, at least one
+     * hit point, finite positive size); sources are parsed.
+     *
+     * @param path  Level file.
+     * @param out   Receives the level on success; untouched on failure.
+     * @return true on success; failures are reported to stderr.
+     */
+    static bool load(const std::string& path, Level& out);
+
+    /**
+     * @brief Writes the level as a compiled level file.
+     * @param path  Destination file.
+     * @return true on success; failures are reported to stderr.
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Replaces the bricks and rebuilds the index.
+     * @param layout  New bricks, in collision order.
+     * @param motion  Paths of the bricks that move, ascending by brick and
+     *                one per brick at most.
+     */
+    void setBricks(std::vector<Brick> layout, std::vector<BrickPath> motion = {});
+
+    /// @return Every brick, in collision order.
+    const std::vector<Brick>& getBricks() const;
+
+    /// @return Paths of the bricks that move, ascending by brick; these
+    ///         bricks are not in the index.
+    const std::vector<BrickPath>& getPaths() const;
+
+    /// @return Top edge of the playfield, in world coordinates: 0 for a
+    ///         level the height of the window, negative for a taller one.
+    float getTop() const;
+
+    /**
+     * @brief Sets the top edge of the playfield.
+     * @param edge  0, or negative to extend the playfield above the window.
+     */
+    void setTop(float edge);
+
+    /// @return Every brick's starting hit points, in collision order.
+    const std::vector<std::uint8_t>& getInitialHitPoints() const;
+
+    /// @return Simulation brick hash of the level at full health (see brickStateKey()).
+    std::uint64_t getInitialBrickHash() const;
+
+    /// @return Number of explosive bricks, moving ones included.
+    std::size_t getExplosiveCount() const;
+
+    /// @return Entries in the grid index: no query lists more bricks, even
+    ///         before duplicates are removed.
+    std::size_t getIndexSize() const;
+
+    /**
+     * @brief Lists the bricks whose collision bounds may touch @p area.
+     *
+     * Every brick that overlaps @p area is listed; a few nearby ones may
+     * be too.  Indices are ascending and unique, so testing them in order
+     * gives the same result as testing every brick in order.
+     *
+     * @param area  Region to query, world coordinates.
+     * @param out   Cleared, then receives the brick indices.
+     */
+    void findBricks(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const;
+
+    /**
+     * @brief Lists the bricks that may be visible in @p area, in no order.
+     *
+     * The same bricks as findBricks() but unsorted, each listed by the first
+     * of its cells inside @p area, so large areas cost no sort.  An area
+     * covering the whole level lists every brick without consulting the
+     * index.
+     *
+     * @param area  Region to query, world coordinates.
+     * @param out   Cleared, then receives the brick indices.
+     */
+    void cullBricks(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const;
+
+    /**
+     * @brief Lists exactly the bricks whose collision bounds overlap
+     *        @p area.
+     *
+     * Indices are ascending and unique.  Bricks are tested as they come out
+     * of the index and only the overlapping ones are sorted, so a small area
+     * costs a few comparisons per indexed brick nearby.
+     *
+     * @param area  Region to query, world coordinates.
+     * @param out   Cleared, then receives the brick indices.
+     */
+    void findOverlapping(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const;
+
+    /**
+     * @brief Lists the bricks an explosion of brick @p index hits: every
+     *        other brick whose collision bounds overlap its blast bounds
+     *        (Brick::getBlastBounds()).
+     *
+     * Worked out with the index when the level is built or loaded, so a
+     * chain of explosions costs no queries.  Empty unless the brick is
+     * explosive and stays put; moving bricks are neither listed nor given
+     * lists, as the simulation finds them where they are at the time.
+     *
+     * @param index  Brick index.
+     * @param count  Receives the number of targets.
+     * @return The first of @p count ascending brick indices.
+     */
+    const std::uint32_t* getBlastTargets(std::uint32_t index, std::size_t& count) const;
+
+private:
+    /// Builds the grid index from the bricks that do not move.
+    void buildIndex();
+
+    /// Fills initialHitPoints, initialBrickHash and explosiveCount from bricks.
+    void buildInitialState();
+
+    /// Fills blastStart and blastTargets from bricks and the index.
+    void buildBlastTargets();
+
+    /**
+     * @brief Checks a compiled level image and copies it into @p out.
+     * @param data   File contents.
+     * @param size   File size in bytes.
+     * @param out    Receives the level on success.
+     * @param error  Receives a description on failure.
+     * @return true if the image is a valid level of this layout.
+     */
+    static bool readImage(const std::uint8_t* data, std::size_t size,
+                          Level& out, std::string& error);
+
+    std::vector<Brick>         bricks;      ///< Layout, in collision order.
+    std::vector<BrickPath>     paths;       ///< Moving bricks, ascending by brick.
+    float                      fieldTop;    ///< Top edge of the playfield (≤ 0).
+
+    float                      gridLeft;    ///< Left edge of cell column 0.
+    float                      gridTop;     ///< Top edge of cell row 0.
+    std::uint32_t              gridColumns; ///< Cells per row (0 = no bricks).
+    std::uint32_t              gridRows;    ///< Cell rows.
+    std::vector<std::uint32_t> cellStart;   ///< Entries of cell c: [cellStart[c], cellStart[c + 1]).
+    std::vector<std::uint32_t> cellBricks;  ///< Brick indices, grouped by cell.
+
+    std::vector<std::uint32_t> blastStart;   ///< Targets of brick i: [blastStart[i], blastStart[i + 1]); empty without explosive bricks.
+    std::vector<std::uint32_t> blastTargets; ///< Bricks hit by each explosive brick, grouped by brick.
+
+    std::vector<std::uint8_t>  initialHitPoints; ///< bricks[i].hitPoints, ready to copy.
+    std::uint64_t              initialBrickHash; ///< Brick hash of initialHitPoints.
+    std::size_t                explosiveCount;   ///< Bricks of BrickType::Explosive.
+};
+
+/**
+ * @brief The ordered levels of one campaign.
+ *
+ * Levels are shared and immutable, so any number of simulations can play
+ * the same pack without copying it.  Levels can also be added as a
+ * function that builds them: a pack loaded from a directory holds one per
+ * file and reads each level the first time it is asked for, either in the
+ * background (prefetch()) or on the spot (getLevel()).  Every call is
+ * thread-safe.
+ */
+class LevelPack
+{
+public:
+    /**
+     * @brief Returns the built-in campaign of Constants::MAX_LEVELS levels.
+     * @return Shared pack, built on first use.
+     */
+    static std::shared_ptr<const LevelPack> builtIn();
+
+    /**
+     * @brief Loads every `.brkl` and `.level` file in @p directory.
+     *
+     * Levels are played in file-name order (name them 01, 02, …).  Where a
+     * compiled file and a source share a name, the compiled file is used.
+     * Only the first level is read here; the rest are read when the game
+     * reaches them.
+     *
+     * @param directory  Directory holding the level files.
+     * @param out        Receives the pack on success.
+     * @return true if the directory holds level files and the first one
+     *         loaded; failures are reported to stderr.
+     */
+    static bool loadDirectory(const std::string& directory, std::shared_ptr<LevelPack>& out);
+
+    /**
+     * @brief Lists the level files loadDirectory() would play, in order.
+     * @param directory  Directory holding the level files.
+     * @param paths      Receives the file paths; level n is paths[n - 1].
+     * @return true if the directory could be read; failures are reported
+     *         to stderr.  An empty directory is not a failure.
+     */
+    static bool listDirectory(const std::string& directory, std::vector<std::string>& paths);
+
+    /**
+     * @brief Appends a level to the campaign.
+     * @param level  Layout to append.
+     */
+    void add(Level level);
+
+    /**
+     * @brief Appends a level that is built the first time it is needed.
+     *
+     * @p build may run on a worker thread and runs at most once; it must
+     * always return the same layout, since every simulation of the pack
+     * relies on it.
+     *
+     * @param build  Function returning the layout.
+     */
+    void add(std::function<Level()> build);
+
+    /**
+     * @brief Replaces level @p number, for simulations that start it from
+     *        now on.
+     *
+     * Simulations already playing the level keep the layout they have
+     * (see Simulation::reloadLevel()).  Numbers outside the pack are
+     * ignored.
+     *
+     * @param number  Level number (1-based).
+     * @param level   New layout.
+     */
+    void replace(int number, Level level);
+
+    /// @return Number of levels.
+    int getLevelCount() const;
+
+    /**
+     * @brief Returns the identity of levels of kind @p kind told apart by
+     *        @p key, for setSource().
+     *
+     * The same kind and key always give the same identity, on every
+     * platform.
+     *
+     * @param kind  Where the levels come from: "built-in", "levels",
+     *              "generate" or "endless".
+     * @param key   What picks them: the file names of a directory, or a
+     *              seed.
+     */
+    static std::uint32_t makeSource(const std::string& kind, const std::string& key = std::string());
+
+    /**
+     * @brief Sets the identity of where the levels come from.
+     *
+     * Files that only store brick damage (save-states) record it, and are
+     * rejected by packs with another.  Call before the pack is shared.
+     *
+     * @param source  Identity from makeSource().
+     */
+    void setSource(std::uint32_t source);
+
+    /// @return Identity set by setSource(); 0 for a pack assembled by hand.
+    std::uint32_t getSource() const;
+
+    /**
+     * @brief Makes the pack an endless field of rows generated from
+     *        @p seed (see EndlessField.hpp).
+     *
+     * Simulations of an endless pack stream rows through the playfield of
+     * its first level instead of playing through the levels.  Call before
+     * the pack is shared.
+     *
+     * @param seed  Row seed.
+     */
+    void setEndless(std::uint32_t seed);
+
+    /// @return Whether the pack is an endless field.
+    bool isEndless() const;
+
+    /// @return Row seed of an endless pack.
+    std::uint32_t getEndlessSeed() const;
+
+    /**
+     * @brief Starts reading level @p number on a worker thread.
+     *
+     * Does nothing if the number is outside the pack, or the level is
+     * already read or being read.
+     *
+     * @param number  Level number (1-based).
+     */
+    void prefetch(int number) const;
+
+    /**
+     * @brief Returns level @p number, clamped to the pack.
+     *
+     * Waits for a prefetch of the level if one is running, and builds the
+     * level itself if none was started.  A level file that no longer loads
+     * is reported and replaced by the built-in level of the same number;
+     * the replacement is kept, so every simulation of the pack still sees
+     * the same layout.
+     *
+     * @param number  Level number (1-based).
+     */
+    std::shared_ptr<const Level> getLevel(int number) const;
+
+private:
+    /**
+     * @brief One level of the pack.
+     */
+    struct Entry
+    {
+        std::function<Level()>                           build;   ///< Builds the layout; empty once built.
+        std::shared_ptr<const Level>                     level;   ///< Layout, once built.
+        std::shared_future<std::shared_ptr<const Level>> loading; ///< Build in progress, if any.
+    };
+
+    /**
+     * @brief Starts building @p entry.  Call with mutex held.
+     * @param entry   Level to build; neither built nor being built.
+     * @param policy  std::launch::async for a worker thread,
+     *                std::launch::deferred for the first caller of get().
+     */
+    static void startBuild(Entry& entry, std::launch policy);
+
+    mutable std::mutex         mutex;   ///< Guards entries.
+    mutable std::vector<Entry> entries; ///< Levels in play order.
+
+    std::uint32_t source      = 0;      ///< Where the levels come from; see setSource().
+    bool          endless     = false;  ///< Rows stream in; see setEndless().
+    std::uint32_t endlessSeed = 0;      ///< Row seed when endless.
+};
@@ -0,0 +1,380 @@
+/**
+ * @file LevelGenerator.cpp
+ * @brief Implementation of LevelGenerator: noise, shapes and the tile pool.
+ */
+
+#include "LevelGenerator.hpp"
+#include "Hash.hpp"
+
+#include <algorithm>  // std::min, std::max
+#include <array>
+#include <atomic>
+#include <cmath>      // std::floor, std::sqrt, std::cos, std::fabs
+#include <cstring>    // std::memcpy
+#include <string>     // std::to_string
+#include <thread>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Tuning
+// -----------------------------------------------------------------------------
+
+/// Rows generated by one task.  Large enough that a task is worth handing
+/// out, small enough that a 1000-row field keeps every core busy.
+static constexpr std::uint32_t BAND_ROWS = 16;
+
+/// Size of the coarsest noise features, in pixels.
+static constexpr float NOISE_SCALE = 90.0f;
+
+/// Noise octaves; each doubles the frequency and halves the amplitude.
+static constexpr int NOISE_OCTAVES = 3;
+
+/// Share of the density field taken by the seed's shape; the rest is noise.
+static constexpr float SHAPE_WEIGHT = 0.45f;
+
+/// Score per hit point of a bottom-row brick; the top row is worth six times
+/// as much, as in the built-in levels.
+static constexpr int BASE_POINTS = 10;
+
+/// Endless rows between each rise in the toughest brick, up to six hit
+/// points, and in the score multiplier.
+static constexpr std::uint32_t ENDLESS_ROWS_PER_STEP = 40;
+
+/// Share of endless cells holding a brick.
+static constexpr float ENDLESS_DENSITY = 0.5f;
+
+/// Share of endless bricks that are explosive.
+static constexpr float ENDLESS_EXPLOSIVE = 0.04f;
+
+/// Colour by hit points, toughest last; tougher bricks reuse the last one.
+static const std::array<sf::Color, 6> HIT_POINT_COLORS = {{
+    sf::Color( 45, 185,  45),  // 1 – Green
+    sf::Color( 45, 110, 225),  // 2 – Blue
+    sf::Color(210, 200,  20),  // 3 – Yellow
+    sf::Color(230, 120,  20),  // 4 – Orange
+    sf::Color(220,  45,  45),  // 5 – Red
+    sf::Color(135,  45, 205),  // 6+ – Purple
+}};
+
+// -----------------------------------------------------------------------------
+// Noise
+// -----------------------------------------------------------------------------
+
+/// Large shapes the density field can be built around.
+enum class Shape : std::uint8_t
+{
+    Blobs,   ///< Noise only.
+    Rings,   ///< Concentric rings around the centre.
+    Diamond, ///< Filled towards the centre, thinning at the corners.
+    Stripes, ///< Parallel diagonal bands.
+    Arch,    ///< A bow bending down from the top corners.
+    Count
+};
+
+/**
+ * @brief Returns a value in [0, 1) for lattice point (@p x, @p y).
+ */
+static float latticeValue(std::uint64_t seed, std::int32_t x, std::int32_t y)
+{
+    const std::uint64_t point = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+                                static_cast<std::uint32_t>(y);
+    const std::uint64_t mixed = hashFold(point ^ HASH_SECRET[0], seed ^ HASH_SECRET[1]);
+    return static_cast<float>(mixed >> 40) * (1.0f / 16777216.0f);
+}
+
+/**
+ * @brief Smoothly interpolated value noise at (@p x, @p y), in [0, 1).
+ */
+static float valueNoise(std::uint64_t seed, float x, float y)
+{
+    const float cellX = std::floor(x);
+    const float cellY = std::floor(y);
+    const auto  x0    = static_cast<std::int32_t>(cellX);
+    const auto  y0    = static_cast<std::int32_t>(cellY);
+
+    // Smoothstep weights hide the lattice.
+    float fx = x - cellX;
+    float fy = y - cellY;
+    fx = fx * fx * (3.0f - 2.0f * fx);
+    fy = fy * fy * (3.0f - 2.0f * fy);
+
+    const float top    = latticeValue(seed, x0, y0)     + fx * (latticeValue(seed, x0 + 1, y0)     - latticeValue(seed, x0, y0));
+    const float bottom = latticeValue(seed, x0, y0 + 1) + fx * (latticeValue(seed, x0 + 1, y0 + 1) - latticeValue(seed, x0, y0 + 1));
+    return top + fy * (bottom - top);
+}
+
+/**
+ * @brief Fractal (multi-octave) value noise at pixel (@p x, @p y), in [0, 1).
+ */
+static float fractalNoise(std::uint64_t seed, float x, float y)
+{
+    float sum       = 0.0f;
+    float amplitude = 1.0f;
+    float total     = 0.0f;
+    float frequency = 1.0f / NOISE_SCALE;
+    for (int octave = 0; octave < NOISE_OCTAVES; ++octave)
+    {
+        sum       += amplitude * valueNoise(seed + static_cast<std::uint64_t>(octave), x * frequency, y * frequency);
+        total     += amplitude;
+        amplitude *= 0.5f;
+        frequency *= 2.0f;
+    }
+    return sum / total;
+}
+
+/**
+ * @brief Evaluates @p shape at (@p s, @p t), both in [-1, 1] across the area.
+ * @param shape  Shape to draw.
+ * @param twist  Seed-derived value in [0, 1) varying the shape's proportions.
+ * @return float  0 (empty) … 1 (full).
+ */
+static float shapeValue(Shape shape, float twist, float s, float t)
+{
+    switch (shape)
+    {
+        case Shape::Rings:
+        {
+            const float radius = std::sqrt(s * s + t * t);
+            return 0.5f + 0.5f * std::cos(radius * (6.0f + 8.0f * twist));
+        }
+        case Shape::Diamond:
+            return std::max(0.0f, 1.0f - 0.6f * (std::fabs(s) + std::fabs(t)));
+        case Shape::Stripes:
+            return 0.5f + 0.5f * std::cos((s + (twist - 0.5f) * 2.0f * t) * (5.0f + 6.0f * twist));
+        case Shape::Arch:
+        {
+            // Distance from the curve t = s² - 1 + twist, as a band.
+            const float distance = std::fabs(t - (s * s - 1.0f + twist));
+            return std::max(0.0f, 1.0f - 1.8f * distance);
+        }
+        case Shape::Blobs:
+        case Shape::Count:
+            break;
+    }
+    return 0.5f;
+}
+
+// -----------------------------------------------------------------------------
+// Generation
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Runs @p task(0 … count - 1) on up to @p threads threads.
+ */
+template <typename Task>
+static void runTasks(std::size_t count, unsigned threads, Task task)
+{
+    unsigned threadCount = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+    threadCount = static_cast<unsigned>(std::min<std::size_t>(threadCount, count));
+
+    std::atomic<std::size_t> next{ 0 };
+    auto worker = [&]()
+    {
+        for (std::size_t job = next++; job < count; job = next++)
+            task(job);
+    };
+
+    // The calling thread works too.
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threadCount; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (std::thread& thread : pool)
+        thread.join();
+}
+
+Level LevelGenerator::generate(const Settings& requested)
+{
+    Settings settings = requested;
+    settings.columns      = std::max<std::uint32_t>(settings.columns, 1);
+    settings.rows         = std::max<std::uint32_t>(settings.rows, 1);
+    settings.gap          = std::min(std::max(settings.gap, 0.0f), 0.9f);
+    settings.maxHitPoints = std::min(std::max(settings.maxHitPoints, 1), 255);
+
+    // Everything random about the layout follows from these.
+    const std::uint64_t densitySeed = hashFold(settings.seed ^ HASH_SECRET[2], HASH_SECRET[3]);
+    const std::uint64_t toughSeed   = hashFold(densitySeed ^ HASH_SECRET[0], HASH_SECRET[1]);
+    const std::uint64_t blastSeed   = hashFold(toughSeed ^ HASH_SECRET[2], HASH_SECRET[3]);
+    const Shape shape = static_cast<Shape>((densitySeed >> 32) % static_cast<std::uint64_t>(Shape::Count));
+    const float twist = static_cast<float>((densitySeed >> 8) & 0xFFFFu) / 65536.0f;
+
+    const float cellWidth   = settings.width  / static_cast<float>(settings.columns);
+    const float cellHeight  = settings.height / static_cast<float>(settings.rows);
+    const float brickWidth  = cellWidth  * (1.0f - settings.gap);
+    const float brickHeight = cellHeight * (1.0f - settings.gap);
+    const float threshold   = 1.0f - std::min(std::max(settings.density, 0.0f), 1.0f);
+    const bool  fill        = settings.density >= 1.0f;
+
+    const std::size_t bandCount = (settings.rows + BAND_ROWS - 1) / BAND_ROWS;
+    std::vector<std::vector<Brick>> bands(bandCount);
+
+    runTasks(bandCount, settings.threads, [&](std::size_t band)
+    {
+        const std::uint32_t firstRow = static_cast<std::uint32_t>(band) * BAND_ROWS;
+        const std::uint32_t lastRow  = std::min(firstRow + BAND_ROWS, settings.rows);
+        std::vector<Brick>& out = bands[band];
+
+        for (std::uint32_t row = firstRow; row < lastRow; ++row)
+        {
+            // Height in the area, 0 at the top, sampled at the cell centre.
+            const float height = (static_cast<float>(row) + 0.5f) / static_cast<float>(settings.rows);
+            const float y      = settings.top + static_cast<float>(row) * cellHeight;
+
+            for (std::uint32_t column = 0; column < settings.columns; ++column)
+            {
+                // Mirrored cells sample the left half, in pixels so that
+                // the picture does not depend on the grid resolution.
+                std::uint32_t sampled = column;
+                if (settings.mirror)
+                    sampled = std::min(column, settings.columns - 1 - column);
+                const float across = (static_cast<float>(sampled) + 0.5f) / static_cast<float>(settings.columns);
+                const float px     = across * settings.width;
+                const float py     = height * settings.height;
+
+                const float density = (1.0f - SHAPE_WEIGHT) * fractalNoise(densitySeed, px, py) +
+                                      SHAPE_WEIGHT * shapeValue(shape, twist, across * 2.0f - 1.0f,
+                                                                height * 2.0f - 1.0f);
+                if (!fill && density < threshold)
+                    continue;
+
+                // Tougher towards the top, like the built-in levels.
+                const float toughness = 0.6f * fractalNoise(toughSeed, px, py) + 0.4f * (1.0f - height);
+                const int   hitPoints = std::min(settings.maxHitPoints,
+                                                 1 + static_cast<int>(toughness * static_cast<float>(settings.maxHitPoints)));
+                const int   rowValue  = 1 + static_cast<int>((1.0f - height) * 6.0f);
+
+                Brick brick = {};
+                brick.x         = settings.left + static_cast<float>(column) * cellWidth + 0.5f * (cellWidth - brickWidth);
+                brick.y         = y + 0.5f * (cellHeight - brickHeight);
+                brick.width     = brickWidth;
+                brick.height    = brickHeight;
+                brick.hitPoints = static_cast<std::uint8_t>(hitPoints);
+                brick.points    = BASE_POINTS * std::min(rowValue, 6) * hitPoints;
+                brick.color     = HIT_POINT_COLORS[static_cast<std::size_t>(
+                                      std::min<int>(hitPoints, HIT_POINT_COLORS.size()) - 1)].toInteger();
+
+                // Per cell rather than per pixel: explosives are scattered,
+                // not clustered like the noise.
+                if (latticeValue(blastSeed, static_cast<std::int32_t>(sampled), static_cast<std::int32_t>(row)) <
+                    settings.explosive)
+                    brick.type = BrickType::Explosive;
+                out.push_back(brick);
+            }
+        }
+    });
+
+    // Stitch the bands together in row order, each copied by the pool.
+    std::vector<std::size_t> offsets(bandCount + 1, 0);
+    for (std::size_t band = 0; band < bandCount; ++band)
+        offsets[band + 1] = offsets[band] + bands[band].size();
+
+    if (offsets.back() == 0)
+    {
+        Settings full = settings;
+        full.density  = 1.0f;
+        return generate(full);
+    }
+
+    std::vector<Brick> bricks(offsets.back());
+    runTasks(bandCount, settings.threads, [&](std::size_t band)
+    {
+        if (!bands[band].empty())
+            std::memcpy(bricks.data() + offsets[band], bands[band].data(), bands[band].size() * sizeof(Brick));
+        std::vector<Brick>().swap(bands[band]);
+    });
+
+    // An area reaching above the window makes a tall level, with the usual
+    // margin above the bricks.
+    Level level;
+    level.setBricks(std::move(bricks));
+    level.setTop(settings.top - Constants::BRICK_TOP_OFFSET);
+    return level;
+}
+
+// -----------------------------------------------------------------------------
+// Campaigns
+// -----------------------------------------------------------------------------
+
+LevelGenerator::Settings LevelGenerator::forLevel(std::uint32_t seed, int number)
+{
+    number = std::max(1, number);
+
+    Settings settings;
+    settings.seed         = static_cast<std::uint32_t>(hashFold(seed ^ HASH_SECRET[1],
+                                                                static_cast<std::uint64_t>(number) ^ HASH_SECRET[2]));
+    settings.columns      = static_cast<std::uint32_t>(Constants::BRICK_COLS * (number + 1));
+    settings.rows         = static_cast<std::uint32_t>(Constants::BRICK_ROWS * (number + 1));
+    settings.maxHitPoints = std::min(number + 1, 6);
+    return settings;
+}
+
+std::shared_ptr<const LevelPack> LevelGenerator::campaign(std::uint32_t seed)
+{
+    auto pack = std::make_shared<LevelPack>();
+    for (int number = 1; number <= Constants::MAX_LEVELS; ++number)
+    {
+        const Settings settings = forLevel(seed, number);
+        pack->add([settings] { return generate(settings); });
+    }
+    pack->setSource(LevelPack::makeSource("generate", std::to_string(seed)));
+    return pack;
+}
+
+// -----------------------------------------------------------------------------
+// Endless rows
+// -----------------------------------------------------------------------------
+
+void LevelGenerator::generateRow(std::uint32_t seed, std::uint32_t row, Brick* out)
+{
+    const std::uint64_t densitySeed = hashFold(seed ^ HASH_SECRET[3], HASH_SECRET[2]);
+    const std::uint64_t toughSeed   = hashFold(densitySeed ^ HASH_SECRET[0], HASH_SECRET[1]);
+    const std::uint64_t blastSeed   = hashFold(toughSeed ^ HASH_SECRET[2], HASH_SECRET[3]);
+
+    constexpr std::uint32_t columns = Constants::BRICK_COLS;
+    constexpr float pitchX = Constants::BRICK_WIDTH  + Constants::BRICK_PADDING;
+    constexpr float pitchY = Constants::BRICK_HEIGHT + Constants::BRICK_PADDING;
+    constexpr float left   = (static_cast<float>(Constants::WINDOW_WIDTH) -
+                              (columns * pitchX - Constants::BRICK_PADDING)) * 0.5f;
+
+    const int step         = static_cast<int>(std::min<std::uint32_t>(row / ENDLESS_ROWS_PER_STEP, 5));
+    const int maxHitPoints = 1 + step;
+    const float py         = static_cast<float>(row) * pitchY;
+
+    for (std::uint32_t column = 0; column < columns; ++column)
+    {
+        out[column] = {};
+
+        // Mirrored, like most generated levels.
+        const std::uint32_t sampled = std::min(column, columns - 1 - column);
+        const float         px      = (static_cast<float>(sampled) + 0.5f) * pitchX;
+        if (fractalNoise(densitySeed, px, py) < 1.0f - ENDLESS_DENSITY)
+            continue;
+
+        const int hitPoints = std::min(maxHitPoints,
+                                       1 + static_cast<int>(fractalNoise(toughSeed, px, py) *
+                                                            static_cast<float>(maxHitPoints)));
+
+        Brick& brick    = out[column];
+        brick.x         = left + static_cast<float>(column) * pitchX;
+        brick.y         = 0.5f * Constants::BRICK_PADDING;
+        brick.width     = Constants::BRICK_WIDTH;
+        brick.height    = Constants::BRICK_HEIGHT;
+        brick.hitPoints = static_cast<std::uint8_t>(hitPoints);
+        brick.points    = BASE_POINTS * (1 + step) * hitPoints;
+        brick.color     = HIT_POINT_COLORS[static_cast<std::size_t>(
+                              std::min<int>(hitPoints, HIT_POINT_COLORS.size()) - 1)].toInteger();
+        if (latticeValue(blastSeed, static_cast<std::int32_t>(sampled), static_cast<std::int32_t>(row)) <
+            ENDLESS_EXPLOSIVE)
+            brick.type = BrickType::Explosive;
+    }
+}
+
+std::shared_ptr<const LevelPack> LevelGenerator::endless(std::uint32_t seed)
+{
+    // The rows bring their own bricks; the level is only the playfield.
+    auto pack = std::make_shared<LevelPack>();
+    pack->add(Level());
+    pack->setEndless(seed);
+    pack->setSource(LevelPack::makeSource("endless", std::to_string(seed)));
+    return pack;
+}
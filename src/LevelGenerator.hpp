@@ -0,0 +1,130 @@
+/**
+ * @file LevelGenerator.hpp
+ * @brief Seeded procedural brick layouts of any size.
+ *
+ * The generator fills a rectangle of the playfield with a columns × rows
+ * grid of cells and decides for each cell, from the seed alone, whether it
+ * holds a brick and how tough the brick is:
+ *
+ *   - a density field mixes fractal value noise with one of a few large
+ *     shapes (rings, a diamond, stripes, an arch) picked by the seed, so
+ *     layouts have structure rather than static;
+ *   - cells above a threshold get a brick, usually mirrored left to right
+ *     like a hand-made level;
+ *   - a second noise channel, biased towards the top, gives hit points;
+ *     colour follows hit points and score follows hit points and height;
+ *   - optionally, a random share of the bricks is explosive.
+ *
+ * An area starting less than BRICK_TOP_OFFSET from the top of the window,
+ * or above it, makes a tall level (see Level::getTop()) with that margin
+ * above the bricks.
+ *
+ * Every cell is a pure function of the seed and its position, with noise
+ * features measured in pixels, so a finer grid over the same area draws the
+ * same picture in smaller bricks.  Rows are generated in bands on a pool of
+ * threads, and the finished bands are copied into the level's brick array
+ * in parallel at their offsets, so the bricks come out in row order.  The
+ * result does not depend on the number of threads.
+ *
+ * Endless mode (see EndlessField.hpp) asks for one row of the classic
+ * brick grid at a time instead, from a density field without ends: each
+ * row samples the field one row further on, so its bricks join the rows
+ * before it into shapes, and rows grow tougher the further the game gets.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "Level.hpp"
+#include "constants.hpp"
+
+/**
+ * @brief Builds Level layouts procedurally.
+ */
+class LevelGenerator
+{
+public:
+    /**
+     * @brief What to generate.  The defaults cover the classic brick area.
+     */
+    struct Settings
+    {
+        std::uint32_t seed    = 0;   ///< Same seed and settings, same layout.
+        std::uint32_t columns = Constants::BRICK_COLS * 4; ///< Cells per row.
+        std::uint32_t rows    = Constants::BRICK_ROWS * 4; ///< Cell rows.
+
+        float left   = (static_cast<float>(Constants::WINDOW_WIDTH) -
+                        (Constants::BRICK_COLS * Constants::BRICK_WIDTH +
+                         (Constants::BRICK_COLS - 1) * Constants::BRICK_PADDING)) * 0.5f; ///< Area left edge.
+        float top    = Constants::BRICK_TOP_OFFSET; ///< Area top edge; above BRICK_TOP_OFFSET makes a tall level.
+        float width  = Constants::BRICK_COLS * Constants::BRICK_WIDTH +
+                       (Constants::BRICK_COLS - 1) * Constants::BRICK_PADDING; ///< Area width.
+        float height = Constants::BRICK_ROWS * Constants::BRICK_HEIGHT +
+                       (Constants::BRICK_ROWS - 1) * Constants::BRICK_PADDING; ///< Area height.
+
+        float    gap          = 0.1f;  ///< Fraction of each cell left empty around its brick.
+        float    density      = 0.55f; ///< 0 … 1; higher fills more cells.
+        float    explosive    = 0.0f;  ///< 0 … 1; share of bricks that are explosive.
+        int      maxHitPoints = 3;     ///< Toughest brick, 1 … 255.
+        bool     mirror       = true;  ///< Make the left and right halves match.
+        unsigned threads      = 0;     ///< Worker threads; 0 = one per hardware thread.
+    };
+
+    /**
+     * @brief Generates a layout.
+     *
+     * A field that comes out empty (a very low density) is regenerated
+     * full, so the level always has bricks.
+     *
+     * @param settings  What to generate; sizes of 0 are treated as 1.
+     * @return Level    The layout, indexed and ready to play.
+     */
+    static Level generate(const Settings& settings);
+
+    /**
+     * @brief Settings for level @p number of a generated campaign.
+     *
+     * Grids get finer and bricks tougher from level to level, and every
+     * level has its own seed derived from @p seed.
+     *
+     * @param seed    Campaign seed.
+     * @param number  Level number (1-based).
+     */
+    static Settings forLevel(std::uint32_t seed, int number);
+
+    /**
+     * @brief Returns a campaign of Constants::MAX_LEVELS generated levels.
+     *
+     * Levels are generated on first use (see LevelPack::prefetch()), so the
+     * pack is cheap to create.
+     *
+     * @param seed  Campaign seed.
+     */
+    static std::shared_ptr<const LevelPack> campaign(std::uint32_t seed);
+
+    /**
+     * @brief Generates row @p row of the endless field for @p seed.
+     *
+     * Constants::BRICK_COLS cells in the columns of the built-in levels,
+     * x in playfield pixels and y from the top of the row; empty cells
+     * have no hit points.  A pure function of its arguments, so it may run
+     * on any thread.
+     *
+     * @param seed  Field seed.
+     * @param row   Row number; 0 is the first row of a game.
+     * @param out   Receives Constants::BRICK_COLS bricks.
+     */
+    static void generateRow(std::uint32_t seed, std::uint32_t row, Brick* out);
+
+    /**
+     * @brief Returns a pack for endless mode with rows from generateRow().
+     *
+     * Its one level is the empty playfield the rows stream through (see
+     * LevelPack::setEndless()).
+     *
+     * @param seed  Field seed.
+     */
+    static std::shared_ptr<const LevelPack> endless(std::uint32_t seed);
+};
@@ -0,0 +1,232 @@
+/**
+ * @file LevelWatcher.cpp
+ * @brief Implementation of the LevelWatcher class.
+ */
+
+#include "LevelWatcher.hpp"
+
+#include <algorithm>  // std::find, std::find_if
+#include <chrono>
+#include <filesystem>
+#include <iostream>   // std::cerr, std::cout
+#include <set>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>      // std::strerror, std::memcpy
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+/// How often the event loop checks for stop(), in milliseconds.
+static constexpr int POLL_INTERVAL_MS = 100;
+
+/// A changed file is reloaded once it has had no events for this long.
+static constexpr std::chrono::milliseconds SETTLE_TIME(150);
+
+// -----------------------------------------------------------------------------
+// Construction
+// -----------------------------------------------------------------------------
+
+LevelWatcher::LevelWatcher()
+    : inotifyFd(-1)
+    , stopping(false)
+    , hasReloads(false)
+{
+}
+
+LevelWatcher::~LevelWatcher()
+{
+    stop();
+}
+
+// -----------------------------------------------------------------------------
+// Game thread
+// -----------------------------------------------------------------------------
+
+bool LevelWatcher::poll(int& number)
+{
+    if (!hasReloads.load(std::memory_order_acquire))
+        return false;
+
+    std::unique_lock<std::mutex> lock(reloadedMutex, std::try_to_lock);
+    if (!lock.owns_lock() || reloaded.empty())
+        return false;
+
+    number = reloaded.front();
+    reloaded.erase(reloaded.begin());
+    hasReloads.store(!reloaded.empty(), std::memory_order_release);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Reloading
+// -----------------------------------------------------------------------------
+
+void LevelWatcher::reload(const std::string& name)
+{
+    namespace fs = std::filesystem;
+
+    const fs::path changed = fs::path(directory) / name;
+    auto file = std::find_if(files.begin(), files.end(), [&](const std::string& path)
+    {
+        return fs::path(path).filename() == name;
+    });
+
+    if (file == files.end())
+    {
+        auto shadowing = std::find_if(files.begin(), files.end(), [&](const std::string& path)
+        {
+            return fs::path(path).stem() == changed.stem();
+        });
+        if (shadowing != files.end())
+            std::cerr << "[Breakout] WARNING: Not reloading \"" << changed.string() << "\": \""
+                      << *shadowing << "\" is played instead (recompile it).\n";
+        else
+            std::cerr << "[Breakout] WARNING: \"" << changed.string()
+                      << "\" is not in the level pack; restart to add it.\n";
+        return;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+
+    // Failures are reported by load(); the level keeps its old layout.
+    Level level;
+    if (!Level::load(*file, level))
+        return;
+
+    const int         number      = static_cast<int>(file - files.begin()) + 1;
+    const std::size_t brickCount  = level.getBricks().size();
+    pack->replace(number, std::move(level));
+
+    const double milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    std::cout << "[Breakout] Reloaded level " << number << " from \"" << *file << "\" ("
+              << brickCount << " bricks, " << static_cast<int>(milliseconds + 0.5) << " ms).\n";
+
+    std::lock_guard<std::mutex> lock(reloadedMutex);
+    if (std::find(reloaded.begin(), reloaded.end(), number) == reloaded.end())
+        reloaded.push_back(number);
+    hasReloads.store(true, std::memory_order_release);
+}
+
+#ifdef __linux__
+
+// -----------------------------------------------------------------------------
+// Starting and stopping
+// -----------------------------------------------------------------------------
+
+bool LevelWatcher::start(const std::string& watchedDirectory, std::shared_ptr<LevelPack> levels)
+{
+    if (inotifyFd >= 0)
+        return true;
+
+    if (!LevelPack::listDirectory(watchedDirectory, files))
+        return false;
+
+    int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0 || ::inotify_add_watch(fd, watchedDirectory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+    {
+        std::cerr << "[Breakout] WARNING: Cannot watch \"" << watchedDirectory << "\": "
+                  << std::strerror(errno) << "; level reloading disabled.\n";
+        if (fd >= 0)
+            ::close(fd);
+        return false;
+    }
+
+    inotifyFd = fd;
+    directory = watchedDirectory;
+    pack      = std::move(levels);
+    stopping  = false;
+    thread    = std::thread(&LevelWatcher::watch, this);
+    return true;
+}
+
+void LevelWatcher::stop()
+{
+    if (inotifyFd < 0)
+        return;
+
+    stopping = true;
+    if (thread.joinable())
+        thread.join();
+
+    ::close(inotifyFd);
+    inotifyFd = -1;
+    pack.reset();
+}
+
+// -----------------------------------------------------------------------------
+// Background thread
+// -----------------------------------------------------------------------------
+
+void LevelWatcher::watch()
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::set<std::string> changed;   // Files with events not yet reloaded.
+    Clock::time_point     lastEvent;
+
+    // Event records are variable length; this holds dozens of them.
+    alignas(inotify_event) char buffer[4096];
+
+    while (!stopping)
+    {
+        // Poll with a timeout so stop() never waits longer than one interval.
+        pollfd watched = { inotifyFd, POLLIN, 0 };
+        if (::poll(&watched, 1, POLL_INTERVAL_MS) > 0)
+        {
+            ssize_t length;
+            while ((length = ::read(inotifyFd, buffer, sizeof(buffer))) > 0)
+            {
+                for (ssize_t offset = 0; offset < length; )
+                {
+                    inotify_event event;
+                    std::memcpy(&event, buffer + offset, sizeof(event));
+                    if (event.len > 0)
+                    {
+                        const std::string name(buffer + offset + sizeof(event));
+                        const std::string extension = std::filesystem::path(name).extension().string();
+                        if (extension == ".brkl" || extension == ".level")
+                        {
+                            changed.insert(name);
+                            lastEvent = Clock::now();
+                        }
+                    }
+                    offset += static_cast<ssize_t>(sizeof(event) + event.len);
+                }
+            }
+        }
+
+        if (!changed.empty() && Clock::now() - lastEvent >= SETTLE_TIME)
+        {
+            for (const std::string& name : changed)
+                reload(name);
+            changed.clear();
+        }
+    }
+}
+
+#else // !__linux__
+
+// -----------------------------------------------------------------------------
+// Unsupported platforms
+// -----------------------------------------------------------------------------
+
+bool LevelWatcher::start(const std::string&, std::shared_ptr<LevelPack>)
+{
+    std::cerr << "[Breakout] WARNING: Level reloading is only available on Linux; "
+                 "--watch-levels ignored.\n";
+    return false;
+}
+
+void LevelWatcher::stop()
+{
+}
+
+void LevelWatcher::watch()
+{
+}
+
+#endif // __linux__
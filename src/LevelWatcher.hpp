@@ -0,0 +1,92 @@
+/**
+ * @file LevelWatcher.hpp
+ * @brief Declaration of LevelWatcher — reloads edited level files.
+ *
+ * For level designers: with --watch-levels, saving a file in the --levels
+ * directory updates the running game.  A background thread watches the
+ * directory with inotify and, once a changed file has been quiet for a
+ * moment (editors often write a file in several steps), loads it and
+ * replaces its level in the LevelPack.  Parsing and indexing happen on that
+ * thread, so even a very large level never stalls a frame; a file that no
+ * longer loads is reported and the previous layout kept.
+ *
+ * The game polls for reloaded level numbers between ticks (poll() never
+ * blocks) and restarts the current level's bricks when it is one of them
+ * (see Simulation::reloadLevel()); other levels pick the new layout up when
+ * they are reached.
+ *
+ * The set of levels is fixed when the pack is loaded: new files and files
+ * shadowed by a compiled level of the same name are reported and ignored.
+ * Linux only — on other platforms start() prints a warning and returns
+ * false.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Level.hpp"
+
+/**
+ * @brief Background reloader for one level directory.
+ */
+class LevelWatcher
+{
+public:
+    /// Creates an idle watcher.
+    LevelWatcher();
+
+    /// Stops the thread.
+    ~LevelWatcher();
+
+    LevelWatcher(const LevelWatcher&)            = delete;
+    LevelWatcher& operator=(const LevelWatcher&) = delete;
+
+    /**
+     * @brief Starts watching @p directory for changes to @p pack's files.
+     * @param directory  Directory @p pack was loaded from.
+     * @param pack       Pack whose levels are replaced on reload.
+     * @return true if the watcher thread is running.
+     */
+    bool start(const std::string& directory, std::shared_ptr<LevelPack> pack);
+
+    /// Stops the watcher thread; safe to call when not running.
+    void stop();
+
+    /**
+     * @brief Takes the number of a level reloaded since the last call.
+     *
+     * Never blocks: if the watcher thread is publishing a reload at that
+     * moment, the reload is returned by a later call instead.
+     *
+     * @param number  Receives the level number (1-based).
+     * @return true if a level was reloaded.
+     */
+    bool poll(int& number);
+
+private:
+    /// Event loop run on the background thread.
+    void watch();
+
+    /**
+     * @brief Reloads the level file called @p name, if it is one.
+     * @param name  File name within the directory.
+     */
+    void reload(const std::string& name);
+
+    std::shared_ptr<LevelPack> pack;       ///< Levels being replaced.
+    std::string                directory;  ///< Watched directory.
+    std::vector<std::string>   files;      ///< Level files; level n is files[n - 1].
+    int                        inotifyFd;  ///< inotify instance, or -1.
+    std::thread                thread;     ///< Background event loop.
+    std::atomic<bool>          stopping;   ///< Set by stop() to end watch().
+
+    std::mutex                 reloadedMutex; ///< Guards reloaded.
+    std::vector<int>           reloaded;      ///< Levels reloaded, not yet polled.
+    std::atomic<bool>          hasReloads;    ///< reloaded is not empty.
+};
@@ -0,0 +1,144 @@
+/**
+ * @file Metrics.cpp
+ * @brief Implementation of MetricsRegistry and its metric types.
+ */
+
+#include "Metrics.hpp"
+
+#include <algorithm> // std::sort
+#include <cmath>     // std::isnan, std::isinf
+#include <ostream>
+#include <utility>   // std::move
+
+static_assert(std::atomic<double>::is_always_lock_free,
+              "Gauges and histogram sums rely on lock-free atomic<double>");
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Writes @p value using the Prometheus spelling of special values.
+ */
+static void writeValue(std::ostream& out, double value)
+{
+    if (std::isnan(value))
+        out << "NaN";
+    else if (std::isinf(value))
+        out << (value > 0.0 ? "+Inf" : "-Inf");
+    else
+        out << value;
+}
+
+/**
+ * @brief Writes the # HELP and # TYPE lines for one metric.
+ */
+static void writeHeader(std::ostream& out, const std::string& name,
+                        const std::string& help, const char* type)
+{
+    out << "# HELP " << name << ' ' << help << '\n'
+        << "# TYPE " << name << ' ' << type << '\n';
+}
+
+// -----------------------------------------------------------------------------
+// Metric types
+// -----------------------------------------------------------------------------
+
+MetricsRegistry::Metric::Metric(const std::string& name, const std::string& help)
+    : name(name)
+    , help(help)
+{
+}
+
+void MetricsRegistry::Counter::writeText(std::ostream& out) const
+{
+    writeHeader(out, name, help, "counter");
+    out << name << ' ' << value() << '\n';
+}
+
+void MetricsRegistry::Gauge::writeText(std::ostream& out) const
+{
+    writeHeader(out, name, help, "gauge");
+    out << name << ' ';
+    writeValue(out, value());
+    out << '\n';
+}
+
+MetricsRegistry::Histogram::Histogram(const std::string& name, const std::string& help,
+                                      std::vector<double> upperBounds)
+    : Metric(name, help)
+    , bounds(std::move(upperBounds))
+    , buckets(new std::atomic<std::uint64_t>[bounds.size() + 1])
+{
+    std::sort(bounds.begin(), bounds.end());
+    for (std::size_t i = 0; i <= bounds.size(); ++i)
+        buckets[i].store(0, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::Histogram::observe(double value)
+{
+    // Bucket lists are short (around ten bounds), so a linear scan beats a
+    // binary search here.
+    std::size_t i = 0;
+    while (i < bounds.size() && value > bounds[i])
+        ++i;
+    buckets[i].fetch_add(1, std::memory_order_relaxed);
+
+    double expected = sum.load(std::memory_order_relaxed);
+    while (!sum.compare_exchange_weak(expected, expected + value, std::memory_order_relaxed))
+    {
+    }
+}
+
+void MetricsRegistry::Histogram::writeText(std::ostream& out) const
+{
+    writeHeader(out, name, help, "histogram");
+
+    std::uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < bounds.size(); ++i)
+    {
+        cumulative += buckets[i].load(std::memory_order_relaxed);
+        out << name << "_bucket{le=\"";
+        writeValue(out, bounds[i]);
+        out << "\"} " << cumulative << '\n';
+    }
+    cumulative += buckets[bounds.size()].load(std::memory_order_relaxed);
+
+    out << name << "_bucket{le=\"+Inf\"} " << cumulative << '\n'
+        << name << "_sum ";
+    writeValue(out, sum.load(std::memory_order_relaxed));
+    out << '\n'
+        << name << "_count " << cumulative << '\n';
+}
+
+// -----------------------------------------------------------------------------
+// Registry
+// -----------------------------------------------------------------------------
+
+MetricsRegistry::Counter& MetricsRegistry::addCounter(const std::string& name,
+                                                      const std::string& help)
+{
+    metrics.push_back(std::make_unique<Counter>(name, help));
+    return static_cast<Counter&>(*metrics.back());
+}
+
+MetricsRegistry::Gauge& MetricsRegistry::addGauge(const std::string& name,
+                                                  const std::string& help)
+{
+    metrics.push_back(std::make_unique<Gauge>(name, help));
+    return static_cast<Gauge&>(*metrics.back());
+}
+
+MetricsRegistry::Histogram& MetricsRegistry::addHistogram(const std::string& name,
+                                                          const std::string& help,
+                                                          std::vector<double> upperBounds)
+{
+    metrics.push_back(std::make_unique<Histogram>(name, help, std::move(upperBounds)));
+    return static_cast<Histogram&>(*metrics.back());
+}
+
+void MetricsRegistry::writeText(std::ostream& out) const
+{
+    for (const auto& metric : metrics)
+        metric->writeText(out);
+}
@@ -0,0 +1,148 @@
+/**
+ * @file Metrics.hpp
+ * @brief Declaration of MetricsRegistry — counters, gauges and histograms.
+ *
+ * The registry holds named metrics that the game loop updates and a
+ * background MetricsServer thread reads.  Updates are single relaxed atomic
+ * operations — no locks, no allocation — so instrumenting the frame costs a
+ * few nanoseconds and a concurrent scrape can never stall it.
+ *
+ * All metrics must be registered before the server starts; the registry
+ * itself is not synchronised, only the metric values are.  Metric objects
+ * live for the lifetime of the registry, so the references returned by the
+ * add*() methods stay valid.
+ *
+ * writeText() produces the Prometheus text exposition format (version
+ * 0.0.4).  A scrape reads each value independently, so metrics may be a few
+ * updates apart from one another; each histogram's _count is derived from
+ * its own buckets so the series stays self-consistent.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Set of metrics exposed to monitoring.
+ */
+class MetricsRegistry
+{
+public:
+    /**
+     * @brief Common base: name, help text, and text rendering.
+     */
+    class Metric
+    {
+    public:
+        Metric(const std::string& name, const std::string& help);
+        virtual ~Metric() = default;
+
+        /// Writes the # HELP / # TYPE header and all samples.
+        virtual void writeText(std::ostream& out) const = 0;
+
+    protected:
+        std::string name; ///< Prometheus metric name.
+        std::string help; ///< One-line description.
+    };
+
+    /**
+     * @brief Monotonically increasing count.
+     */
+    class Counter : public Metric
+    {
+    public:
+        using Metric::Metric;
+
+        /// Adds @p amount to the count.
+        void increment(std::uint64_t amount = 1)
+        {
+            count.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        /// @return The current count.
+        std::uint64_t value() const { return count.load(std::memory_order_relaxed); }
+
+        void writeText(std::ostream& out) const override;
+
+    private:
+        std::atomic<std::uint64_t> count{0};
+    };
+
+    /**
+     * @brief Value that can go up and down.
+     */
+    class Gauge : public Metric
+    {
+    public:
+        using Metric::Metric;
+
+        /// Replaces the current value.
+        void set(double value) { current.store(value, std::memory_order_relaxed); }
+
+        /// @return The current value.
+        double value() const { return current.load(std::memory_order_relaxed); }
+
+        void writeText(std::ostream& out) const override;
+
+    private:
+        std::atomic<double> current{0.0};
+    };
+
+    /**
+     * @brief Distribution of observations in fixed buckets.
+     *
+     * Bucket upper bounds are fixed at registration; an implicit +Inf bucket
+     * catches everything larger.  Buckets are stored non-cumulatively and
+     * summed when written out.
+     */
+    class Histogram : public Metric
+    {
+    public:
+        Histogram(const std::string& name, const std::string& help,
+                  std::vector<double> upperBounds);
+
+        /// Records one observation of @p value.
+        void observe(double value);
+
+        void writeText(std::ostream& out) const override;
+
+    private:
+        std::vector<double>                          bounds;  ///< Ascending upper bounds.
+        std::unique_ptr<std::atomic<std::uint64_t>[]> buckets; ///< bounds.size() + 1 counts.
+        std::atomic<double>                          sum{0.0};///< Sum of observations.
+    };
+
+    /**
+     * @brief Registers a counter.  Prometheus convention: name ends in _total.
+     * @return Counter&  The new counter, valid for the registry's lifetime.
+     */
+    Counter& addCounter(const std::string& name, const std::string& help);
+
+    /**
+     * @brief Registers a gauge.
+     * @return Gauge&  The new gauge, valid for the registry's lifetime.
+     */
+    Gauge& addGauge(const std::string& name, const std::string& help);
+
+    /**
+     * @brief Registers a histogram with the given bucket upper bounds.
+     * @param upperBounds  Ascending bucket bounds, excluding +Inf.
+     * @return Histogram&  The new histogram, valid for the registry's lifetime.
+     */
+    Histogram& addHistogram(const std::string& name, const std::string& help,
+                            std::vector<double> upperBounds);
+
+    /**
+     * @brief Writes every metric in registration order.
+     * @param out  Destination stream (Prometheus text format 0.0.4).
+     */
+    void writeText(std::ostream& out) const;
+
+private:
+    std::vector<std::unique_ptr<Metric>> metrics; ///< Registration order.
+};
@@ -0,0 +1,272 @@
+/**
+ * @file MetricsServer.cpp
+ * @brief Implementation of the MetricsServer class.
+ */
+
+#include "MetricsServer.hpp"
+
+#include <cstdint>  // std::uint16_t
+#include <iostream> // std::cerr
+#include <sstream>  // std::ostringstream
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>      // std::strerror, std::memset, std::strncpy
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define BREAKOUT_HAVE_SOCKETS 1
+#endif
+
+/// How often the accept loop checks for stop(), in milliseconds.
+static constexpr int POLL_INTERVAL_MS = 200;
+
+/// Longest a client may take to send its request, in milliseconds.
+static constexpr int CLIENT_TIMEOUT_MS = 500;
+
+/// Requests larger than this are answered without reading the rest.
+static constexpr std::size_t MAX_REQUEST_BYTES = 8192;
+
+// -----------------------------------------------------------------------------
+// Construction
+// -----------------------------------------------------------------------------
+
+MetricsServer::MetricsServer(const MetricsRegistry& registry)
+    : registry(registry)
+    , listenFd(-1)
+    , stopping(false)
+{
+}
+
+MetricsServer::~MetricsServer()
+{
+    stop();
+}
+
+#ifdef BREAKOUT_HAVE_SOCKETS
+
+// -----------------------------------------------------------------------------
+// Starting and stopping
+// -----------------------------------------------------------------------------
+
+bool MetricsServer::startUnix(const std::string& path)
+{
+    if (listenFd >= 0)
+        return true;
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "[Breakout] WARNING: Metrics socket path \"" << path
+                  << "\" is empty or too long; metrics disabled.\n";
+        return false;
+    }
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    // Replace a socket left behind by a previous run, but never delete a
+    // regular file that happens to sit at the configured path.
+    struct stat existing;
+    if (::lstat(path.c_str(), &existing) == 0)
+    {
+        if (!S_ISSOCK(existing.st_mode))
+        {
+            std::cerr << "[Breakout] WARNING: \"" << path
+                      << "\" exists and is not a socket; metrics disabled.\n";
+            return false;
+        }
+        ::unlink(path.c_str());
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 ||
+        ::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, 4) != 0)
+    {
+        std::cerr << "[Breakout] WARNING: Cannot listen on \"" << path << "\": "
+                  << std::strerror(errno) << "; metrics disabled.\n";
+        if (fd >= 0)
+            ::close(fd);
+        return false;
+    }
+
+    listenFd   = fd;
+    socketPath = path;
+    stopping   = false;
+    thread     = std::thread(&MetricsServer::serve, this);
+    return true;
+}
+
+bool MetricsServer::startTcp(int port)
+{
+    if (listenFd >= 0)
+        return true;
+
+    if (port <= 0 || port > 65535)
+    {
+        std::cerr << "[Breakout] WARNING: Invalid metrics port " << port
+                  << "; metrics disabled.\n";
+        return false;
+    }
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family      = AF_INET;
+    address.sin_port        = htons(static_cast<std::uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    if (fd < 0 ||
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+        ::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, 4) != 0)
+    {
+        std::cerr << "[Breakout] WARNING: Cannot listen on 127.0.0.1:" << port << ": "
+                  << std::strerror(errno) << "; metrics disabled.\n";
+        if (fd >= 0)
+            ::close(fd);
+        return false;
+    }
+
+    listenFd = fd;
+    stopping = false;
+    thread   = std::thread(&MetricsServer::serve, this);
+    return true;
+}
+
+void MetricsServer::stop()
+{
+    if (listenFd < 0)
+        return;
+
+    stopping = true;
+    if (thread.joinable())
+        thread.join();
+
+    ::close(listenFd);
+    listenFd = -1;
+
+    if (!socketPath.empty())
+    {
+        ::unlink(socketPath.c_str());
+        socketPath.clear();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Background thread
+// -----------------------------------------------------------------------------
+
+void MetricsServer::serve()
+{
+    while (!stopping)
+    {
+        // Poll with a timeout rather than blocking in accept() so stop()
+        // never waits longer than one interval.
+        pollfd listener = { listenFd, POLLIN, 0 };
+        if (::poll(&listener, 1, POLL_INTERVAL_MS) <= 0)
+            continue;
+
+        int client = ::accept(listenFd, nullptr, nullptr);
+        if (client < 0)
+            continue;
+
+#ifdef SO_NOSIGPIPE
+        // macOS has no MSG_NOSIGNAL; disable SIGPIPE on the socket instead.
+        int noSigPipe = 1;
+        ::setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+        handleClient(client);
+        ::close(client);
+    }
+}
+
+void MetricsServer::handleClient(int client)
+{
+    // Read until the end of the request headers.  The request line is not
+    // inspected: every path returns the metrics page.
+    std::string request;
+    char        buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos &&
+           request.find("\n\n") == std::string::npos &&
+           request.size() < MAX_REQUEST_BYTES)
+    {
+        pollfd readable = { client, POLLIN, 0 };
+        if (::poll(&readable, 1, CLIENT_TIMEOUT_MS) <= 0)
+            return;
+
+        ssize_t received = ::recv(client, buffer, sizeof(buffer), 0);
+        if (received <= 0)
+            return;
+        request.append(buffer, static_cast<std::size_t>(received));
+    }
+
+    std::ostringstream body;
+    registry.writeText(body);
+    const std::string content = body.str();
+
+    std::ostringstream response;
+    response << "HTTP/1.1 200 OK\r\n"
+             << "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+             << "Content-Length: " << content.size() << "\r\n"
+             << "Connection: close\r\n\r\n"
+             << content;
+    const std::string bytes = response.str();
+
+#ifdef MSG_NOSIGNAL
+    const int flags = MSG_NOSIGNAL; // A vanished client must not kill the game.
+#else
+    const int flags = 0;
+#endif
+
+    std::size_t sent = 0;
+    while (sent < bytes.size())
+    {
+        pollfd writable = { client, POLLOUT, 0 };
+        if (::poll(&writable, 1, CLIENT_TIMEOUT_MS) <= 0)
+            return;
+
+        ssize_t written = ::send(client, bytes.data() + sent, bytes.size() - sent, flags);
+        if (written <= 0)
+            return;
+        sent += static_cast<std::size_t>(written);
+    }
+}
+
+#else // !BREAKOUT_HAVE_SOCKETS
+
+// -----------------------------------------------------------------------------
+// Unsupported platforms
+// -----------------------------------------------------------------------------
+
+bool MetricsServer::startUnix(const std::string&)
+{
+    std::cerr << "[Breakout] WARNING: The metrics endpoint is only available on "
+                 "Linux and macOS; metrics disabled.\n";
+    return false;
+}
+
+bool MetricsServer::startTcp(int port)
+{
+    return startUnix(std::to_string(port));
+}
+
+void MetricsServer::stop()
+{
+}
+
+void MetricsServer::serve()
+{
+}
+
+void MetricsServer::handleClient(int)
+{
+}
+
+#endif // BREAKOUT_HAVE_SOCKETS
@@ -0,0 +1,83 @@
+/**
+ * @file MetricsServer.hpp
+ * @brief Declaration of MetricsServer — serves a MetricsRegistry over HTTP.
+ *
+ * A background thread listens on a Unix domain socket or a loopback TCP
+ * port and answers every HTTP request with the registry in Prometheus text
+ * format.  The thread only reads metric atomics; it never takes a lock the
+ * game loop could be waiting on, so a slow or stuck scraper affects nothing
+ * but itself.  Connections are handled one at a time with short timeouts.
+ *
+ * Example scrapes:
+ *   curl --unix-socket /run/breakout/metrics.sock http://localhost/metrics
+ *   curl http://127.0.0.1:9464/metrics
+ *
+ * The TCP listener binds to 127.0.0.1 only; expose it to a fleet collector
+ * through a local agent rather than directly.  POSIX platforms only — on
+ * other platforms start() prints a warning and returns false.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "Metrics.hpp"
+
+/**
+ * @brief Background Prometheus endpoint for one registry.
+ */
+class MetricsServer
+{
+public:
+    /**
+     * @brief Creates an idle server for @p registry.
+     * @param registry  Metrics to expose; must outlive the server and have
+     *                  all its metrics registered before start.
+     */
+    explicit MetricsServer(const MetricsRegistry& registry);
+
+    /// Stops the thread and removes the socket file, if any.
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&)            = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    /**
+     * @brief Starts serving on a Unix domain socket at @p path.
+     *
+     * A stale socket left at @p path by a previous run is replaced; any
+     * other kind of file is left alone and the call fails.
+     *
+     * @param path  Filesystem path of the socket.
+     * @return true if the listener is running.
+     */
+    bool startUnix(const std::string& path);
+
+    /**
+     * @brief Starts serving on 127.0.0.1:@p port.
+     * @param port  TCP port (1–65535).
+     * @return true if the listener is running.
+     */
+    bool startTcp(int port);
+
+    /// Stops the listener thread; safe to call when not running.
+    void stop();
+
+private:
+    /// Accept loop run on the background thread.
+    void serve();
+
+    /**
+     * @brief Reads one request from @p client and writes the response.
+     * @param client  Connected socket; closed by the caller.
+     */
+    void handleClient(int client);
+
+    const MetricsRegistry& registry;   ///< Metrics being served.
+    int                    listenFd;   ///< Listening socket, or -1.
+    std::string            socketPath; ///< Unix socket to unlink on stop.
+    std::thread            thread;     ///< Background accept loop.
+    std::atomic<bool>      stopping;   ///< Set by stop() to end serve().
+};
@@ -0,0 +1,272 @@
+/**
+ * @file MovingBricks.cpp
+ * @brief Implementation of the MovingBricks class.
+ */
+
+#include "MovingBricks.hpp"
+
+#include <algorithm>  // std::min, std::max, std::find, std::sort, std::lower_bound
+#include <cmath>      // std::floor, std::abs
+#include <limits>
+
+// -----------------------------------------------------------------------------
+// Construction
+// -----------------------------------------------------------------------------
+
+MovingBricks::MovingBricks()
+    : clock(0)
+    , cellSize(Level::CELL_SIZE)
+    , cellsPerPixel(1.0f / Level::CELL_SIZE)
+    , gridLeft(0.0f)
+    , gridTop(0.0f)
+    , gridColumns(0)
+    , gridRows(0)
+{
+}
+
+void MovingBricks::reset(const Level& level)
+{
+    movers.clear();
+    cellStart.assign(1, 0);
+    cellCount.clear();
+    cellMovers.clear();
+    clock       = 0;
+    gridColumns = 0;
+    gridRows    = 0;
+
+    const std::vector<BrickPath>& paths = level.getPaths();
+    if (paths.empty())
+        return;
+
+    // The grid covers everywhere the bricks can reach.
+    float left   =  std::numeric_limits<float>::max();
+    float top    =  std::numeric_limits<float>::max();
+    float right  = -std::numeric_limits<float>::max();
+    float bottom = -std::numeric_limits<float>::max();
+    movers.reserve(paths.size());
+    for (const BrickPath& path : paths)
+    {
+        const sf::FloatRect home = level.getBricks()[path.brick].getBounds();
+        movers.push_back({ path, home, path.getOffset(0), 0, 0, 0, 0 });
+
+        left   = std::min(left,   home.left - std::abs(path.dx));
+        top    = std::min(top,    home.top  - std::abs(path.dy));
+        right  = std::max(right,  home.left + home.width  + std::abs(path.dx));
+        bottom = std::max(bottom, home.top  + home.height + std::abs(path.dy));
+    }
+
+    // A few bricks moving about a tall level would leave most cells of the
+    // usual size empty; grow the cells until there are a few per brick.
+    const std::size_t maxCells = 4 * movers.size() + 64;
+    cellSize = Level::CELL_SIZE;
+    for (;;)
+    {
+        gridColumns = static_cast<std::uint32_t>((right  - left) / cellSize) + 1;
+        gridRows    = static_cast<std::uint32_t>((bottom - top)  / cellSize) + 1;
+        if (static_cast<std::size_t>(gridColumns) * gridRows <= maxCells)
+            break;
+        cellSize *= 2.0f;
+    }
+    gridLeft      = left;
+    gridTop       = top;
+    cellsPerPixel = 1.0f / cellSize;
+
+    // Size each cell for every brick whose path sweeps it, so a brick
+    // moving in never needs more room than the cell already has.  The
+    // extremes are summed in getBounds()' order, so rounding cannot put a
+    // brick one cell beyond them.
+    const std::size_t cellTotal = static_cast<std::size_t>(gridColumns) * gridRows;
+    cellStart.assign(cellTotal + 1, 0);
+    for (const Mover& mover : movers)
+    {
+        const float         dx      = std::abs(mover.path.dx);
+        const float         dy      = std::abs(mover.path.dy);
+        const std::uint32_t column0 = cellOf(mover.home.left - dx,                      gridLeft, gridColumns);
+        const std::uint32_t column1 = cellOf(mover.home.left + dx + mover.home.width,   gridLeft, gridColumns);
+        const std::uint32_t row0    = cellOf(mover.home.top  - dy,                      gridTop,  gridRows);
+        const std::uint32_t row1    = cellOf(mover.home.top  + dy + mover.home.height,  gridTop,  gridRows);
+        for (std::uint32_t row = row0; row <= row1; ++row)
+            for (std::uint32_t column = column0; column <= column1; ++column)
+                ++cellStart[static_cast<std::size_t>(row) * gridColumns + column + 1];
+    }
+    for (std::size_t cell = 0; cell < cellTotal; ++cell)
+        cellStart[cell + 1] += cellStart[cell];
+    cellCount.assign(cellTotal, 0);
+    cellMovers.resize(cellStart[cellTotal]);
+
+    for (std::uint32_t i = 0; i < movers.size(); ++i)
+    {
+        Mover&              mover  = movers[i];
+        const sf::FloatRect bounds = getBounds(i);
+        mover.column0 = cellOf(bounds.left,                 gridLeft, gridColumns);
+        mover.column1 = cellOf(bounds.left + bounds.width,  gridLeft, gridColumns);
+        mover.row0    = cellOf(bounds.top,                  gridTop,  gridRows);
+        mover.row1    = cellOf(bounds.top  + bounds.height, gridTop,  gridRows);
+        link(i, true);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Movement
+// -----------------------------------------------------------------------------
+
+void MovingBricks::update(std::uint32_t now)
+{
+    clock = now;
+    for (std::uint32_t i = 0; i < movers.size(); ++i)
+    {
+        Mover& mover = movers[i];
+        mover.offset = mover.path.getOffset(now);
+
+        // Most ticks a brick stays within the same cells, and the grid is
+        // left alone.
+        const sf::FloatRect bounds  = getBounds(i);
+        const std::uint32_t column0 = cellOf(bounds.left,                 gridLeft, gridColumns);
+        const std::uint32_t column1 = cellOf(bounds.left + bounds.width,  gridLeft, gridColumns);
+        const std::uint32_t row0    = cellOf(bounds.top,                  gridTop,  gridRows);
+        const std::uint32_t row1    = cellOf(bounds.top  + bounds.height, gridTop,  gridRows);
+        if (column0 == mover.column0 && column1 == mover.column1 &&
+            row0    == mover.row0    && row1    == mover.row1)
+            continue;
+
+        link(i, false);
+        mover.column0 = column0;
+        mover.column1 = column1;
+        mover.row0    = row0;
+        mover.row1    = row1;
+        link(i, true);
+    }
+}
+
+void MovingBricks::link(std::uint32_t index, bool add)
+{
+    const Mover& mover = movers[index];
+    for (std::uint32_t row = mover.row0; row <= mover.row1; ++row)
+    {
+        for (std::uint32_t column = mover.column0; column <= mover.column1; ++column)
+        {
+            const std::size_t cell  = static_cast<std::size_t>(row) * gridColumns + column;
+            std::uint32_t*    first = cellMovers.data() + cellStart[cell];
+            std::uint32_t&    count = cellCount[cell];
+            if (add)
+            {
+                first[count++] = index;
+            }
+            else
+            {
+                // Order within a cell does not matter: swap with the last.
+                std::uint32_t* entry = std::find(first, first + count, index);
+                *entry = first[--count];
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Queries
+// -----------------------------------------------------------------------------
+
+std::size_t MovingBricks::getCount() const
+{
+    return movers.size();
+}
+
+std::size_t MovingBricks::find(std::uint32_t brick) const
+{
+    if (movers.empty())
+        return NONE;
+
+    auto mover = std::lower_bound(movers.begin(), movers.end(), brick, [](const Mover& m, std::uint32_t b)
+    {
+        return m.path.brick < b;
+    });
+    if (mover == movers.end() || mover->path.brick != brick)
+        return NONE;
+    return static_cast<std::size_t>(mover - movers.begin());
+}
+
+std::uint32_t MovingBricks::getBrick(std::size_t mover) const
+{
+    return movers[mover].path.brick;
+}
+
+sf::Vector2f MovingBricks::getOffset(std::size_t mover) const
+{
+    return movers[mover].offset;
+}
+
+sf::Vector2f MovingBricks::getVelocity(std::size_t mover) const
+{
+    return movers[mover].path.getVelocity(clock);
+}
+
+sf::FloatRect MovingBricks::getBounds(std::size_t mover) const
+{
+    const Mover& m = movers[mover];
+    return { m.home.left + m.offset.x, m.home.top + m.offset.y, m.home.width, m.home.height };
+}
+
+void MovingBricks::findOverlapping(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const
+{
+    out.clear();
+
+    const float right  = area.left + area.width;
+    const float bottom = area.top  + area.height;
+
+    std::uint32_t column0, column1, row0, row1;
+    if (!cellSpan(area.left, right,  gridLeft, gridColumns, column0, column1) ||
+        !cellSpan(area.top,  bottom, gridTop,  gridRows,    row0,    row1))
+        return;
+
+    for (std::uint32_t row = row0; row <= row1; ++row)
+    {
+        for (std::uint32_t column = column0; column <= column1; ++column)
+        {
+            const std::size_t    cell  = static_cast<std::size_t>(row) * gridColumns + column;
+            const std::uint32_t* first = cellMovers.data() + cellStart[cell];
+            for (const std::uint32_t* entry = first; entry != first + cellCount[cell]; ++entry)
+            {
+                const std::uint32_t index = *entry;
+                // List a brick only from the first of its cells the area
+                // covers, and only if it really overlaps.
+                const Mover& mover = movers[index];
+                if (std::max(mover.column0, column0) != column || std::max(mover.row0, row0) != row)
+                    continue;
+
+                const sf::FloatRect bounds = getBounds(index);
+                if (bounds.left < right && bounds.left + bounds.width  > area.left &&
+                    bounds.top < bottom && bounds.top  + bounds.height > area.top)
+                    out.push_back(index);
+            }
+        }
+    }
+
+    // Cells list their bricks in the order they arrived in.
+    std::sort(out.begin(), out.end());
+}
+
+std::uint32_t MovingBricks::cellOf(float coordinate, float origin, std::uint32_t count) const
+{
+    // Bricks never leave the grid, so the cell is never negative and
+    // truncating is flooring, without a call to std::floor.  cellSpan()
+    // puts the same coordinate in the same cell.
+    const float cell = std::max((coordinate - origin) * cellsPerPixel, 0.0f);
+    return std::min(static_cast<std::uint32_t>(cell), count - 1);
+}
+
+bool MovingBricks::cellSpan(float low, float high, float origin, std::uint32_t count,
+                            std::uint32_t& first, std::uint32_t& last) const
+{
+    // As the level index does it, but for areas that may lie partly or
+    // wholly outside the grid.
+    const float lowCell  = std::floor((low  - origin) * cellsPerPixel);
+    const float highCell = std::floor((high - origin) * cellsPerPixel);
+    const float maxCell  = static_cast<float>(count - 1);
+
+    if (count == 0 || highCell < 0.0f || lowCell > maxCell)
+        return false;
+
+    first = static_cast<std::uint32_t>(std::max(lowCell, 0.0f));
+    last  = static_cast<std::uint32_t>(std::min(highCell, maxCell));
+    return true;
+}
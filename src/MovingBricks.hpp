@@ -0,0 +1,138 @@
+/**
+ * @file MovingBricks.hpp
+ * @brief Declaration of MovingBricks — where a level's moving bricks are,
+ *        with a grid index that follows them.
+ *
+ * A level's other bricks are indexed once, when it is loaded (see
+ * Level.hpp); moving bricks cannot be.  MovingBricks keeps each moving
+ * brick's current offset from its record and a uniform grid over the area
+ * their paths sweep.  update() moves every brick to where it is at a clock
+ * tick but touches the grid only for the bricks that crossed into other
+ * cells: at a few pixels per tick against cells of Level::CELL_SIZE or
+ * more, a small share of them.  Queries then cost about what they do in
+ * the level's own index, however many bricks move.  reset() gives every
+ * cell room for all the bricks whose paths sweep it, in one flat array, so
+ * update() never allocates.
+ *
+ * Positions follow from the clock alone (see BrickPath), so update() may
+ * jump to any tick, backwards included, which is how restoring a snapshot
+ * puts the bricks back.  Query results are sorted, so they depend only on
+ * where the bricks are and not on how the grid got there.
+ */
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Brick.hpp"
+#include "Level.hpp"
+
+/**
+ * @brief Current positions and grid index of one level's moving bricks.
+ *
+ * Moving bricks are numbered in the order of Level::getPaths(), which is
+ * also brick order.
+ */
+class MovingBricks
+{
+public:
+    /// Returned by find() for a brick that does not move.
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+    /// Creates an empty set: no brick moves.
+    MovingBricks();
+
+    /**
+     * @brief Takes the moving bricks of @p level, placed at clock 0.
+     *
+     * Copies what it needs, so @p level need not outlive the set.
+     *
+     * @param level  Layout whose paths to follow.
+     */
+    void reset(const Level& level);
+
+    /**
+     * @brief Moves every brick to where it is at @p now.
+     * @param now  Ticks the level has been played.
+     */
+    void update(std::uint32_t now);
+
+    /// @return Number of moving bricks.
+    std::size_t getCount() const;
+
+    /**
+     * @brief Returns the moving-brick number of brick @p brick.
+     * @param brick  Index into the level's bricks.
+     * @return Its number, or NONE if it does not move.
+     */
+    std::size_t find(std::uint32_t brick) const;
+
+    /// @return Index into the level's bricks of moving brick @p mover.
+    std::uint32_t getBrick(std::size_t mover) const;
+
+    /// @return How far moving brick @p mover is from its record's position.
+    sf::Vector2f getOffset(std::size_t mover) const;
+
+    /// @return Velocity of moving brick @p mover, pixels per second.
+    sf::Vector2f getVelocity(std::size_t mover) const;
+
+    /// @return Collision bounds of moving brick @p mover where it is now.
+    sf::FloatRect getBounds(std::size_t mover) const;
+
+    /**
+     * @brief Lists the moving bricks whose collision bounds overlap
+     *        @p area where they are now.
+     * @param area  Region to query, world coordinates.
+     * @param out   Cleared, then receives ascending moving-brick numbers.
+     */
+    void findOverlapping(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const;
+
+private:
+    /**
+     * @brief One moving brick.
+     */
+    struct Mover
+    {
+        BrickPath     path;     ///< How it moves; path.brick is the brick.
+        sf::FloatRect home;     ///< Collision bounds at its record's position.
+        sf::Vector2f  offset;   ///< Offset from home at the current clock.
+        std::uint32_t column0;  ///< First cell column its bounds span now.
+        std::uint32_t column1;  ///< Last cell column.
+        std::uint32_t row0;     ///< First cell row.
+        std::uint32_t row1;     ///< Last cell row.
+    };
+
+    /**
+     * @brief Finds the cells spanned by [@p low, @p high] along one axis.
+     * @return false if the span misses every cell.
+     */
+    bool cellSpan(float low, float high, float origin, std::uint32_t count,
+                  std::uint32_t& first, std::uint32_t& last) const;
+
+    /**
+     * @brief Finds the cell of a coordinate within the grid along one axis;
+     *        faster than cellSpan() for the coordinates of moving bricks.
+     */
+    std::uint32_t cellOf(float coordinate, float origin, std::uint32_t count) const;
+
+    /// Adds moving brick @p index to the cells it spans, or with @p add
+    /// false removes it from them.
+    void link(std::uint32_t index, bool add);
+
+    std::vector<Mover> movers;      ///< In brick order.
+    std::uint32_t      clock;       ///< Clock the offsets are for.
+
+    float              cellSize;    ///< Side of one cell, pixels.
+    float              cellsPerPixel; ///< 1 / cellSize.
+    float              gridLeft;    ///< Left edge of cell column 0.
+    float              gridTop;     ///< Top edge of cell row 0.
+    std::uint32_t      gridColumns; ///< Cells per row (0 = nothing moves).
+    std::uint32_t      gridRows;    ///< Cell rows.
+
+    std::vector<std::uint32_t> cellStart;  ///< Room of cell c: [cellStart[c], cellStart[c + 1]).
+    std::vector<std::uint32_t> cellCount;  ///< Moving bricks spanning cell c now, at the start of its room.
+    std::vector<std::uint32_t> cellMovers; ///< Moving-brick numbers, grouped by cell, in no order.
+};
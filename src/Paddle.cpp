@@ -29,32 +29,18 @@ Paddle::Paddle(float startX, float startY, float width, float height, float spee
 // Per-frame update and rendering
 // -----------------------------------------------------------------------------
 
-void Paddle::update(float deltaTime, float windowWidth)
+void Paddle::update(float deltaTime, float windowWidth, float direction)
 {
-    float horizontalInput = 0.0f;
-
-    // Accept both arrow keys and WASD so players can use either scheme.
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left) ||
-        sf::Keyboard::isKeyPressed(sf::Keyboard::A))
-    {
-        horizontalInput -= 1.0f;
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right) ||
-        sf::Keyboard::isKeyPressed(sf::Keyboard::D))
-    {
-        horizontalInput += 1.0f;
-    }
-
     // Compute the new left-edge X, clamped so the paddle stays within the window.
-    float newX = shape.getPosition().x + horizontalInput * speed * deltaTime;
+    float newX = shape.getPosition().x + direction * speed * deltaTime;
     newX = std::max(0.0f, std::min(newX, windowWidth - width));
 
     shape.setPosition(newX, shape.getPosition().y);
 }
 
-void Paddle::draw(sf::RenderWindow& window) const
+void Paddle::draw(sf::RenderTarget& target) const
 {
-    window.draw(shape);
+    target.draw(shape);
 }
 
 // -----------------------------------------------------------------------------
@@ -70,6 +56,11 @@ void Paddle::setPositionX(float x)
 // Accessors
 // -----------------------------------------------------------------------------
 
+float Paddle::getPositionX() const
+{
+    return shape.getPosition().x;
+}
+
 sf::FloatRect Paddle::getBounds() const
 {
     return shape.getGlobalBounds();
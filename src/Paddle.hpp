@@ -3,8 +3,8 @@
  * @brief Declaration of the Paddle class.
  *
  * The Paddle is the player-controlled horizontal bar at the bottom of the
- * screen.  It reads keyboard state each frame and moves accordingly, clamped
- * within the window bounds.
+ * screen.  It moves in the direction requested by the simulation's input
+ * each tick, clamped within the window bounds.
  */
 
 #pragma once
@@ -14,8 +14,9 @@
 /**
  * @brief Player-controlled paddle that deflects the ball.
  *
- * Movement is driven by sf::Keyboard::isKeyPressed queries inside update(),
- * which supports both the arrow keys and the A/D WASD keys simultaneously.
+ * The paddle does not read the keyboard itself: Game samples the arrow and
+ * A/D keys and the simulation passes the resulting direction to update(), so
+ * the same code runs for live play, bots and recorded input.
  *
  * The paddle is rendered as an sf::RectangleShape with a light-blue fill and
  * a slightly darker outline so it reads clearly against the dark background.
@@ -35,21 +36,22 @@ public:
     Paddle(float startX, float startY, float width, float height, float speed);
 
     /**
-     * @brief Reads player input and moves the paddle one simulation step.
+     * @brief Moves the paddle one simulation step.
      *
-     * Left arrow or A moves left; right arrow or D moves right.  The paddle
-     * is clamped so its edges never exceed the window boundaries [0, windowWidth].
+     * The paddle is clamped so its edges never exceed the window boundaries
+     * [0, windowWidth].
      *
-     * @param deltaTime    Time elapsed since the previous frame, in seconds.
+     * @param deltaTime    Length of the simulation step, in seconds.
      * @param windowWidth  Width of the window used as the right clamp boundary.
+     * @param direction    -1 to move left, +1 to move right, 0 to stay put.
      */
-    void update(float deltaTime, float windowWidth);
+    void update(float deltaTime, float windowWidth, float direction);
 
     /**
-     * @brief Draws the paddle onto the given render window.
-     * @param window  The sf::RenderWindow to draw into.
+     * @brief Draws the paddle onto the given render target.
+     * @param target  The window or offscreen texture to draw into.
      */
-    void draw(sf::RenderWindow& window) const;
+    void draw(sf::RenderTarget& target) const;
 
     /**
      * @brief Repositions the paddle horizontally.
@@ -61,6 +63,12 @@ public:
      */
     void setPositionX(float x);
 
+    /**
+     * @brief Returns the X coordinate of the paddle's left edge.
+     * @return float  Left edge, in pixels (the value setPositionX() takes).
+     */
+    float getPositionX() const;
+
     /**
      * @brief Returns the paddle's axis-aligned bounding rectangle.
      * @return sf::FloatRect  Bounds in world coordinates.
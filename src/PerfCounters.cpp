@@ -0,0 +1,289 @@
+/**
+ * @file PerfCounters.cpp
+ * @brief Implementation of the PerfCounters class.
+ */
+
+#include "PerfCounters.hpp"
+
+#include <iomanip> // std::setw, std::setprecision
+#include <ostream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>          // std::strerror, std::memset
+#include <iostream>         // std::cerr
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <iostream>         // std::cerr
+#endif
+
+// -----------------------------------------------------------------------------
+// Scope
+// -----------------------------------------------------------------------------
+
+PerfCounters::Scope::Scope(PerfCounters& counters, FramePhase phase)
+    : counters(counters)
+    , phase(phase)
+{
+    counters.begin(phase);
+}
+
+PerfCounters::Scope::~Scope()
+{
+    counters.end(phase);
+}
+
+// -----------------------------------------------------------------------------
+// Construction
+// -----------------------------------------------------------------------------
+
+PerfCounters::PerfCounters()
+    : active(false)
+    , phaseStart()
+    , phaseTotals()
+    , frames(0)
+    , ticks(0)
+{
+    fds.fill(-1);
+}
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+    for (int fd : fds)
+    {
+        if (fd >= 0)
+            ::close(fd);
+    }
+#endif
+}
+
+#ifdef __linux__
+
+/**
+ * @brief Thin wrapper over the perf_event_open system call (no glibc stub).
+ */
+static int perfEventOpen(perf_event_attr& attr, int groupFd)
+{
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr,
+                                      0 /* this thread */, -1 /* any CPU */,
+                                      groupFd, 0));
+}
+
+bool PerfCounters::open()
+{
+    if (active)
+        return true;
+
+    static const std::uint64_t CONFIGS[EventCount] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES,
+    };
+
+    int leader = -1;
+
+    for (int event = 0; event < EventCount; ++event)
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size           = sizeof(attr);
+        attr.type           = PERF_TYPE_HARDWARE;
+        attr.config         = CONFIGS[event];
+        attr.read_format    = PERF_FORMAT_GROUP;
+        attr.disabled       = (leader < 0) ? 1 : 0; // Leader starts the group.
+        attr.exclude_kernel = 1;                    // Works at paranoid level 2.
+        attr.exclude_hv     = 1;
+
+        int fd = perfEventOpen(attr, leader);
+        if (fd < 0)
+        {
+            if (leader < 0)
+            {
+                // Without the cycle counter there is no group to join.
+                int error = errno;
+                std::cerr << "[Breakout] WARNING: Hardware performance counters "
+                             "unavailable (" << std::strerror(error) << ").\n";
+                if (error == EACCES || error == EPERM)
+                {
+                    std::cerr << "           Lower /proc/sys/kernel/perf_event_paranoid "
+                                 "or grant CAP_PERFMON to enable them.\n";
+                }
+                return false;
+            }
+
+            // Unsupported secondary event: leave it unavailable.
+            continue;
+        }
+
+        fds[event] = fd;
+        if (leader < 0)
+            leader = fd;
+    }
+
+    ::ioctl(leader, PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP);
+    ::ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+    active = true;
+    return true;
+}
+
+bool PerfCounters::read(Values& values) const
+{
+    // PERF_FORMAT_GROUP layout: { u64 nr; u64 values[nr]; } in the order the
+    // group members were opened, which is Event order minus missing events.
+    std::uint64_t buffer[1 + EventCount];
+
+    ssize_t bytes = ::read(fds[Cycles], buffer, sizeof(buffer));
+    if (bytes < static_cast<ssize_t>(sizeof(std::uint64_t)))
+        return false;
+
+    std::uint64_t count = buffer[0];
+    std::size_t   slot  = 1;
+
+    for (int event = 0; event < EventCount; ++event)
+    {
+        if (fds[event] >= 0 && slot <= count)
+            values[event] = buffer[slot++];
+        else
+            values[event] = 0;
+    }
+    return true;
+}
+
+#else // !__linux__
+
+bool PerfCounters::open()
+{
+    std::cerr << "[Breakout] WARNING: Hardware performance counters are only "
+                 "supported on Linux.\n";
+    return false;
+}
+
+bool PerfCounters::read(Values&) const
+{
+    return false;
+}
+
+#endif // __linux__
+
+// -----------------------------------------------------------------------------
+// Sampling
+// -----------------------------------------------------------------------------
+
+bool PerfCounters::isActive() const
+{
+    return active;
+}
+
+void PerfCounters::begin(FramePhase)
+{
+    if (!active)
+        return;
+
+    read(phaseStart);
+}
+
+void PerfCounters::end(FramePhase phase)
+{
+    if (!active)
+        return;
+
+    Values now;
+    if (!read(now))
+        return;
+
+    Values& total = phaseTotals[static_cast<std::size_t>(phase)];
+    for (int event = 0; event < EventCount; ++event)
+        total[event] += now[event] - phaseStart[event];
+}
+
+void PerfCounters::endFrame(int frameTicks)
+{
+    if (!active)
+        return;
+    ++frames;
+    ticks += static_cast<std::uint64_t>(frameTicks);
+}
+
+// -----------------------------------------------------------------------------
+// Accessors and reporting
+// -----------------------------------------------------------------------------
+
+PerfCounters::Values PerfCounters::totals(FramePhase phase) const
+{
+    return phaseTotals[static_cast<std::size_t>(phase)];
+}
+
+std::uint64_t PerfCounters::frameCount() const
+{
+    return frames;
+}
+
+std::uint64_t PerfCounters::tickCount() const
+{
+    return ticks;
+}
+
+bool PerfCounters::isAvailable(Event event) const
+{
+    return fds[event] >= 0;
+}
+
+void PerfCounters::writeReport(std::ostream& out) const
+{
+    if (!active)
+        return;
+
+    out << "[Breakout] Hardware counters (" << frames << " frames, " << ticks
+        << " ticks, user space):\n"
+        << "  phase   per         cycles   instructions    IPC  cache-miss  branch-miss\n";
+
+    for (std::size_t i = 0; i < FRAME_PHASE_COUNT; ++i)
+    {
+        // The update phase steps the simulation zero or more ticks a frame,
+        // so its cost is only comparable per tick.
+        const bool    perTick  = static_cast<FramePhase>(i) == FramePhase::Update;
+        const double  count    = static_cast<double>(perTick ? ticks : frames);
+        const double  scale    = count > 0.0 ? 1.0 / count : 0.0;
+        const Values& total    = phaseTotals[i];
+        double ipc = total[Cycles]
+                   ? static_cast<double>(total[Instructions]) / static_cast<double>(total[Cycles])
+                   : 0.0;
+
+        out << "  " << std::left << std::setw(7) << framePhaseName(static_cast<FramePhase>(i))
+            << ' ' << std::setw(6) << (perTick ? "tick" : "frame")
+            << std::right << std::fixed
+            << std::setprecision(0)
+            << std::setw(12) << static_cast<double>(total[Cycles]) * scale;
+
+        if (isAvailable(Instructions))
+        {
+            out << std::setw(15) << static_cast<double>(total[Instructions]) * scale
+                << std::setprecision(2)
+                << std::setw(7)  << ipc;
+        }
+        else
+        {
+            out << std::setw(15) << "n/a" << std::setw(7) << "n/a";
+        }
+
+        out << std::setprecision(1);
+
+        if (isAvailable(CacheMisses))
+            out << std::setw(12) << static_cast<double>(total[CacheMisses]) * scale;
+        else
+            out << std::setw(12) << "n/a";
+
+        if (isAvailable(BranchMisses))
+            out << std::setw(13) << static_cast<double>(total[BranchMisses]) * scale;
+        else
+            out << std::setw(13) << "n/a";
+
+        out << '\n';
+    }
+}
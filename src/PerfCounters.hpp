@@ -0,0 +1,165 @@
+/**
+ * @file PerfCounters.hpp
+ * @brief Declaration of PerfCounters — hardware counters per frame phase.
+ *
+ * On Linux, PerfCounters opens a perf_event_open group counting CPU cycles,
+ * retired instructions, cache misses and branch mispredictions for the
+ * calling thread (user space only, so the default perf_event_paranoid level
+ * of 2 is sufficient).  The group is read at the start and end of each
+ * FramePhase and the deltas are accumulated per phase, which yields IPC and
+ * misses per tick for update (which may step several ticks in one frame)
+ * and per frame for events and render.
+ *
+ * Opening the counters can fail for many legitimate reasons — a stricter
+ * paranoid level, a container seccomp profile, a VM without a virtual PMU,
+ * or a non-Linux platform.  In every case open() prints a single warning and
+ * returns false; the object then stays inert and all methods are no-ops.
+ * Individual counters the CPU does not support are skipped and reported as
+ * unavailable rather than disabling the whole group.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+
+#include "FramePhase.hpp"
+
+/**
+ * @brief Optional hardware performance counter sampling.
+ */
+class PerfCounters
+{
+public:
+    /// Events counted by the group, in read-out order.
+    enum Event
+    {
+        Cycles,
+        Instructions,
+        CacheMisses,
+        BranchMisses,
+        EventCount
+    };
+
+    /// One value per Event.
+    using Values = std::array<std::uint64_t, EventCount>;
+
+    /**
+     * @brief RAII helper that measures one phase on a PerfCounters object.
+     */
+    class Scope
+    {
+    public:
+        /**
+         * @brief Reads the counters and remembers @p phase.
+         * @param counters  Counter group to sample (may be inactive).
+         * @param phase     Phase being measured.
+         */
+        Scope(PerfCounters& counters, FramePhase phase);
+
+        /// Reads the counters again and accumulates the delta.
+        ~Scope();
+
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        PerfCounters& counters; ///< Group being sampled.
+        FramePhase    phase;    ///< Phase the delta is charged to.
+    };
+
+    /// Constructs an inactive counter set; call open() to start counting.
+    PerfCounters();
+
+    /// Closes any open counter file descriptors.
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&)            = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /**
+     * @brief Opens the counter group for the calling thread.
+     *
+     * Prints a warning to stderr and returns false when hardware counters
+     * are unavailable; the object then remains inactive.
+     *
+     * @return true if at least the cycle counter is running.
+     */
+    bool open();
+
+    /**
+     * @brief Returns whether counters are open and being sampled.
+     * @return true after a successful open().
+     */
+    bool isActive() const;
+
+    /**
+     * @brief Records the start of @p phase.
+     * @param phase  Phase about to run.
+     */
+    void begin(FramePhase phase);
+
+    /**
+     * @brief Records the end of @p phase and accumulates its counter deltas.
+     * @param phase  Phase that just finished (must match the last begin()).
+     */
+    void end(FramePhase phase);
+
+    /**
+     * @brief Counts one completed frame and the simulation ticks it stepped.
+     *
+     * Update averages divide by the ticks, the other phases' by the frames.
+     *
+     * @param ticks  Ticks the frame's update phase stepped.
+     */
+    void endFrame(int ticks);
+
+    /**
+     * @brief Returns the accumulated counter totals for @p phase.
+     * @param phase  Phase to query.
+     * @return Values  Totals since open(); zero for unavailable events.
+     */
+    Values totals(FramePhase phase) const;
+
+    /**
+     * @brief Returns the number of frames counted by endFrame().
+     * @return std::uint64_t  Frame count.
+     */
+    std::uint64_t frameCount() const;
+
+    /**
+     * @brief Returns the number of ticks counted by endFrame().
+     * @return std::uint64_t  Tick count.
+     */
+    std::uint64_t tickCount() const;
+
+    /**
+     * @brief Returns whether the CPU supplied a counter for @p event.
+     * @param event  Event to query.
+     * @return true if the event is being counted.
+     */
+    bool isAvailable(Event event) const;
+
+    /**
+     * @brief Writes IPC and miss counts for every phase to @p out: per tick
+     *        for update, per frame for the others.
+     * @param out  Destination stream.
+     */
+    void writeReport(std::ostream& out) const;
+
+private:
+    /**
+     * @brief Reads the current value of every available counter.
+     * @param values  Receives the raw counter values.
+     * @return true if the read succeeded.
+     */
+    bool read(Values& values) const;
+
+    std::array<int, EventCount>           fds;        ///< Counter fds; -1 = unavailable.
+    bool                                  active;     ///< True after successful open().
+    Values                                phaseStart; ///< Values at the last begin().
+    std::array<Values, FRAME_PHASE_COUNT> phaseTotals;///< Accumulated deltas per phase.
+    std::uint64_t                         frames;     ///< Frames counted by endFrame().
+    std::uint64_t                         ticks;      ///< Ticks counted by endFrame().
+};
@@ -0,0 +1,71 @@
+/**
+ * @file Random.cpp
+ * @brief Implementation of the PCG32 Random generator.
+ */
+
+#include "Random.hpp"
+
+/// PCG reference LCG multiplier.
+static constexpr std::uint64_t PCG_MULTIPLIER = 6364136223846793005ULL;
+
+/// LCG increment (selects the stream; must be odd).
+static constexpr std::uint64_t PCG_INCREMENT = 1442695040888963407ULL;
+
+// -----------------------------------------------------------------------------
+// Construction
+// -----------------------------------------------------------------------------
+
+Random::Random(std::uint64_t seed)
+    : state(0)
+    , increment(PCG_INCREMENT)
+{
+    // Reference seeding procedure: advance, add the seed, advance again.
+    next();
+    state += seed;
+    next();
+}
+
+// -----------------------------------------------------------------------------
+// Draws
+// -----------------------------------------------------------------------------
+
+std::uint32_t Random::next()
+{
+    std::uint64_t old = state;
+    state = old * PCG_MULTIPLIER + increment;
+
+    // XSH-RR output permutation.
+    std::uint32_t xorShifted = static_cast<std::uint32_t>(((old >> 18u) ^ old) >> 27u);
+    std::uint32_t rotation   = static_cast<std::uint32_t>(old >> 59u);
+    return (xorShifted >> rotation) | (xorShifted << ((0u - rotation) & 31u));
+}
+
+std::uint32_t Random::below(std::uint32_t bound)
+{
+    std::uint64_t product = static_cast<std::uint64_t>(next()) * bound;
+    std::uint32_t low     = static_cast<std::uint32_t>(product);
+
+    if (low < bound)
+    {
+        // Reject the few products that would bias the result.
+        std::uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold)
+        {
+            product = static_cast<std::uint64_t>(next()) * bound;
+            low     = static_cast<std::uint32_t>(product);
+        }
+    }
+    return static_cast<std::uint32_t>(product >> 32);
+}
+
+std::uint64_t Random::getState() const
+{
+    return state;
+}
+
+float Random::uniform(float low, float high)
+{
+    // 24 random bits fill a float mantissa exactly.
+    float unit = static_cast<float>(next() >> 8) * (1.0f / 16777216.0f);
+    return low + (high - low) * unit;
+}
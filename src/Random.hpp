@@ -0,0 +1,64 @@
+/**
+ * @file Random.hpp
+ * @brief Declaration of Random — a small, seedable PCG32 generator.
+ *
+ * Every source of randomness in a game is an explicit Random object owned by
+ * whoever needs it (the Simulation, the Autopilot), never process-global
+ * state.  Two generators created with the same seed produce the same
+ * sequence on every platform, so any number of simulations can run side by
+ * side in one process and each stays reproducible from its seed.
+ *
+ * The generator is PCG-XSH-RR 64/32 (O'Neill, 2014): 16 bytes of state,
+ * a multiply and a few shifts per draw, and statistically far better than
+ * std::rand.  It is trivially copyable, so copying a Random captures its
+ * exact position in the sequence.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Deterministic 32-bit pseudo-random number generator.
+ */
+class Random
+{
+public:
+    /**
+     * @brief Seeds the generator.
+     * @param seed  Any value; equal seeds give equal sequences.
+     */
+    explicit Random(std::uint64_t seed = 0);
+
+    /**
+     * @brief Returns the next 32 random bits.
+     * @return std::uint32_t  Uniformly distributed value.
+     */
+    std::uint32_t next();
+
+    /**
+     * @brief Returns a uniformly distributed integer in [0, @p bound).
+     *
+     * Unbiased (Lemire's multiply-and-reject method).
+     *
+     * @param bound  Exclusive upper bound; must be non-zero.
+     * @return std::uint32_t  Value in [0, bound).
+     */
+    std::uint32_t below(std::uint32_t bound);
+
+    /**
+     * @brief Returns a uniformly distributed float in [@p low, @p high).
+     * @param low   Inclusive lower bound.
+     * @param high  Exclusive upper bound.
+     * @return float  Value in [low, high).
+     */
+    float uniform(float low, float high);
+
+    /// @return Internal state, which fully determines the remaining sequence
+    ///         (for state hashing).
+    std::uint64_t getState() const;
+
+private:
+    std::uint64_t state;     ///< Internal LCG state.
+    std::uint64_t increment; ///< LCG stream selector (always odd).
+};
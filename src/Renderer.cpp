@@ -0,0 +1,585 @@
+/**
+ * @file Renderer.cpp
+ * @brief Implementation of the Renderer class.
+ */
+
+#include "Renderer.hpp"
+#include "BuiltInLevels.hpp"
+#include "constants.hpp"
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithm>  // std::min, std::max
+#include <sstream>    // std::ostringstream
+
+// =============================================================================
+// Construction
+// =============================================================================
+
+Renderer::Renderer(const sf::Font& font)
+    : font(font)
+    , brickVertices(sf::Quads)
+{
+}
+
+// =============================================================================
+// Frame rendering
+// =============================================================================
+
+void Renderer::render(sf::RenderTarget& target, const Simulation& sim, GameState screen,
+                      const Simulation* ghost) const
+{
+    // Deep navy background.
+    target.clear(sf::Color(12, 12, 28));
+
+    // The world is drawn through the caller's view (which may letterbox)
+    // scrolled by the camera; the HUD and overlays stay fixed on screen.
+    const sf::View screenView = target.getView();
+    const float    cameraTop  = getCameraTop(sim);
+    sf::View       camera     = screenView;
+    camera.setCenter(screenView.getCenter().x, screenView.getCenter().y + cameraTop);
+    target.setView(camera);
+
+    // Draw all game objects even behind overlays so the background is visible.
+    drawBricks(target, sim, sf::FloatRect(0.0f, cameraTop,
+                                          static_cast<float>(Constants::WINDOW_WIDTH),
+                                          static_cast<float>(Constants::WINDOW_HEIGHT)));
+
+    // The ghost goes beneath the live paddle and ball so they stay readable
+    // where the two overlap.
+    if (ghost)
+        drawGhost(target, *ghost);
+
+    sim.getPaddle().draw(target);
+    sim.getBall().draw(target);
+
+    target.setView(screenView);
+
+    // HUD is always shown except on the main menu and controls screen
+    // (neither has an active game to report on).
+    if (screen != GameState::MainMenu && screen != GameState::Controls)
+        drawHUD(target, sim);
+
+    // State-specific overlays and hints.
+    switch (screen)
+    {
+    case GameState::MainMenu:
+    case GameState::Paused:
+    case GameState::LevelComplete:
+    case GameState::GameOver:
+    case GameState::Victory:
+        drawStateOverlay(target, sim, screen);
+        break;
+
+    case GameState::Controls:
+        drawControlsScreen(target);
+        break;
+
+    case GameState::BallOnPaddle:
+    {
+        // Small instruction hint at the very bottom of the screen.
+        sf::Text hint = makeText("Press SPACE to launch",
+                                 Constants::FONT_SIZE_SMALL,
+                                 sf::Color(180, 180, 180));
+        centreTextHorizontally(hint,
+            static_cast<float>(Constants::WINDOW_HEIGHT) - 26.0f);
+        target.draw(hint);
+        break;
+    }
+
+    case GameState::Playing:
+        // Active gameplay: no overlay.
+        break;
+    }
+}
+
+float Renderer::getCameraTop(const Simulation& sim)
+{
+    const float fieldTop = sim.getLayout().getTop();
+    if (fieldTop >= 0.0f)
+        return 0.0f;
+
+    const float follow = sim.getBall().getPosition().y - CAMERA_BALL_Y;
+    return std::min(0.0f, std::max(fieldTop, follow));
+}
+
+// =============================================================================
+// Render helpers
+// =============================================================================
+
+void Renderer::drawBricks(sf::RenderTarget& target, const Simulation& sim, const sf::FloatRect& view) const
+{
+    // Thin dark outline to separate adjacent bricks visually.
+    static constexpr float OUTLINE = Brick::OUTLINE_THICKNESS;
+    static const sf::Color OUTLINE_COLOR(20, 20, 20, 200);
+    static const sf::Color EXPLOSIVE_CORE_COLOR(20, 20, 20, 220);
+    static const sf::Color DEADLINE_COLOR(220, 45, 45, 110);
+
+    const std::vector<Brick>&        bricks    = sim.getBricks();
+    const std::vector<std::uint8_t>& hitPoints = sim.getBrickHitPoints();
+
+    auto addQuad = [this](float left, float top, float width, float height, sf::Color color)
+    {
+        brickVertices.append(sf::Vertex({ left,         top          }, color));
+        brickVertices.append(sf::Vertex({ left + width, top          }, color));
+        brickVertices.append(sf::Vertex({ left + width, top + height }, color));
+        brickVertices.append(sf::Vertex({ left,         top + height }, color));
+    };
+
+    auto addBrick = [&](const Brick& brick, float x, float y, std::uint8_t remaining)
+    {
+        // The outline is a slightly larger quad beneath the fill.
+        addQuad(x - OUTLINE, y - OUTLINE,
+                brick.width + 2.0f * OUTLINE, brick.height + 2.0f * OUTLINE, OUTLINE_COLOR);
+        addQuad(x, y, brick.width, brick.height, brick.getColor(remaining));
+
+        // Explosive bricks carry a dark square core.
+        if (brick.type == BrickType::Explosive)
+        {
+            const float core = 0.4f * std::min(brick.width, brick.height);
+            addQuad(x + 0.5f * (brick.width - core), y + 0.5f * (brick.height - core),
+                    core, core, EXPLOSIVE_CORE_COLOR);
+        }
+    };
+
+    // clear() keeps both arrays' storage, so after the first frame of the
+    // largest view this allocates nothing.
+    sim.getLayout().cullBricks(view, visibleBricks);
+    brickVertices.clear();
+    for (std::uint32_t i : visibleBricks)
+    {
+        if (hitPoints[i] != 0)
+            addBrick(bricks[i], bricks[i].x, bricks[i].y, hitPoints[i]);
+    }
+
+    // Moving bricks, where they are this tick, over the others.
+    const MovingBricks& moving = sim.getMovingBricks();
+    if (moving.getCount() != 0)
+    {
+        moving.findOverlapping(view, visibleBricks);
+        for (std::uint32_t mover : visibleBricks)
+        {
+            const std::uint32_t i      = moving.getBrick(mover);
+            const sf::Vector2f  offset = moving.getOffset(mover);
+            if (hitPoints[i] != 0)
+                addBrick(bricks[i], bricks[i].x + offset.x, bricks[i].y + offset.y, hitPoints[i]);
+        }
+    }
+
+    // Endless rows where the field has slid them to, and the line they
+    // must not reach.
+    if (const EndlessField* endless = sim.getEndlessField())
+    {
+        endless->findOverlapping(view, visibleBricks);
+        for (std::uint32_t i : visibleBricks)
+        {
+            if (hitPoints[i] != 0)
+            {
+                const Brick brick = endless->getBrick(i);
+                addBrick(brick, brick.x, brick.y, hitPoints[i]);
+            }
+        }
+        addQuad(0.0f, EndlessField::DEADLINE, static_cast<float>(Constants::WINDOW_WIDTH), 2.0f, DEADLINE_COLOR);
+    }
+    target.draw(brickVertices);
+}
+
+void Renderer::drawGhost(sf::RenderTarget& target, const Simulation& ghost) const
+{
+    const sf::Color fill(200, 220, 255, 60);
+    const sf::Color outline(200, 220, 255, 140);
+
+    const sf::FloatRect paddleBounds = ghost.getPaddle().getBounds();
+    sf::RectangleShape paddle(sf::Vector2f(paddleBounds.width, paddleBounds.height));
+    paddle.setPosition(paddleBounds.left, paddleBounds.top);
+    paddle.setFillColor(fill);
+    paddle.setOutlineColor(outline);
+    paddle.setOutlineThickness(-1.5f);
+    target.draw(paddle);
+
+    const float radius = ghost.getBall().getRadius();
+    sf::CircleShape ball(radius);
+    ball.setOrigin(radius, radius);
+    ball.setPosition(ghost.getBall().getPosition());
+    ball.setFillColor(fill);
+    ball.setOutlineColor(outline);
+    ball.setOutlineThickness(-1.5f);
+    target.draw(ball);
+}
+
+void Renderer::drawHUD(sf::RenderTarget& target, const Simulation& sim) const
+{
+    std::ostringstream oss;
+
+    // ---- Score (left-aligned) ----
+    oss << "Score: " << sim.getScore();
+    sf::Text scoreText = makeText(oss.str(), Constants::FONT_SIZE_MEDIUM, sf::Color::White);
+    scoreText.setPosition(10.0f, 4.0f);
+    target.draw(scoreText);
+
+    // ---- Level (centred) ----
+    oss.str("");
+    oss << "Level: " << sim.getLevel();
+    sf::Text levelText = makeText(oss.str(), Constants::FONT_SIZE_MEDIUM, sf::Color::White);
+    centreTextHorizontally(levelText, 4.0f);
+    target.draw(levelText);
+
+    // ---- Life indicators – small circles at the bottom-right ----
+    float indicatorDiameter = Constants::LIFE_INDICATOR_RADIUS * 2.0f;
+    float totalIndicatorWidth =
+        static_cast<float>(Constants::INITIAL_LIVES) * indicatorDiameter +
+        static_cast<float>(Constants::INITIAL_LIVES - 1) * Constants::LIFE_INDICATOR_GAP;
+
+    float indicatorStartX =
+        static_cast<float>(Constants::WINDOW_WIDTH) - totalIndicatorWidth - 10.0f;
+    float indicatorY =
+        static_cast<float>(Constants::WINDOW_HEIGHT) - indicatorDiameter - 6.0f;
+
+    for (int i = 0; i < Constants::INITIAL_LIVES; ++i)
+    {
+        sf::CircleShape lifeCircle(Constants::LIFE_INDICATOR_RADIUS);
+        lifeCircle.setOrigin(Constants::LIFE_INDICATOR_RADIUS,
+                             Constants::LIFE_INDICATOR_RADIUS);
+
+        // Fill only the circles representing lives the player still has.
+        if (i < sim.getLives())
+        {
+            lifeCircle.setFillColor(sf::Color::White);
+            lifeCircle.setOutlineColor(sf::Color(180, 180, 180));
+        }
+        else
+        {
+            lifeCircle.setFillColor(sf::Color::Transparent);
+            lifeCircle.setOutlineColor(sf::Color(90, 90, 90));
+        }
+        lifeCircle.setOutlineThickness(1.5f);
+
+        float x = indicatorStartX +
+                  static_cast<float>(i) *
+                  (indicatorDiameter + Constants::LIFE_INDICATOR_GAP) +
+                  Constants::LIFE_INDICATOR_RADIUS;
+
+        lifeCircle.setPosition(x, indicatorY + Constants::LIFE_INDICATOR_RADIUS);
+        target.draw(lifeCircle);
+    }
+}
+
+void Renderer::drawStateOverlay(sf::RenderTarget& target, const Simulation& sim,
+                                GameState screen) const
+{
+    // Semi-transparent dark backdrop so game objects are still faintly visible.
+    sf::RectangleShape backdrop(
+        sf::Vector2f(static_cast<float>(Constants::WINDOW_WIDTH),
+                     static_cast<float>(Constants::WINDOW_HEIGHT)));
+    backdrop.setFillColor(sf::Color(0, 0, 0, 170));
+    target.draw(backdrop);
+
+    float midY = static_cast<float>(Constants::WINDOW_HEIGHT) * 0.5f;
+
+    switch (screen)
+    {
+    // ---- Main Menu ----
+    case GameState::MainMenu:
+    {
+        sf::Text title = makeText("BREAKOUT", Constants::FONT_SIZE_LARGE, sf::Color::Yellow);
+        centreTextHorizontally(title, midY - 90.0f);
+        target.draw(title);
+
+        sf::Text startPrompt = makeText("Press SPACE to start",
+                                        Constants::FONT_SIZE_MEDIUM,
+                                        sf::Color::White);
+        centreTextHorizontally(startPrompt, midY - 15.0f);
+        target.draw(startPrompt);
+
+        sf::Text controlsHint = makeText("Press H for controls",
+                                          Constants::FONT_SIZE_MEDIUM,
+                                          sf::Color(100, 220, 255));
+        centreTextHorizontally(controlsHint, midY + 25.0f);
+        target.draw(controlsHint);
+
+        sf::Text quitHint = makeText("ESC to quit",
+                                      Constants::FONT_SIZE_SMALL,
+                                      sf::Color(130, 130, 130));
+        centreTextHorizontally(quitHint, midY + 68.0f);
+        target.draw(quitHint);
+        break;
+    }
+
+    // ---- Paused ----
+    case GameState::Paused:
+    {
+        sf::Text pauseLabel = makeText("PAUSED", Constants::FONT_SIZE_LARGE, sf::Color::Cyan);
+        centreTextHorizontally(pauseLabel, midY - 50.0f);
+        target.draw(pauseLabel);
+
+        sf::Text resumeHint = makeText("P — Resume",
+                                       Constants::FONT_SIZE_MEDIUM,
+                                       sf::Color::White);
+        centreTextHorizontally(resumeHint, midY + 10.0f);
+        target.draw(resumeHint);
+
+        sf::Text controlsHint = makeText("H — Controls",
+                                          Constants::FONT_SIZE_MEDIUM,
+                                          sf::Color(100, 220, 255));
+        centreTextHorizontally(controlsHint, midY + 42.0f);
+        target.draw(controlsHint);
+        break;
+    }
+
+    // ---- Level Complete ----
+    case GameState::LevelComplete:
+    {
+        std::string message = "Level " + std::to_string(sim.getLevel()) + " Complete!";
+        sf::Text levelDone = makeText(message, Constants::FONT_SIZE_LARGE, sf::Color::Green);
+        centreTextHorizontally(levelDone, midY - 30.0f);
+        target.draw(levelDone);
+
+        sf::Text nextLevel = makeText("Get ready for level " + std::to_string(sim.getLevel() + 1) + "...",
+                                      Constants::FONT_SIZE_MEDIUM,
+                                      sf::Color(180, 255, 180));
+        centreTextHorizontally(nextLevel, midY + 25.0f);
+        target.draw(nextLevel);
+        break;
+    }
+
+    // ---- Game Over ----
+    case GameState::GameOver:
+    {
+        sf::Text gameOverLabel = makeText("GAME OVER",
+                                          Constants::FONT_SIZE_LARGE,
+                                          sf::Color(255, 60, 60));
+        centreTextHorizontally(gameOverLabel, midY - 65.0f);
+        target.draw(gameOverLabel);
+
+        std::ostringstream oss;
+        oss << "Final Score: " << sim.getScore();
+        sf::Text finalScore = makeText(oss.str(),
+                                       Constants::FONT_SIZE_MEDIUM,
+                                       sf::Color::White);
+        centreTextHorizontally(finalScore, midY - 5.0f);
+        target.draw(finalScore);
+
+        sf::Text restartHint = makeText("Press SPACE to restart",
+                                        Constants::FONT_SIZE_MEDIUM,
+                                        sf::Color(200, 200, 200));
+        centreTextHorizontally(restartHint, midY + 40.0f);
+        target.draw(restartHint);
+        break;
+    }
+
+    // ---- Victory ----
+    case GameState::Victory:
+    {
+        sf::Text victoryLabel = makeText("YOU WIN!",
+                                         Constants::FONT_SIZE_LARGE,
+                                         sf::Color::Yellow);
+        centreTextHorizontally(victoryLabel, midY - 65.0f);
+        target.draw(victoryLabel);
+
+        std::ostringstream oss;
+        oss << "Final Score: " << sim.getScore();
+        sf::Text finalScore = makeText(oss.str(),
+                                       Constants::FONT_SIZE_MEDIUM,
+                                       sf::Color::White);
+        centreTextHorizontally(finalScore, midY - 5.0f);
+        target.draw(finalScore);
+
+        sf::Text playAgainHint = makeText("Press SPACE to play again",
+                                          Constants::FONT_SIZE_MEDIUM,
+                                          sf::Color(200, 200, 200));
+        centreTextHorizontally(playAgainHint, midY + 40.0f);
+        target.draw(playAgainHint);
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+void Renderer::centreTextHorizontally(sf::Text& text, float y) const
+{
+    sf::FloatRect bounds = text.getGlobalBounds();
+    float x = (static_cast<float>(Constants::WINDOW_WIDTH) - bounds.width) * 0.5f;
+    text.setPosition(std::max(0.0f, x), y);
+}
+
+sf::Text Renderer::makeText(const std::string& content,
+                             unsigned int characterSize,
+                             sf::Color color) const
+{
+    sf::Text text;
+    text.setFont(font);
+    text.setString(content);
+    text.setCharacterSize(characterSize);
+    text.setFillColor(color);
+    return text;
+}
+
+void Renderer::drawControlsScreen(sf::RenderTarget& target) const
+{
+    // -------------------------------------------------------------------------
+    // Full-screen dark backdrop.
+    // -------------------------------------------------------------------------
+    sf::RectangleShape backdrop(
+        sf::Vector2f(static_cast<float>(Constants::WINDOW_WIDTH),
+                     static_cast<float>(Constants::WINDOW_HEIGHT)));
+    backdrop.setFillColor(sf::Color(0, 0, 0, 210));
+    target.draw(backdrop);
+
+    // Fixed column X positions for the two-column key / description layout.
+    const float keyColumnX  = 170.0f;   ///< Right-edge of the key-label column.
+    const float descColumnX = 210.0f;   ///< Left-edge of the description column.
+
+    // -------------------------------------------------------------------------
+    // Helper lambda: draw a key label (right-aligned to keyColumnX) and its
+    // description (left-aligned at descColumnX) on the same row.
+    // -------------------------------------------------------------------------
+    auto drawRow = [&](const std::string& keyLabel,
+                       const std::string& description,
+                       float y,
+                       sf::Color keyColor   = sf::Color(255, 220, 80),
+                       sf::Color descColor  = sf::Color(220, 220, 220))
+    {
+        sf::Text keyText = makeText(keyLabel, Constants::FONT_SIZE_SMALL, keyColor);
+        // Right-align the key label so all keys end at the same X.
+        float keyWidth = keyText.getGlobalBounds().width;
+        keyText.setPosition(keyColumnX - keyWidth, y);
+        target.draw(keyText);
+
+        sf::Text descText = makeText(description, Constants::FONT_SIZE_SMALL, descColor);
+        descText.setPosition(descColumnX, y);
+        target.draw(descText);
+    };
+
+    // -------------------------------------------------------------------------
+    // Helper lambda: draw a thin horizontal separator rule.
+    // -------------------------------------------------------------------------
+    auto drawRule = [&](float y)
+    {
+        sf::RectangleShape rule(sf::Vector2f(
+            static_cast<float>(Constants::WINDOW_WIDTH) - 120.0f, 1.0f));
+        rule.setFillColor(sf::Color(80, 80, 80));
+        rule.setPosition(60.0f, y);
+        target.draw(rule);
+    };
+
+    // -------------------------------------------------------------------------
+    // Helper lambda: draw a section header, left-aligned at keyColumnX.
+    // -------------------------------------------------------------------------
+    auto drawSectionHeader = [&](const std::string& title, float y)
+    {
+        sf::Text header = makeText(title, Constants::FONT_SIZE_SMALL,
+                                   sf::Color(140, 200, 255));
+        header.setPosition(keyColumnX - header.getGlobalBounds().width, y);
+        target.draw(header);
+    };
+
+    // =========================================================================
+    // Title
+    // =========================================================================
+    sf::Text titleText = makeText("CONTROLS", Constants::FONT_SIZE_LARGE, sf::Color::White);
+    centreTextHorizontally(titleText, 18.0f);
+    target.draw(titleText);
+
+    drawRule(72.0f);
+
+    // =========================================================================
+    // Section: Movement
+    // =========================================================================
+    float y = 84.0f;
+    drawSectionHeader("MOVEMENT", y);
+    y += 26.0f;
+    drawRow("\u2190 / A", "Move paddle left",  y);
+    y += 24.0f;
+    drawRow("\u2192 / D", "Move paddle right", y);
+
+    y += 34.0f;
+    drawRule(y);
+
+    // =========================================================================
+    // Section: Game controls
+    // =========================================================================
+    y += 12.0f;
+    drawSectionHeader("GAME", y);
+    y += 26.0f;
+    drawRow("Space", "Launch ball  /  Start  /  Restart", y);
+    y += 24.0f;
+    drawRow("P",     "Pause / Resume",                    y);
+    y += 24.0f;
+    drawRow("R (hold)", "Rewind",                         y);
+    y += 24.0f;
+    drawRow("H",     "Show / hide this screen",           y);
+    y += 24.0f;
+    drawRow("Esc",   "Close controls  /  Quit",           y);
+
+    y += 34.0f;
+    drawRule(y);
+
+    // =========================================================================
+    // Section: Scoring
+    // =========================================================================
+    y += 12.0f;
+    drawSectionHeader("SCORING", y);
+    y += 26.0f;
+
+    // One entry per brick row of the built-in levels.
+    struct ScoringEntry { sf::Color color; std::string label; int points; };
+    static const ScoringEntry scoringTable[] = {
+        { sf::Color(BuiltInLevels::ROWS[0].color), "Red    row", BuiltInLevels::ROWS[0].points },
+        { sf::Color(BuiltInLevels::ROWS[1].color), "Orange row", BuiltInLevels::ROWS[1].points },
+        { sf::Color(BuiltInLevels::ROWS[2].color), "Yellow row", BuiltInLevels::ROWS[2].points },
+        { sf::Color(BuiltInLevels::ROWS[3].color), "Green  row", BuiltInLevels::ROWS[3].points },
+        { sf::Color(BuiltInLevels::ROWS[4].color), "Blue   row", BuiltInLevels::ROWS[4].points },
+        { sf::Color(BuiltInLevels::ROWS[5].color), "Purple row", BuiltInLevels::ROWS[5].points },
+    };
+
+    const float dotRadius  = 5.0f;
+    const float rowSpacing = 22.0f;
+
+    for (const ScoringEntry& entry : scoringTable)
+    {
+        // Coloured dot matching the brick colour.
+        sf::CircleShape dot(dotRadius);
+        dot.setOrigin(dotRadius, dotRadius);
+        dot.setFillColor(entry.color);
+        dot.setPosition(keyColumnX - dotRadius * 2.0f - 2.0f,
+                        y + dotRadius + 1.0f);
+        target.draw(dot);
+
+        // Points value in key column colour.
+        std::string pointsStr = std::to_string(entry.points) + " pts";
+        sf::Text pointsText = makeText(pointsStr, Constants::FONT_SIZE_SMALL,
+                                       sf::Color(255, 220, 80));
+        float pw = pointsText.getGlobalBounds().width;
+        pointsText.setPosition(keyColumnX - dotRadius * 2.0f - 2.0f - pw - 6.0f, y);
+        target.draw(pointsText);
+
+        // Row label.
+        sf::Text labelText = makeText(entry.label, Constants::FONT_SIZE_SMALL,
+                                      sf::Color(220, 220, 220));
+        labelText.setPosition(descColumnX, y);
+        target.draw(labelText);
+
+        y += rowSpacing;
+    }
+
+    // Footnote explaining multi-hit bricks on higher levels.
+    y += 4.0f;
+    sf::Text footnote = makeText(
+        "Higher levels add hit points per brick; score = base x hit points.",
+        Constants::FONT_SIZE_SMALL - 2,
+        sf::Color(120, 120, 120));
+    centreTextHorizontally(footnote, y);
+    target.draw(footnote);
+
+    // =========================================================================
+    // Return hint at the bottom.
+    // =========================================================================
+    sf::Text returnHint = makeText("H or Esc  \u2014  Return",
+                                    Constants::FONT_SIZE_SMALL,
+                                    sf::Color(100, 220, 255));
+    centreTextHorizontally(returnHint,
+        static_cast<float>(Constants::WINDOW_HEIGHT) - 30.0f);
+    target.draw(returnHint);
+}
@@ -0,0 +1,165 @@
+/**
+ * @file Renderer.hpp
+ * @brief Declaration of the Renderer class — draws a Simulation.
+ *
+ * Renderer turns the state of a Simulation into draw calls on any
+ * sf::RenderTarget: the game window during normal play, or an
+ * sf::RenderTexture when rendering offscreen (benchmarks, exports).  It holds
+ * no game state of its own apart from a reference to the shared font.
+ *
+ * Levels taller than the window are viewed through a camera that scrolls
+ * vertically to follow the ball.  The camera is a function of the
+ * simulation alone (see getCameraTop()), so any frame renders the same no
+ * matter which frames were rendered before it, and only the bricks in view
+ * are drawn.
+ */
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "GameState.hpp"
+#include "Simulation.hpp"
+
+/**
+ * @brief Draws the playfield, HUD, and state overlays.
+ */
+class Renderer
+{
+public:
+    /**
+     * @brief Constructs a renderer that draws text with @p font.
+     *
+     * The font must outlive the renderer.  If it has not been loaded, text
+     * draws nothing and everything else renders normally.
+     *
+     * @param font  Shared font for all HUD and overlay text.
+     */
+    explicit Renderer(const sf::Font& font);
+
+    /**
+     * @brief Clears @p target and draws one complete frame.
+     *
+     * Draw order: background colour → bricks → ghost → paddle → ball → HUD
+     * → overlay.  The overlay is only drawn for non-playing states (menus,
+     * game-over, etc.).  The playfield is drawn through @p target's current
+     * view moved down by getCameraTop(), the HUD and overlays through the
+     * view itself, which is left as it was.  Does not call display(); the
+     * caller presents the frame.
+     *
+     * @param target  Window or offscreen texture to draw into.
+     * @param sim     Simulation whose state is drawn.
+     * @param screen  State that selects the overlay.  Usually
+     *                sim.getState(), or GameState::Controls while the
+     *                controls screen is open.
+     * @param ghost   Optional second simulation whose paddle and ball are
+     *                drawn translucently beneath sim's (see drawGhost()).
+     */
+    void render(sf::RenderTarget& target, const Simulation& sim, GameState screen,
+                const Simulation* ghost = nullptr) const;
+
+    /**
+     * @brief Returns the world y coordinate shown at the top of the window.
+     *
+     * 0 for levels the height of the window.  In taller levels the camera
+     * keeps the ball CAMERA_BALL_Y pixels from the top of the window, but
+     * never scrolls past either end of the playfield, so it rests on the
+     * paddle while the ball is low.
+     *
+     * @param sim  Simulation being drawn.
+     */
+    static float getCameraTop(const Simulation& sim);
+
+private:
+    /// Height in the window at which a scrolling camera holds the ball.
+    static constexpr float CAMERA_BALL_Y = 240.0f;
+
+    /**
+     * @brief Draws the live bricks of @p sim inside @p view in one draw call.
+     *
+     * The level's index lists the bricks in view (the moving bricks'
+     * index those of them in view, and an endless field its own, with its
+     * deadline), and each is two quads, outline then
+     * fill, appended to one vertex array, so the cost follows the bricks on
+     * screen and is one draw call per frame.
+     *
+     * @param view  Visible part of the world.
+     */
+    void drawBricks(sf::RenderTarget& target, const Simulation& sim, const sf::FloatRect& view) const;
+
+    /**
+     * @brief Draws @p ghost's paddle and ball as translucent outlines.
+     *
+     * Exactly two draw calls; the ghost's bricks, HUD and overlays are not
+     * drawn, so racing a recorded run costs next to nothing per frame.
+     */
+    void drawGhost(sf::RenderTarget& target, const Simulation& ghost) const;
+
+    /**
+     * @brief Draws the heads-up display: score (left), level (centre),
+     *        and life indicators (right).
+     */
+    void drawHUD(sf::RenderTarget& target, const Simulation& sim) const;
+
+    /**
+     * @brief Draws a semi-transparent overlay appropriate for @p screen.
+     *
+     * Used for the MainMenu, Paused, LevelComplete, GameOver, and Victory
+     * states.  Each state gets a dark backdrop plus a set of centred text
+     * strings with game-specific messaging.
+     */
+    void drawStateOverlay(sf::RenderTarget& target, const Simulation& sim,
+                          GameState screen) const;
+
+    /**
+     * @brief Draws the full-screen controls reference card.
+     *
+     * Shows every keyboard shortcut and the scoring table with colour-coded
+     * brick rows.
+     *
+     * Layout
+     * ------
+     * The screen is divided into three sections separated by faint horizontal
+     * rules: Movement, Game Controls, and Scoring.  Key labels are drawn in a
+     * fixed left column; descriptions in a fixed right column.  Brick-row
+     * score entries include a small filled circle in the matching brick colour.
+     */
+    void drawControlsScreen(sf::RenderTarget& target) const;
+
+    /**
+     * @brief Horizontally centres an sf::Text object within the window.
+     *
+     * Sets the text's X position so its bounding box is centred, and its Y
+     * position to @p y.
+     *
+     * @param text  Text object to reposition (string must already be set).
+     * @param y     Desired Y coordinate of the top of the text, in pixels.
+     */
+    void centreTextHorizontally(sf::Text& text, float y) const;
+
+    /**
+     * @brief Creates a configured sf::Text ready for rendering.
+     *
+     * Convenience factory that assigns the shared font, a character size, and
+     * a fill colour in a single call.
+     *
+     * @param content        The string to display.
+     * @param characterSize  Point size passed to sf::Text::setCharacterSize.
+     * @param color          Fill colour of the text glyphs.
+     * @return sf::Text  Fully initialised text object.
+     */
+    sf::Text makeText(const std::string& content,
+                      unsigned int characterSize,
+                      sf::Color color) const;
+
+    const sf::Font& font; ///< Shared font for all text rendering.
+
+    /// Brick quads of the current frame; kept to reuse its storage.
+    mutable sf::VertexArray brickVertices;
+
+    /// Indices of the bricks in view this frame; kept to reuse its storage.
+    mutable std::vector<std::uint32_t> visibleBricks;
+};
@@ -0,0 +1,807 @@
+/**
+ * @file Replay.cpp
+ * @brief Implementation of Replay encoding and ReplayPlayer.
+ */
+
+#include "Replay.hpp"
+#include "BuildInfo.hpp"
+#include "Hash.hpp"
+#include "Simulation.hpp"
+
+#include <algorithm> // std::equal, std::min, std::max, std::upper_bound
+#include <fstream>
+#include <iomanip>   // std::hex, std::setw, std::setfill
+#include <iostream>  // std::cerr
+#include <iterator>  // std::istreambuf_iterator
+#include <utility>   // std::move
+
+/// First version with a 16-bit state hash for every tick.
+static constexpr std::uint8_t FORMAT_VERSION_SHORT_HASHES = 9;
+
+/// First version with a level source.
+static constexpr std::uint8_t FORMAT_VERSION_LEVEL_SOURCE = 8;
+
+/// Last version with a 64-bit state hash for every tick; versions 7 and 8
+/// stored one every SPARSE_HASH_INTERVAL ticks instead.
+static constexpr std::uint8_t FORMAT_VERSION_TICK_HASHES = 6;
+
+/// Ticks between the state hashes of versions 7 and 8 (half a second).
+static constexpr std::uint32_t SPARSE_HASH_INTERVAL = Constants::TICK_RATE / 2;
+
+/// First version with a start tick (clips).
+static constexpr std::uint8_t FORMAT_VERSION_START_TICK = 4;
+
+/// Last version whose keyframes use an older snapshot layout (version 4: a
+/// brick count field and a fixed-size brick array; version 5: no brick
+/// clock).
+static constexpr std::uint8_t FORMAT_VERSION_OLD_SNAPSHOTS = 5;
+
+/// First version with state hashes (but no start tick).
+static constexpr std::uint8_t FORMAT_VERSION_HASHES = 3;
+
+/// First version with keyframes (but no state hashes).
+static constexpr std::uint8_t FORMAT_VERSION_KEYFRAMES = 2;
+
+/// Oldest version still accepted (no keyframes).
+static constexpr std::uint8_t FORMAT_VERSION_NO_KEYFRAMES = 1;
+
+/// Bytes per keyframe index entry (tick, offset, size).
+static constexpr std::size_t INDEX_ENTRY_BYTES = 12;
+
+/// Longest build id accepted when decoding.
+static constexpr std::uint32_t MAX_BUILD_ID_LENGTH = 256;
+
+// -----------------------------------------------------------------------------
+// Byte helpers
+// -----------------------------------------------------------------------------
+
+static void putU32(std::vector<std::uint8_t>& bytes, std::uint32_t value)
+{
+    for (int shift = 0; shift < 32; shift += 8)
+        bytes.push_back(static_cast<std::uint8_t>(value >> shift));
+}
+
+static void putU16(std::vector<std::uint8_t>& bytes, std::uint16_t value)
+{
+    bytes.push_back(static_cast<std::uint8_t>(value));
+    bytes.push_back(static_cast<std::uint8_t>(value >> 8));
+}
+
+static void putVarint(std::vector<std::uint8_t>& bytes, std::uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<std::uint8_t>(value));
+}
+
+namespace {
+
+/**
+ * @brief Bounds-checked reader over an encoded replay.
+ */
+class ByteReader
+{
+public:
+    ByteReader(const std::vector<std::uint8_t>& bytes, std::size_t end)
+        : bytes(bytes), end(end), pos(0) {}
+
+    bool u8(std::uint8_t& value)
+    {
+        if (pos >= end)
+            return false;
+        value = bytes[pos++];
+        return true;
+    }
+
+    bool u16(std::uint16_t& value)
+    {
+        std::uint8_t low, high;
+        if (!u8(low) || !u8(high))
+            return false;
+        value = static_cast<std::uint16_t>(low | (high << 8));
+        return true;
+    }
+
+    bool u64(std::uint64_t& value)
+    {
+        std::uint32_t low, high;
+        if (!u32(low) || !u32(high))
+            return false;
+        value = low | (static_cast<std::uint64_t>(high) << 32);
+        return true;
+    }
+
+    bool u32(std::uint32_t& value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            std::uint8_t byte;
+            if (!u8(byte))
+                return false;
+            value |= static_cast<std::uint32_t>(byte) << shift;
+        }
+        return true;
+    }
+
+    /// Reads an LEB128 varint; @p shift is the bit position to start at.
+    bool varint(std::uint32_t& value, int shift = 0)
+    {
+        std::uint8_t byte;
+        do
+        {
+            if (shift > 28 || !u8(byte))
+                return false;
+            value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        return true;
+    }
+
+    bool atEnd() const { return pos == end; }
+
+    std::size_t position() const { return pos; }
+
+    /// Moves to @p target; fails if it lies beyond the end.
+    bool seek(std::size_t target)
+    {
+        if (target > end)
+            return false;
+        pos = target;
+        return true;
+    }
+
+private:
+    const std::vector<std::uint8_t>& bytes;
+    std::size_t                      end;
+    std::size_t                      pos;
+};
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Replay
+// -----------------------------------------------------------------------------
+
+Replay::Replay(std::uint32_t seed, std::uint32_t levelSource)
+    : seed(seed)
+    , levelSource(levelSource)
+    , buildId(::buildId())
+    , startTick(0)
+    , tickCount(0)
+    , hashInterval(1)
+{
+}
+
+void Replay::reserveRuns(std::size_t count)
+{
+    runs.reserve(count);
+}
+
+void Replay::reserveKeyframes(std::size_t count)
+{
+    keyframes.reserve(count);
+    keyframeData.reserve(count * (GameSnapshot::fixedBytes() +
+                                  Constants::BRICK_ROWS * Constants::BRICK_COLS));
+}
+
+/// Number of state hashes, one every @p interval ticks, covering @p ticks
+/// ticks from the start tick.
+static std::uint32_t hashCountFor(std::uint32_t ticks, std::uint32_t interval)
+{
+    return (ticks + interval - 1) / interval;
+}
+
+void Replay::reserveStateHashes(std::size_t ticks)
+{
+    stateHashes.reserve(ticks);
+}
+
+void Replay::record(const Simulation& sim, InputMask input)
+{
+    stateHashes.push_back(foldHash16(sim.stateHash()));
+    if (sim.getTick() % KEYFRAME_INTERVAL == 0)
+        addKeyframe(sim);
+    append(input);
+}
+
+void Replay::finish(const Simulation& sim)
+{
+    addKeyframe(sim);
+}
+
+void Replay::addKeyframe(const Simulation& sim)
+{
+    const std::uint32_t tick = sim.getTick();
+    if (!keyframes.empty() && keyframes.back().tick >= tick)
+        return;
+
+    GameSnapshot snapshot = sim.snapshot();
+    Keyframe     keyframe = { tick,
+                              static_cast<std::uint32_t>(keyframeData.size()),
+                              static_cast<std::uint32_t>(snapshot.packedSize()) };
+    keyframeData.resize(keyframeData.size() + keyframe.size);
+    snapshot.pack(keyframeData.data() + keyframe.offset);
+    keyframes.push_back(keyframe);
+}
+
+void Replay::append(InputMask input)
+{
+    input &= Input::All;
+
+    if (!runs.empty() && runs.back().mask == input)
+        ++runs.back().length;
+    else
+        runs.push_back({ input, 1 });
+
+    ++tickCount;
+}
+
+void Replay::truncate(std::uint32_t ticks)
+{
+    ticks = std::max(ticks, startTick);
+    while (tickCount > ticks)
+    {
+        Run&          last   = runs.back();
+        std::uint32_t excess = tickCount - ticks;
+
+        if (last.length > excess)
+        {
+            last.length -= excess;
+            tickCount    = ticks;
+        }
+        else
+        {
+            tickCount -= last.length;
+            runs.pop_back();
+        }
+    }
+
+    if (stateHashes.size() > hashCountFor(ticks - startTick, hashInterval))
+        stateHashes.resize(hashCountFor(ticks - startTick, hashInterval));
+
+    // A keyframe at exactly `ticks` is still valid: it precedes that tick.
+    while (!keyframes.empty() && keyframes.back().tick > ticks)
+    {
+        keyframeData.resize(keyframes.back().offset);
+        keyframes.pop_back();
+    }
+}
+
+std::uint32_t Replay::getSeed() const
+{
+    return seed;
+}
+
+std::uint32_t Replay::getLevelSource() const
+{
+    return levelSource;
+}
+
+bool Replay::isPlayableOn(std::uint32_t source) const
+{
+    return levelSource == 0 || levelSource == source;
+}
+
+const std::string& Replay::getBuildId() const
+{
+    return buildId;
+}
+
+std::uint32_t Replay::getTickCount() const
+{
+    return tickCount;
+}
+
+std::uint32_t Replay::getStartTick() const
+{
+    return startTick;
+}
+
+const std::vector<Replay::Run>& Replay::getRuns() const
+{
+    return runs;
+}
+
+const std::vector<Replay::Keyframe>& Replay::getKeyframes() const
+{
+    return keyframes;
+}
+
+const std::vector<std::uint16_t>& Replay::getStateHashes() const
+{
+    return stateHashes;
+}
+
+std::uint32_t Replay::getHashInterval() const
+{
+    return hashInterval;
+}
+
+bool Replay::findFinalState(GameSnapshot& out) const
+{
+    return !keyframes.empty() && keyframes.back().tick == tickCount &&
+           findKeyframe(tickCount, out);
+}
+
+bool Replay::findKeyframe(std::uint32_t tick, GameSnapshot& out) const
+{
+    auto after = std::upper_bound(keyframes.begin(), keyframes.end(), tick,
+        [](std::uint32_t target, const Keyframe& keyframe) { return target < keyframe.tick; });
+    if (after == keyframes.begin())
+        return false;
+
+    const Keyframe& keyframe = *(after - 1);
+    return GameSnapshot::unpack(keyframeData.data() + keyframe.offset, keyframe.size, out);
+}
+
+void Replay::encode(std::vector<std::uint8_t>& bytes) const
+{
+    bytes.assign(MAGIC, MAGIC + sizeof(MAGIC));
+    bytes.push_back(FORMAT_VERSION);
+    putU32(bytes, seed);
+    putU32(bytes, levelSource);
+    putVarint(bytes, tickCount);
+    putVarint(bytes, startTick);
+    putVarint(bytes, static_cast<std::uint32_t>(buildId.size()));
+    bytes.insert(bytes.end(), buildId.begin(), buildId.end());
+    putVarint(bytes, static_cast<std::uint32_t>(runs.size()));
+
+    for (const Run& run : runs)
+    {
+        // Mask and the low three length bits share the first byte; longer
+        // runs continue as a varint.
+        std::uint32_t extra = run.length - 1;
+        std::uint8_t  first = static_cast<std::uint8_t>(run.mask | ((extra & 0x7) << 4));
+        extra >>= 3;
+        if (extra == 0)
+        {
+            bytes.push_back(first);
+        }
+        else
+        {
+            bytes.push_back(static_cast<std::uint8_t>(first | 0x80));
+            putVarint(bytes, extra);
+        }
+    }
+
+    // Hashes are all-or-nothing: a replay built with append(), or decoded
+    // from a version that hashed only every half second, has none.
+    const std::uint32_t hashCount = tickCount - startTick;
+    const bool          hashed    = hashInterval == 1 && stateHashes.size() == hashCount;
+    putVarint(bytes, hashed ? hashCount : 0);
+    if (hashed)
+    {
+        for (std::uint16_t hash : stateHashes)
+            putU16(bytes, hash);
+    }
+
+    // Keyframe snapshots, then their index, then where the index starts.
+    putVarint(bytes, static_cast<std::uint32_t>(keyframes.size()));
+    const std::uint32_t blobStart = static_cast<std::uint32_t>(bytes.size());
+    bytes.insert(bytes.end(), keyframeData.begin(), keyframeData.end());
+
+    const std::uint32_t indexOffset = static_cast<std::uint32_t>(bytes.size());
+    for (const Keyframe& keyframe : keyframes)
+    {
+        putU32(bytes, keyframe.tick);
+        putU32(bytes, blobStart + keyframe.offset);
+        putU32(bytes, keyframe.size);
+    }
+    putU32(bytes, indexOffset);
+
+    putU32(bytes, fnv1a(bytes.data(), bytes.size()));
+}
+
+/**
+ * @brief Reads the keyframe section and index of a version 2 replay.
+ *
+ * Snapshots are only checked with @p currentLayout; older ones are read to
+ * be skipped.  On success @p reader is positioned at @p bodyEnd.
+ */
+static bool decodeKeyframes(ByteReader& reader, const std::vector<std::uint8_t>& bytes,
+                            std::size_t bodyEnd, std::uint32_t startTick, std::uint32_t tickCount,
+                            bool currentLayout, std::vector<Replay::Keyframe>& keyframes,
+                            std::vector<std::uint8_t>& keyframeData, std::string& error)
+{
+    std::uint32_t count = 0;
+    if (!reader.varint(count) || bodyEnd < 4)
+    {
+        error = "malformed keyframe section";
+        return false;
+    }
+    const std::size_t blobStart = reader.position();
+
+    std::uint32_t indexOffset = 0;
+    for (std::size_t i = 0; i < 4; ++i)
+        indexOffset |= static_cast<std::uint32_t>(bytes[bodyEnd - 4 + i]) << (8 * i);
+
+    if (indexOffset < blobStart ||
+        static_cast<std::uint64_t>(indexOffset) + std::uint64_t(count) * INDEX_ENTRY_BYTES + 4 != bodyEnd)
+    {
+        error = "malformed keyframe index";
+        return false;
+    }
+
+    reader.seek(indexOffset);
+    keyframes.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        Replay::Keyframe keyframe;
+        reader.u32(keyframe.tick);
+        reader.u32(keyframe.offset);
+        reader.u32(keyframe.size);
+
+        GameSnapshot check;
+        bool inOrder   = keyframes.empty() || keyframes.back().tick < keyframe.tick;
+        bool inSection = keyframe.offset >= blobStart && keyframe.offset <= indexOffset &&
+                         keyframe.size <= indexOffset - keyframe.offset;
+        if (!inOrder || keyframe.tick < startTick || keyframe.tick > tickCount || !inSection ||
+            (currentLayout && (!GameSnapshot::unpack(bytes.data() + keyframe.offset, keyframe.size, check) ||
+                               check.tick != keyframe.tick)))
+        {
+            error = "malformed keyframe " + std::to_string(i);
+            return false;
+        }
+
+        // Offsets in memory are relative to keyframeData.
+        keyframe.offset -= static_cast<std::uint32_t>(blobStart);
+        keyframes.push_back(keyframe);
+    }
+    keyframeData.assign(bytes.begin() + static_cast<std::ptrdiff_t>(blobStart),
+                               bytes.begin() + static_cast<std::ptrdiff_t>(indexOffset));
+
+    std::uint32_t trailer;
+    reader.u32(trailer);
+    return true;
+}
+
+bool Replay::decode(const std::vector<std::uint8_t>& bytes, Replay& out, std::string& error)
+{
+    if (bytes.size() < sizeof(MAGIC) + 1 + 4 + 4 ||
+        !std::equal(MAGIC, MAGIC + sizeof(MAGIC), bytes.begin()))
+    {
+        error = "not a replay file";
+        return false;
+    }
+
+    const std::size_t bodyEnd = bytes.size() - 4;
+    std::uint32_t stored = 0;
+    for (std::size_t i = 0; i < 4; ++i)
+        stored |= static_cast<std::uint32_t>(bytes[bodyEnd + i]) << (8 * i);
+    if (stored != fnv1a(bytes.data(), bodyEnd))
+    {
+        error = "checksum mismatch (file is truncated or corrupt)";
+        return false;
+    }
+
+    ByteReader reader(bytes, bodyEnd);
+    std::uint8_t skip;
+    for (std::size_t i = 0; i < sizeof(MAGIC); ++i)
+        reader.u8(skip);
+
+    std::uint8_t version = 0;
+    reader.u8(version);
+    if (version < FORMAT_VERSION_NO_KEYFRAMES || version > FORMAT_VERSION)
+    {
+        error = "unsupported format version " + std::to_string(version);
+        return false;
+    }
+
+    Replay        replay;
+    std::uint32_t declaredTicks = 0;
+    std::uint32_t idLength      = 0;
+    std::uint32_t runCount      = 0;
+
+    if (!reader.u32(replay.seed) ||
+        (version >= FORMAT_VERSION_LEVEL_SOURCE && !reader.u32(replay.levelSource)) ||
+        !reader.varint(declaredTicks) ||
+        (version >= FORMAT_VERSION_START_TICK && !reader.varint(replay.startTick)) ||
+        replay.startTick > declaredTicks ||
+        !reader.varint(idLength) || idLength > MAX_BUILD_ID_LENGTH)
+    {
+        error = "malformed header";
+        return false;
+    }
+    replay.tickCount = replay.startTick;
+
+    replay.buildId.clear();
+    for (std::uint32_t i = 0; i < idLength; ++i)
+    {
+        std::uint8_t c;
+        if (!reader.u8(c))
+        {
+            error = "malformed header";
+            return false;
+        }
+        replay.buildId += static_cast<char>(c);
+    }
+
+    if (!reader.varint(runCount) || runCount > bodyEnd)
+    {
+        error = "malformed header";
+        return false;
+    }
+    replay.runs.reserve(runCount);
+
+    for (std::uint32_t i = 0; i < runCount; ++i)
+    {
+        std::uint8_t first;
+        if (!reader.u8(first))
+        {
+            error = "truncated input runs";
+            return false;
+        }
+
+        std::uint32_t extra = (first >> 4) & 0x7;
+        if ((first & 0x80) && !reader.varint(extra, 3))
+        {
+            error = "truncated input runs";
+            return false;
+        }
+
+        Run run = { static_cast<InputMask>(first & Input::All), extra + 1 };
+        if (run.length > declaredTicks)
+        {
+            error = "tick count does not match the input runs";
+            return false;
+        }
+        replay.runs.push_back(run);
+        replay.tickCount += run.length;
+    }
+
+    if (replay.tickCount != declaredTicks)
+    {
+        error = "tick count does not match the input runs";
+        return false;
+    }
+
+    if (version >= FORMAT_VERSION_HASHES)
+    {
+        // Older versions stored full 64-bit hashes, folded here to the
+        // 16 bits stored now; versions 7 and 8 only every half second.
+        const bool wide = version < FORMAT_VERSION_SHORT_HASHES;
+        if (wide && version > FORMAT_VERSION_TICK_HASHES)
+            replay.hashInterval = SPARSE_HASH_INTERVAL;
+
+        const std::uint32_t played    = replay.tickCount - replay.startTick;
+        const std::uint32_t expected  = hashCountFor(played, replay.hashInterval);
+        std::uint32_t       hashCount = 0;
+        if (!reader.varint(hashCount) || (hashCount != 0 && hashCount != expected) ||
+            std::uint64_t(hashCount) * (wide ? 8 : 2) > bodyEnd)
+        {
+            error = "malformed state hashes";
+            return false;
+        }
+        replay.stateHashes.reserve(hashCount);
+        for (std::uint32_t i = 0; i < hashCount; ++i)
+        {
+            std::uint64_t wideHash = 0;
+            std::uint16_t hash     = 0;
+            if (wide ? !reader.u64(wideHash) : !reader.u16(hash))
+            {
+                error = "truncated state hashes";
+                return false;
+            }
+            replay.stateHashes.push_back(wide ? foldHash16(wideHash) : hash);
+        }
+    }
+
+    if (version >= FORMAT_VERSION_KEYFRAMES &&
+        !decodeKeyframes(reader, bytes, bodyEnd, replay.startTick, replay.tickCount,
+                         version > FORMAT_VERSION_OLD_SNAPSHOTS, replay.keyframes,
+                         replay.keyframeData, error))
+    {
+        return false;
+    }
+
+    // Older snapshots cannot be restored; such replays still play, and
+    // seeking simulates from the start.
+    if (version <= FORMAT_VERSION_OLD_SNAPSHOTS)
+    {
+        if (replay.startTick > 0)
+        {
+            error = "clip was written by an older version of the game";
+            return false;
+        }
+        replay.keyframes.clear();
+        replay.keyframeData.clear();
+    }
+
+    // A clip can only be played from a keyframe at its first tick.
+    if (replay.startTick > 0 &&
+        (replay.keyframes.empty() || replay.keyframes.front().tick != replay.startTick))
+    {
+        error = "clip has no keyframe at its start tick";
+        return false;
+    }
+
+    if (!reader.atEnd())
+    {
+        error = "unexpected data after the input runs";
+        return false;
+    }
+
+    out = std::move(replay);
+    return true;
+}
+
+bool Replay::save(const std::string& path) const
+{
+    std::vector<std::uint8_t> bytes;
+    encode(bytes);
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(bytes.data()),
+               static_cast<std::streamsize>(bytes.size()));
+    if (!file)
+    {
+        std::cerr << "[Breakout] ERROR: Could not write replay \"" << path << "\".\n";
+        return false;
+    }
+    return true;
+}
+
+bool Replay::load(const std::string& path, std::uint32_t levelSource, Replay& out)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "[Breakout] ERROR: Could not open replay \"" << path << "\".\n";
+        return false;
+    }
+
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                                    std::istreambuf_iterator<char>());
+
+    std::string error;
+    Replay      replay;
+    if (!decode(bytes, replay, error))
+    {
+        std::cerr << "[Breakout] ERROR: Replay \"" << path << "\": " << error << ".\n";
+        return false;
+    }
+    if (!replay.isPlayableOn(levelSource))
+    {
+        std::cerr << "[Breakout] ERROR: Replay \"" << path << "\" was recorded on other levels "
+                     "(check --levels, --generate and --endless).\n";
+        return false;
+    }
+    out = std::move(replay);
+
+    if (out.buildId != ::buildId())
+    {
+        std::cerr << "[Breakout] WARNING: Replay \"" << path << "\" was recorded by build "
+                  << out.buildId << " (this is " << ::buildId()
+                  << "); it may play differently.\n";
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// ReplayPlayer
+// -----------------------------------------------------------------------------
+
+ReplayPlayer::ReplayPlayer(const Replay& replay)
+    : replay(replay)
+    , runIndex(0)
+    , runOffset(0)
+    , position(0)
+{
+}
+
+bool ReplayPlayer::isFinished() const
+{
+    return runIndex >= replay.getRuns().size();
+}
+
+InputMask ReplayPlayer::next()
+{
+    if (isFinished())
+        return 0;
+
+    const Replay::Run& run = replay.getRuns()[runIndex];
+    if (++runOffset >= run.length)
+    {
+        ++runIndex;
+        runOffset = 0;
+    }
+    ++position;
+    return run.mask;
+}
+
+std::uint32_t ReplayPlayer::getPosition() const
+{
+    return position;
+}
+
+void ReplayPlayer::seek(Simulation& sim, std::uint32_t tick)
+{
+    tick = std::min(std::max(tick, replay.getStartTick()), replay.getTickCount());
+
+    GameSnapshot keyframe;
+    if (!replay.findKeyframe(tick, keyframe) || !sim.restore(keyframe))
+        sim = Simulation(replay.getSeed(), sim.getLevelPack());
+
+    // Position the player at the simulation's tick, then play forward.
+    const std::vector<Replay::Run>& runs = replay.getRuns();
+    runIndex  = 0;
+    runOffset = 0;
+    position  = sim.getTick();
+    for (std::uint32_t skipped = replay.getStartTick(); runIndex < runs.size(); ++runIndex)
+    {
+        if (position - skipped < runs[runIndex].length)
+        {
+            runOffset = position - skipped;
+            break;
+        }
+        skipped += runs[runIndex].length;
+    }
+
+    while (position < tick)
+        sim.step(next());
+}
+
+bool ReplayPlayer::matchesRecording(const Simulation& sim) const
+{
+    // Replays of versions 7 and 8 have no hash for most ticks, which are
+    // not hashed here either.
+    const std::vector<std::uint16_t>& hashes   = replay.getStateHashes();
+    const std::uint32_t                tick     = sim.getTick();
+    const std::uint32_t                start    = replay.getStartTick();
+    const std::uint32_t                interval = replay.getHashInterval();
+    if (tick < start || (tick - start) % interval != 0)
+        return true;
+
+    const std::size_t index = (tick - start) / interval;
+    return index >= hashes.size() || hashes[index] == foldHash16(sim.stateHash());
+}
+
+void ReplayPlayer::reportDesync(const Simulation& sim, std::ostream& out) const
+{
+    const std::uint32_t tick     = sim.getTick();
+    const std::uint32_t interval = replay.getHashInterval();
+    const std::uint32_t index    = (tick - replay.getStartTick()) / interval;
+    const std::ios::fmtflags previousFlags = out.flags();
+
+    // The previous hash matched, so the state first differed after it.
+    const std::uint32_t earliest = index == 0 ? tick : tick - interval + 1;
+    if (earliest == tick)
+        out << "[Breakout] ERROR: Replay desynced at tick " << tick;
+    else
+        out << "[Breakout] ERROR: Replay desynced between ticks " << earliest << " and " << tick;
+    out << " (state hash "
+        << std::hex << std::setfill('0') << std::setw(4) << foldHash16(sim.stateHash())
+        << ", recorded " << std::setw(4)
+        << (index < replay.getStateHashes().size() ? replay.getStateHashes()[index] : 0)
+        << std::setfill(' ');
+    out.flags(previousFlags);
+    out << ").\n";
+
+    // Find the first keyframe at or after the desync and play a copy there.
+    const std::vector<Replay::Keyframe>& keyframes = replay.getKeyframes();
+    auto keyframe = std::lower_bound(keyframes.begin(), keyframes.end(), tick,
+        [](const Replay::Keyframe& entry, std::uint32_t target) { return entry.tick < target; });
+
+    GameSnapshot expected;
+    if (keyframe == keyframes.end() || !replay.findKeyframe(keyframe->tick, expected))
+    {
+        out << "  No later keyframe to compare fields against.\n";
+        return;
+    }
+
+    // Simulations are not copyable (an endless field owns a thread), but a
+    // snapshot carries everything that decides the ticks after it.
+    Simulation copy(sim.getSeed(), sim.getLevelPack());
+    copy.restore(sim.snapshot());
+    ReplayPlayer copyPlayer = *this;
+    while (copy.getTick() < keyframe->tick && !copyPlayer.isFinished())
+        copy.step(copyPlayer.next());
+
+    out << "  Fields differing from the recorded keyframe at tick " << keyframe->tick << ":\n";
+    if (GameSnapshot::writeDifferences(out, expected, copy.snapshot()) == 0)
+        out << "    (none; the states reconverged by then)\n";
+}
@@ -0,0 +1,372 @@
+/**
+ * @file Replay.hpp
+ * @brief Declaration of Replay and ReplayPlayer — recorded input sessions.
+ *
+ * A Replay is everything needed to reproduce a session exactly: the
+ * Simulation seed, the per-tick InputMask sequence, and the build that
+ * recorded it.  Because the simulation is deterministic, feeding the same
+ * inputs to a Simulation created with the same seed replays the same game.
+ * The levels are not stored, only which ones were played
+ * (LevelPack::getSource()), and a replay is only played on those.
+ *
+ * Storage
+ * -------
+ * Inputs are stored as runs of identical masks — held keys change a few
+ * times per second at most, so an hour of play (432 000 ticks) is typically
+ * a few thousand runs.  On disk each run is one byte when it is eight ticks
+ * or shorter, otherwise a varint continuation follows:
+ *
+ *   bits 0–3  InputMask
+ *   bits 4–6  low 3 bits of (run length − 1)
+ *   bit  7    set if more length bits follow as an LEB128 varint
+ *
+ * Keyframes
+ * ---------
+ * Every KEYFRAME_INTERVAL ticks the recorder also stores a packed
+ * GameSnapshot of the state before that tick.  Seeking restores the latest
+ * keyframe at or before the target and simulates only the remaining ticks
+ * (at most KEYFRAME_INTERVAL − 1), so any point of an hour-long replay is
+ * reached in a few milliseconds.  Keyframes cost about 2 KB per minute.
+ *
+ * State hashes
+ * ------------
+ * Before every tick the recorder also stores Simulation::stateHash() of the
+ * state, folded to 16 bits (foldHash16()).  Playback compares the hash of
+ * every tick with the recording, so a desync is reported at the first tick
+ * whose state differs rather than when the game visibly diverges, and the
+ * fields that differ are then listed at the next keyframe.  A differing
+ * state matches a folded hash by chance once in 65 536 ticks, so the
+ * reported tick is at worst a tick or two late.  Hashes cost 2 bytes per
+ * tick (about 860 KB per hour), a quarter of the full 64-bit hashes.
+ *
+ * Clips
+ * -----
+ * A replay normally starts at tick 0 of a fresh Simulation.  A clip cut
+ * from the middle of a session (see FlightRecorder) starts at a later tick
+ * instead, with a keyframe at exactly that tick; its runs and hashes cover
+ * only the ticks from there on.  Players begin a replay by seeking to
+ * getStartTick(), which handles both.
+ *
+ * File layout (all integers little-endian or varint):
+ *
+ *   "BRKR"  magic            u8   format version (9)
+ *   u32     seed             u32  level source
+ *   varint  end tick (tick count)
+ *   varint  start tick
+ *   varint  build-id length  bytes build id
+ *   varint  run count        runs (as above)
+ *   varint  hash count       u16 state hash per tick (or 0)
+ *   varint  keyframe count   packed snapshots, back to back
+ *   index   per keyframe:    u32 tick, u32 file offset, u32 size
+ *   u32     file offset of the index
+ *   u32     FNV-1a checksum of everything before it
+ *
+ * The index sits at the end so a reader can locate any keyframe from the
+ * last eight bytes without walking the runs.  Version 8 and older files
+ * stored 64-bit hashes, which are folded when loaded: one every half second
+ * in versions 8 and 7, which therefore only locate a desync to within half a
+ * second, and one every tick in versions 6 to 3.  Version 7 and older files
+ * (no level source) play on whichever levels they are given.  Version 5 and 4
+ * files (older snapshot layouts), version 3 files (no start tick), version
+ * 2 files (no hashes) and version 1 files (no hashes or keyframes) still
+ * load, except clips of versions 4 and 5.  Versions 1 and 2 play
+ * unverified, and the keyframes of versions before 6 are skipped, so
+ * seeking in them simulates from the start.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "GameSnapshot.hpp"
+#include "Input.hpp"
+#include "constants.hpp"
+
+class Simulation;
+
+/**
+ * @brief A recorded session: seed plus run-length-encoded inputs.
+ */
+class Replay
+{
+public:
+    /// A run of consecutive ticks with the same input.
+    struct Run
+    {
+        InputMask     mask;   ///< Input for every tick in the run.
+        std::uint32_t length; ///< Number of ticks (≥ 1).
+    };
+
+    /// Location of one keyframe in keyframeData.
+    struct Keyframe
+    {
+        std::uint32_t tick;   ///< Ticks played before the snapshot was taken.
+        std::uint32_t offset; ///< Start of the packed snapshot.
+        std::uint32_t size;   ///< Packed snapshot size in bytes.
+    };
+
+    /// Ticks between keyframes (five seconds of play).
+    static constexpr std::uint32_t KEYFRAME_INTERVAL = 5 * Constants::TICK_RATE;
+
+    /// File signature.
+    static constexpr std::uint8_t MAGIC[4] = { 'B', 'R', 'K', 'R' };
+
+    /// Version written by encode().
+    static constexpr std::uint8_t FORMAT_VERSION = 9;
+
+    /**
+     * @brief Creates an empty replay for a simulation seeded with @p seed.
+     *
+     * The build id is set to this build's buildId().
+     *
+     * @param seed         Seed the recorded Simulation was constructed with.
+     * @param levelSource  LevelPack::getSource() of its levels; 0 if unknown.
+     */
+    explicit Replay(std::uint32_t seed = 0, std::uint32_t levelSource = 0);
+
+    /**
+     * @brief Pre-allocates room for @p count runs.
+     *
+     * Call before recording so that append() does not allocate during play.
+     *
+     * @param count  Expected number of runs.
+     */
+    void reserveRuns(std::size_t count);
+
+    /**
+     * @brief Pre-allocates room for @p count keyframes.
+     *
+     * Like reserveRuns(), keeps record() from allocating during play.
+     *
+     * @param count  Expected number of keyframes.
+     */
+    void reserveKeyframes(std::size_t count);
+
+    /**
+     * @brief Pre-allocates room for @p ticks state hashes.
+     * @param ticks  Expected number of recorded ticks.
+     */
+    void reserveStateHashes(std::size_t ticks);
+
+    /**
+     * @brief Records the input of @p sim's next tick.
+     *
+     * Stores @p sim's folded state hash, and a keyframe when the tick is a
+     * multiple of KEYFRAME_INTERVAL, then appends @p input.  Call
+     * immediately before stepping @p sim with @p input.
+     *
+     * @param sim    Simulation about to be stepped.
+     * @param input  Mask it will be stepped with.
+     */
+    void record(const Simulation& sim, InputMask input);
+
+    /**
+     * @brief Stores @p sim's state after the last recorded tick.
+     *
+     * Call once recording ends, before save().  The final state is kept as a
+     * keyframe at the replay's last tick, so verifiers can compare the final
+     * score and state (see findFinalState()).
+     *
+     * @param sim  Simulation after stepping the last recorded input.
+     */
+    void finish(const Simulation& sim);
+
+    /**
+     * @brief Appends the input of the next tick without hash or keyframe.
+     * @param input  Mask passed to Simulation::step() for that tick.
+     */
+    void append(InputMask input);
+
+    /**
+     * @brief Discards every tick from @p ticks onwards.
+     *
+     * Used when the game rewinds: the recording then continues from the
+     * restored tick.  Hashes and keyframes after @p ticks are dropped too.  Does
+     * nothing if the replay is already that short.
+     *
+     * @param ticks  Number of ticks to keep.
+     */
+    void truncate(std::uint32_t ticks);
+
+    /// @return Seed of the recorded Simulation.
+    std::uint32_t getSeed() const;
+
+    /// @return LevelPack::getSource() of the recorded levels; 0 if unknown.
+    std::uint32_t getLevelSource() const;
+
+    /**
+     * @brief Returns whether the replay can be played on levels with
+     *        identity @p levelSource.
+     *
+     * Replays that do not know their levels can be played on any.
+     */
+    bool isPlayableOn(std::uint32_t levelSource) const;
+
+    /// @return Identifier of the build that recorded the replay.
+    const std::string& getBuildId() const;
+
+    /// @return Tick after the last recorded one (the number of recorded
+    ///         ticks, unless the replay is a clip).
+    std::uint32_t getTickCount() const;
+
+    /// @return First recorded tick; 0 unless the replay is a clip.
+    std::uint32_t getStartTick() const;
+
+    /// @return The recorded runs, in order.
+    const std::vector<Run>& getRuns() const;
+
+    /// @return The keyframe index, in tick order.
+    const std::vector<Keyframe>& getKeyframes() const;
+
+    /// @return Folded state hash before every getHashInterval()-th tick
+    ///         from getStartTick() on; empty for replays without hashes.
+    const std::vector<std::uint16_t>& getStateHashes() const;
+
+    /// @return Ticks between state hashes: 1, or half a second for
+    ///         replays loaded from format versions 7 and 8.
+    std::uint32_t getHashInterval() const;
+
+    /**
+     * @brief Finds the latest keyframe at or before @p tick.
+     * @param tick  Target tick.
+     * @param out   Receives the keyframe's snapshot.
+     * @return true if such a keyframe exists.
+     */
+    bool findKeyframe(std::uint32_t tick, GameSnapshot& out) const;
+
+    /**
+     * @brief Returns the state recorded by finish(), if any.
+     * @param out  Receives the final state.
+     * @return true if the replay ends with a final-state keyframe.
+     */
+    bool findFinalState(GameSnapshot& out) const;
+
+    /**
+     * @brief Writes the replay to @p path.
+     * @param path  Destination file.
+     * @return true on success; failures are reported to stderr.
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Reads a replay from @p path into @p out.
+     *
+     * Warns (but succeeds) if the replay was recorded by a different build,
+     * since gameplay changes may make it play differently.  Fails if it was
+     * recorded on other levels (see isPlayableOn()).
+     *
+     * @param path         Source file.
+     * @param levelSource  LevelPack::getSource() of the levels to play on.
+     * @param out          Receives the replay on success.
+     * @return true on success; failures are reported to stderr.
+     */
+    static bool load(const std::string& path, std::uint32_t levelSource, Replay& out);
+
+    /**
+     * @brief Serialises the replay into @p bytes (file format above).
+     * @param bytes  Receives the encoded replay.
+     */
+    void encode(std::vector<std::uint8_t>& bytes) const;
+
+    /**
+     * @brief Parses an encoded replay.
+     * @param bytes  Encoded replay.
+     * @param out    Receives the replay on success.
+     * @param error  Receives a description on failure.
+     * @return true on success.
+     */
+    static bool decode(const std::vector<std::uint8_t>& bytes, Replay& out, std::string& error);
+
+private:
+    /// Stores a keyframe of @p sim unless one exists for its tick already.
+    void addKeyframe(const Simulation& sim);
+
+    std::uint32_t    seed;      ///< Simulation seed.
+    std::uint32_t    levelSource; ///< Recorded levels; 0 if unknown.
+    std::string      buildId;   ///< Recording build (see BuildInfo.hpp).
+    std::uint32_t    startTick; ///< First recorded tick (clips only; else 0).
+    std::uint32_t    tickCount; ///< startTick plus the sum of all run lengths.
+    std::vector<Run> runs;      ///< Run-length-encoded inputs.
+
+    std::uint32_t    hashInterval; ///< Ticks between state hashes.
+
+    std::vector<std::uint16_t> stateHashes; ///< Folded hash before every hashInterval-th tick.
+    std::vector<Keyframe>      keyframes;   ///< Index into keyframeData.
+    std::vector<std::uint8_t>  keyframeData;///< Packed snapshots.
+};
+
+/**
+ * @brief Feeds a Replay's inputs back one tick at a time.
+ */
+class ReplayPlayer
+{
+public:
+    /**
+     * @brief Prepares playback of @p replay.
+     *
+     * Call seek(sim, replay.getStartTick()) with a Simulation constructed
+     * from the replay's seed before the first next().
+     *
+     * @param replay  Replay to play; must outlive the player.
+     */
+    explicit ReplayPlayer(const Replay& replay);
+
+    /// @return true once every recorded tick has been returned.
+    bool isFinished() const;
+
+    /**
+     * @brief Returns the input for the next tick.
+     * @return InputMask  Recorded input, or 0 after the end of the replay.
+     */
+    InputMask next();
+
+    /// @return Number of ticks already returned.
+    std::uint32_t getPosition() const;
+
+    /**
+     * @brief Moves playback to @p tick and brings @p sim there.
+     *
+     * Restores the nearest keyframe at or before @p tick (or a fresh
+     * Simulation when there is none) and steps the remaining ticks with the
+     * recorded inputs.  Targets outside the replay seek to its start or end;
+     * seeking to getStartTick() starts playback of any replay.
+     *
+     * @param sim   Simulation driven by this player.
+     * @param tick  Tick to seek to.
+     */
+    void seek(Simulation& sim, std::uint32_t tick);
+
+    /**
+     * @brief Compares @p sim with the recorded state hash of its tick.
+     *
+     * Call before stepping; @p sim must be the simulation this player drives.
+     *
+     * @param sim  Simulation at the player's position.
+     * @return true if the hashes match or the replay has none for the tick,
+     *         as for all but every getHashInterval()-th tick.
+     */
+    bool matchesRecording(const Simulation& sim) const;
+
+    /**
+     * @brief Describes a mismatch found by matchesRecording().
+     *
+     * Writes the tick, or for replays hashed less often the span of ticks
+     * since the last matching hash, in which the state first differed, and
+     * both hashes.  Only keyframes hold complete
+     * recorded states, so a copy of @p sim is played on to the next
+     * keyframe and every field that differs there is listed.
+     *
+     * @param sim  Simulation that failed matchesRecording().
+     * @param out  Stream receiving the report.
+     */
+    void reportDesync(const Simulation& sim, std::ostream& out) const;
+
+private:
+    const Replay& replay;    ///< Replay being played.
+    std::size_t   runIndex;  ///< Current run.
+    std::uint32_t runOffset; ///< Ticks already returned from the current run.
+    std::uint32_t position;  ///< Ticks already returned in total.
+};
@@ -0,0 +1,58 @@
+/**
+ * @file RewindBuffer.cpp
+ * @brief Implementation of the RewindBuffer class.
+ */
+
+#include "RewindBuffer.hpp"
+
+#include <algorithm> // std::max
+
+// -----------------------------------------------------------------------------
+// Construction
+// -----------------------------------------------------------------------------
+
+RewindBuffer::RewindBuffer(std::size_t capacity)
+    : slots(std::max<std::size_t>(capacity, 1))
+    , next(0)
+    , count(0)
+{
+}
+
+// -----------------------------------------------------------------------------
+// Operations
+// -----------------------------------------------------------------------------
+
+void RewindBuffer::push(const GameSnapshot& snapshot)
+{
+    slots[next] = snapshot;
+    next = (next + 1) % slots.size();
+    if (count < slots.size())
+        ++count;
+}
+
+bool RewindBuffer::pop(GameSnapshot& out)
+{
+    if (count == 0)
+        return false;
+
+    next = (next + slots.size() - 1) % slots.size();
+    out  = slots[next];
+    --count;
+    return true;
+}
+
+void RewindBuffer::clear()
+{
+    next  = 0;
+    count = 0;
+}
+
+std::size_t RewindBuffer::size() const
+{
+    return count;
+}
+
+std::size_t RewindBuffer::capacity() const
+{
+    return slots.size();
+}
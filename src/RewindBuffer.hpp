@@ -0,0 +1,61 @@
+/**
+ * @file RewindBuffer.hpp
+ * @brief Declaration of RewindBuffer — a ring of recent GameSnapshots.
+ *
+ * The buffer holds the most recent N snapshots in slots allocated at
+ * construction.  push() overwrites the oldest entry once the buffer is
+ * full and pop() returns the newest, so popping once per tick plays the
+ * recent past backwards.  Entries are copied into existing snapshots, so
+ * neither operation allocates once the slots (and the caller's snapshot)
+ * have held a level of the current size.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "GameSnapshot.hpp"
+
+/**
+ * @brief Fixed-capacity LIFO ring of snapshots.
+ */
+class RewindBuffer
+{
+public:
+    /**
+     * @brief Allocates room for @p capacity snapshots.
+     * @param capacity  Maximum snapshots kept (≥ 1).
+     */
+    explicit RewindBuffer(std::size_t capacity);
+
+    /**
+     * @brief Stores @p snapshot as the newest entry.
+     *
+     * Discards the oldest entry when the buffer is full.
+     *
+     * @param snapshot  State to remember.
+     */
+    void push(const GameSnapshot& snapshot);
+
+    /**
+     * @brief Removes the newest entry and copies it into @p out.
+     * @param out  Receives the snapshot.
+     * @return true if an entry was available; false if the buffer is empty.
+     */
+    bool pop(GameSnapshot& out);
+
+    /// Discards every entry.
+    void clear();
+
+    /// @return Number of snapshots currently held.
+    std::size_t size() const;
+
+    /// @return Maximum number of snapshots held.
+    std::size_t capacity() const;
+
+private:
+    std::vector<GameSnapshot> slots; ///< Storage, allocated once.
+    std::size_t               next;  ///< Slot the next push() writes.
+    std::size_t               count; ///< Valid entries, ending at next - 1.
+};
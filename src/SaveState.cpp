@@ -0,0 +1,206 @@
+/**
+ * @file SaveState.cpp
+ * @brief Implementation of save-state writing and memory-mapped loading.
+ */
+
+#include "SaveState.hpp"
+#include "Hash.hpp"
+
+#include <cstdio>   // std::remove, std::rename
+#include <cstring>  // std::memcpy, std::memcmp
+#include <iostream> // std::cerr
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BREAKOUT_HAVE_MMAP 1
+#else
+#include <fstream>
+#include <iterator> // std::istreambuf_iterator
+#endif
+
+using SaveState::Header;
+
+/// File signature.
+static const char MAGIC[4] = { 'B', 'R', 'K', 'S' };
+
+static_assert(sizeof(Header) == 24, "save-state header layout changed");
+
+// -----------------------------------------------------------------------------
+// Validation
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Checks an in-memory save image and copies it into @p out.
+ * @param data         File contents.
+ * @param size         File size in bytes.
+ * @param levelSource  Level source the save must have been made on.
+ * @param out          Receives the snapshot on success.
+ * @param error        Receives a description on failure.
+ * @return true if the image is a valid save of this layout and levels.
+ */
+static bool readImage(const std::uint8_t* data, std::size_t size, std::uint32_t levelSource,
+                      GameSnapshot& out, std::string& error)
+{
+    Header header;
+    if (size < sizeof(Header))
+    {
+        error = "not a save file";
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(Header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        error = "not a save file";
+        return false;
+    }
+    if (header.version != SaveState::FORMAT_VERSION ||
+        header.fixedBytes != GameSnapshot::fixedBytes())
+    {
+        error = "saved by an incompatible version of the game";
+        return false;
+    }
+    if (header.levelSource != levelSource)
+    {
+        error = "saved on other levels (check --levels, --generate and --endless)";
+        return false;
+    }
+    if (size != sizeof(Header) + std::uint64_t(header.fixedBytes) + header.brickCount)
+    {
+        error = "file size does not match its header (truncated save)";
+        return false;
+    }
+
+    const std::uint8_t* body     = data + sizeof(Header);
+    const std::size_t   bodySize = size - sizeof(Header);
+    if (fnv1a(body, bodySize) != header.checksum)
+    {
+        error = "checksum mismatch (file is corrupt)";
+        return false;
+    }
+
+    return GameSnapshot::unpack(body, bodySize, out);
+}
+
+// -----------------------------------------------------------------------------
+// Saving
+// -----------------------------------------------------------------------------
+
+bool SaveState::save(const std::string& path, const GameSnapshot& snapshot, std::uint32_t levelSource)
+{
+    std::vector<std::uint8_t> image(sizeof(Header) + snapshot.packedSize());
+    snapshot.pack(image.data() + sizeof(Header));
+
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version     = FORMAT_VERSION;
+    header.fixedBytes  = static_cast<std::uint32_t>(GameSnapshot::fixedBytes());
+    header.brickCount  = static_cast<std::uint32_t>(snapshot.brickHitPoints.size());
+    header.checksum    = fnv1a(image.data() + sizeof(Header), snapshot.packedSize());
+    header.levelSource = levelSource;
+    std::memcpy(image.data(), &header, sizeof(Header));
+
+    const std::string tempPath = path + ".tmp";
+    bool written = false;
+
+#ifdef BREAKOUT_HAVE_MMAP
+    int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0)
+    {
+        // Write the whole image, resuming after partial writes; the data
+        // must be on disk before the rename publishes it.
+        const std::uint8_t* bytes     = image.data();
+        std::size_t         remaining = image.size();
+        while (remaining > 0)
+        {
+            ssize_t n = ::write(fd, bytes, remaining);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                break;
+            bytes     += n;
+            remaining -= static_cast<std::size_t>(n);
+        }
+        written = (remaining == 0) && ::fsync(fd) == 0;
+        written = (::close(fd) == 0) && written;
+    }
+#else
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(image.data()),
+                   static_cast<std::streamsize>(image.size()));
+        file.flush();
+        written = static_cast<bool>(file);
+    }
+    // std::rename does not replace an existing file on every platform.
+    if (written)
+        std::remove(path.c_str());
+#endif
+
+    if (!written || std::rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        std::cerr << "[Breakout] ERROR: Could not write save file \"" << path << "\".\n";
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Loading
+// -----------------------------------------------------------------------------
+
+bool SaveState::load(const std::string& path, std::uint32_t levelSource, GameSnapshot& out)
+{
+    std::string error;
+    bool        ok = false;
+
+#ifdef BREAKOUT_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        std::cerr << "[Breakout] ERROR: Could not open save file \"" << path << "\".\n";
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        error = "not a save file";
+    }
+    else
+    {
+        std::size_t size    = static_cast<std::size_t>(info.st_size);
+        void*       mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            error = "could not map the file";
+        }
+        else
+        {
+            ok = readImage(static_cast<const std::uint8_t*>(mapping), size, levelSource, out, error);
+            ::munmap(mapping, size);
+        }
+    }
+    ::close(fd);
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "[Breakout] ERROR: Could not open save file \"" << path << "\".\n";
+        return false;
+    }
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                                    std::istreambuf_iterator<char>());
+    ok = readImage(bytes.data(), bytes.size(), levelSource, out, error);
+#endif
+
+    if (!ok)
+        std::cerr << "[Breakout] ERROR: Save file \"" << path << "\": " << error << ".\n";
+    return ok;
+}
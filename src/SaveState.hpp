@@ -0,0 +1,79 @@
+/**
+ * @file SaveState.hpp
+ * @brief Save-state files: a GameSnapshot on disk, resumed without parsing.
+ *
+ * A save-state is a fixed-layout binary image of a GameSnapshot in native
+ * byte order:
+ *
+ *   SaveState::Header   magic "BRKS", format version, layout size, brick
+ *                       count, FNV-1a checksum of everything after the
+ *                       header, level source (LevelPack::getSource())
+ *   fixed fields        the GameSnapshot up to brickHitPoints, byte for byte
+ *   hit points          one byte per brick (brickCount bytes)
+ *
+ * Brick damage is the only part that grows with the level, so it trails the
+ * fixed fields as a variable-length array.  Loading maps the file, validates
+ * the header and checksum, and copies the mapped bytes straight into the
+ * snapshot: no field-by-field decoding, so resume time is dominated by the
+ * checksum pass even for very large brick counts.
+ *
+ * Files are written to a temporary sibling and renamed into place, so a
+ * crash or power loss mid-save leaves either the old save or the new one,
+ * never a torn file.  Saves are only portable between builds with the same
+ * snapshot layout and byte order; anything else is rejected on load.  A save
+ * holds brick damage but not the bricks, so it is also rejected by a game
+ * playing other levels (another --levels directory, or --generate or
+ * --endless seed).
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "GameSnapshot.hpp"
+
+namespace SaveState
+{
+    /**
+     * @brief On-disk header preceding the snapshot bytes.
+     */
+    struct Header
+    {
+        char          magic[4];    ///< "BRKS".
+        std::uint32_t version;     ///< FORMAT_VERSION of the writer.
+        std::uint32_t fixedBytes;  ///< Size of the fixed snapshot fields.
+        std::uint32_t brickCount;  ///< Hit-point bytes after the fixed fields.
+        std::uint32_t checksum;    ///< FNV-1a of every byte after the header.
+        std::uint32_t levelSource; ///< LevelPack::getSource() of the saved game.
+    };
+
+    /// Bump whenever GameSnapshot's fields or the header change.
+    constexpr std::uint32_t FORMAT_VERSION = 4;
+
+    /**
+     * @brief Atomically writes @p snapshot to @p path.
+     *
+     * Writes `<path>.tmp`, flushes it to disk, then renames it over @p path.
+     *
+     * @param path         Destination file.
+     * @param snapshot     State to save.
+     * @param levelSource  LevelPack::getSource() of the game's levels.
+     * @return true on success; failures are reported to stderr.
+     */
+    bool save(const std::string& path, const GameSnapshot& snapshot, std::uint32_t levelSource);
+
+    /**
+     * @brief Maps @p path and copies the saved state into @p out.
+     *
+     * Rejects files with a different signature, version or layout, files
+     * whose checksum does not match (truncated or corrupted saves), and
+     * saves of other levels.  @p out is left untouched on failure.
+     *
+     * @param path         Source file.
+     * @param levelSource  LevelPack::getSource() of the levels to resume on.
+     * @param out          Receives the snapshot on success.
+     * @return true on success; failures are reported to stderr.
+     */
+    bool load(const std::string& path, std::uint32_t levelSource, GameSnapshot& out);
+}
@@ -0,0 +1,844 @@
+/**
+ * @file Simulation.cpp
+ * @brief Implementation of the Simulation class.
+ */
+
+#include "Simulation.hpp"
+#include "Hash.hpp"
+#include "constants.hpp"
+
+#include <algorithm>  // std::min, std::max
+#include <cmath>      // std::sqrt, std::sin, std::cos
+#include <cstring>    // std::memcpy
+#include <utility>    // std::move
+
+// =============================================================================
+// State hashing helpers
+// =============================================================================
+
+/// Packs two 32-bit values into one hash word.
+static std::uint64_t packWord(std::uint32_t low, std::uint32_t high)
+{
+    return static_cast<std::uint64_t>(low) | (static_cast<std::uint64_t>(high) << 32);
+}
+
+/// Bit pattern of @p value (hashing compares floats bit for bit).
+static std::uint32_t floatBits(float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// =============================================================================
+// Construction
+// =============================================================================
+
+Simulation::Simulation(std::uint32_t seed, std::shared_ptr<const LevelPack> levels)
+    : ball(
+        Constants::WINDOW_WIDTH  * 0.5f,
+        Constants::WINDOW_HEIGHT * 0.5f,
+        Constants::BALL_RADIUS)
+    , paddle(
+        (Constants::WINDOW_WIDTH  - Constants::PADDLE_WIDTH)  * 0.5f,
+        Constants::WINDOW_HEIGHT  - Constants::PADDLE_Y_OFFSET,
+        Constants::PADDLE_WIDTH,
+        Constants::PADDLE_HEIGHT,
+        Constants::PADDLE_SPEED)
+    , levels(std::move(levels))
+    , brickClock(0)
+    , endless(this->levels->isEndless() ? std::make_unique<EndlessField>(this->levels->getEndlessSeed()) : nullptr)
+    , state(GameState::MainMenu)
+    , score(0)
+    , lives(Constants::INITIAL_LIVES)
+    , level(1)
+    , ballSpeed(Constants::BALL_INITIAL_SPEED)
+    , levelCompleteTimer(0.0f)
+    , bricksRemaining(0)
+    , brickHash(0)
+    , tick(0)
+    , seed(seed)
+    , rng(seed)
+{
+    createBricks();
+    resetBallOnPaddle();
+
+    // resetBallOnPaddle() enters BallOnPaddle; the menu comes first.
+    state = GameState::MainMenu;
+}
+
+// =============================================================================
+// Tick entry point
+// =============================================================================
+
+void Simulation::step(InputMask input)
+{
+    ++tick;
+
+    applyCommands(input);
+
+    // Only run physics-related update() when there is meaningful activity.
+    switch (state)
+    {
+    case GameState::Playing:
+    case GameState::BallOnPaddle:
+        update(Constants::TICK_SECONDS, input);
+        break;
+
+    case GameState::LevelComplete:
+        // Tick the post-level celebration timer.
+        levelCompleteTimer -= Constants::TICK_SECONDS;
+        if (levelCompleteTimer <= 0.0f)
+            advanceLevel();
+        break;
+
+    default:
+        break;
+    }
+}
+
+void Simulation::restart()
+{
+    score     = 0;
+    lives     = Constants::INITIAL_LIVES;
+    level     = 1;
+    ballSpeed = Constants::BALL_INITIAL_SPEED;
+
+    // Re-centre the paddle.
+    paddle.setPositionX(
+        (static_cast<float>(Constants::WINDOW_WIDTH) - Constants::PADDLE_WIDTH) * 0.5f);
+
+    createBricks();
+    resetBallOnPaddle();
+}
+
+// =============================================================================
+// Snapshots
+// =============================================================================
+
+GameSnapshot Simulation::snapshot() const
+{
+    GameSnapshot out;
+    snapshot(out);
+    return out;
+}
+
+void Simulation::snapshot(GameSnapshot& out) const
+{
+    // Zeroed first so padding is too, which keeps identical states
+    // byte-identical.
+    out.reset();
+
+    out.ballX         = ball.getPosition().x;
+    out.ballY         = ball.getPosition().y;
+    out.ballVelocityX = ball.getVelocity().x;
+    out.ballVelocityY = ball.getVelocity().y;
+    out.ballMoving    = ball.isMoving();
+    out.paddleX       = paddle.getPositionX();
+
+    out.state              = state;
+    out.score              = score;
+    out.lives              = lives;
+    out.level              = level;
+    out.ballSpeed          = ballSpeed;
+    out.levelCompleteTimer = levelCompleteTimer;
+    out.bricksRemaining    = bricksRemaining;
+    out.brickClock         = brickClock;
+
+    out.tick = tick;
+    out.seed = seed;
+    out.rng  = rng;
+
+    out.brickHitPoints.assign(brickHitPoints.begin(), brickHitPoints.end());
+}
+
+bool Simulation::restore(const GameSnapshot& snapshot)
+{
+    // Brick positions, colours and points follow from the level and the
+    // clock; only the damage is stored, so it has to be for as many bricks
+    // as the layout has.  An endless game has one playfield, the ring,
+    // whatever its level.
+    const std::size_t layoutBricks = endless ? EndlessField::BRICK_COUNT
+                                   : snapshot.level == level
+                                   ? brickHitPoints.size()
+                                   : levels->getLevel(snapshot.level)->getInitialHitPoints().size();
+    if (snapshot.brickHitPoints.size() != layoutBricks)
+        return false;
+
+    if (snapshot.level != level && !endless)
+    {
+        level = snapshot.level;
+        createBricks();
+    }
+
+    std::copy(snapshot.brickHitPoints.begin(), snapshot.brickHitPoints.end(), brickHitPoints.begin());
+    rehashBricks();
+
+    ball.restore({ snapshot.ballX, snapshot.ballY },
+                 { snapshot.ballVelocityX, snapshot.ballVelocityY },
+                 snapshot.ballMoving);
+    paddle.setPositionX(snapshot.paddleX);
+
+    state              = snapshot.state;
+    score              = snapshot.score;
+    lives              = snapshot.lives;
+    level              = snapshot.level;
+    ballSpeed          = snapshot.ballSpeed;
+    levelCompleteTimer = snapshot.levelCompleteTimer;
+    bricksRemaining    = snapshot.bricksRemaining;
+    brickClock         = snapshot.brickClock;
+
+    if (moving.getCount() != 0)
+        moving.update(brickClock);
+    if (endless)
+        endless->seek(brickClock);
+
+    tick = snapshot.tick;
+    seed = snapshot.seed;
+    rng  = snapshot.rng;
+
+    if (state == GameState::LevelComplete)
+        levels->prefetch(level + 1);
+    return true;
+}
+
+void Simulation::reloadLevel()
+{
+    createBricks();
+}
+
+std::uint64_t Simulation::stateHash() const
+{
+    const sf::Vector2f position = ball.getPosition();
+    const sf::Vector2f velocity = ball.getVelocity();
+
+    // Small integers share a word: lives and flags fit a byte each and the
+    // level 16 bits.
+    const std::uint32_t counters = (static_cast<std::uint32_t>(lives) & 0xFFu) |
+                                   ((static_cast<std::uint32_t>(level) & 0xFFFFu) << 8) |
+                                   (static_cast<std::uint32_t>(state) << 24) |
+                                   (ball.isMoving() ? 0x80000000u : 0u);
+
+    // brickHash is already well mixed, so it can share the RNG's word.  The
+    // clock only matters while bricks move; leaving it out otherwise keeps
+    // the hashes of levels without moving bricks what they always were.
+    const std::uint64_t words[7] = {
+        packWord(floatBits(position.x), floatBits(position.y)),
+        packWord(floatBits(velocity.x), floatBits(velocity.y)),
+        packWord(floatBits(paddle.getPositionX()), floatBits(levelCompleteTimer)),
+        packWord(floatBits(ballSpeed), static_cast<std::uint32_t>(score)),
+        packWord(counters, static_cast<std::uint32_t>(bricksRemaining)),
+        rng.getState() ^ brickHash,
+        brickClock,
+    };
+    return hashWords(words, moving.getCount() != 0 || endless ? 7 : 6);
+}
+
+// =============================================================================
+// Accessors
+// =============================================================================
+
+const Ball& Simulation::getBall() const
+{
+    return ball;
+}
+
+const Paddle& Simulation::getPaddle() const
+{
+    return paddle;
+}
+
+const std::vector<Brick>& Simulation::getBricks() const
+{
+    return endless ? endless->getBricks() : layout->getBricks();
+}
+
+const Level& Simulation::getLayout() const
+{
+    return *layout;
+}
+
+const std::vector<std::uint8_t>& Simulation::getBrickHitPoints() const
+{
+    return brickHitPoints;
+}
+
+const MovingBricks& Simulation::getMovingBricks() const
+{
+    return moving;
+}
+
+const EndlessField* Simulation::getEndlessField() const
+{
+    return endless.get();
+}
+
+const std::shared_ptr<const LevelPack>& Simulation::getLevelPack() const
+{
+    return levels;
+}
+
+GameState Simulation::getState() const
+{
+    return state;
+}
+
+int Simulation::getScore() const
+{
+    return score;
+}
+
+int Simulation::getLives() const
+{
+    return lives;
+}
+
+int Simulation::getLevel() const
+{
+    return level;
+}
+
+int Simulation::getBricksRemaining() const
+{
+    return bricksRemaining;
+}
+
+std::uint64_t Simulation::getBrickHash() const
+{
+    return brickHash;
+}
+
+std::uint32_t Simulation::getTick() const
+{
+    return tick;
+}
+
+std::uint32_t Simulation::getSeed() const
+{
+    return seed;
+}
+
+// =============================================================================
+// Level management
+// =============================================================================
+
+void Simulation::createBricks()
+{
+    layout = levels->getLevel(level);
+
+    brickClock = 0;
+    moving.reset(*layout);
+
+    // A chain of explosions queues each explosive brick at most once, and
+    // no query lists more than its index holds, so play never grows the
+    // scratch lists.  Capacity only grows, whatever the order of levels.
+    std::size_t queryBricks = layout->getIndexSize();
+    if (endless)
+        queryBricks = std::max<std::size_t>(queryBricks, EndlessField::BRICK_COUNT);
+    nearbyBricks.reserve(queryBricks);
+    nearbyMovers.reserve(moving.getCount());
+    blastQueue.reserve(endless ? EndlessField::BRICK_COUNT : layout->getExplosiveCount());
+
+    if (endless)
+    {
+        // The rows bring their own bricks, at full health.
+        endless->seek(brickClock);
+        const std::vector<Brick>& bricks = endless->getBricks();
+        brickHitPoints.resize(bricks.size());
+        bricksRemaining = 0;
+        for (std::size_t i = 0; i < bricks.size(); ++i)
+        {
+            brickHitPoints[i] = bricks[i].hitPoints;
+            if (brickHitPoints[i] != 0)
+                ++bricksRemaining;
+        }
+        rehashBricks();
+        return;
+    }
+
+    // Every brick starts at full health.  The level carries that state
+    // ready-made, so switching levels costs a copy, not a pass over bricks.
+    brickHitPoints  = layout->getInitialHitPoints();
+    brickHash       = layout->getInitialBrickHash();
+    bricksRemaining = static_cast<int>(brickHitPoints.size());
+}
+
+void Simulation::rehashBricks()
+{
+    brickHash = 0;
+    for (std::size_t i = 0; i < brickHitPoints.size(); ++i)
+        brickHash ^= brickStateKey(i, brickHitPoints[i]);
+}
+
+void Simulation::resetBallOnPaddle()
+{
+    // Place the ball exactly on top of the paddle centre.
+    float ballX = paddle.getCentreX();
+    float ballY = paddle.getTopY() - Constants::BALL_RADIUS - 1.0f;
+    ball.reset(ballX, ballY);
+
+    state = GameState::BallOnPaddle;
+}
+
+void Simulation::advanceLevel()
+{
+    ++level;
+
+    // Increase ball speed, but never exceed the maximum.
+    ballSpeed = std::min(ballSpeed + Constants::BALL_SPEED_STEP, Constants::BALL_MAX_SPEED);
+
+    // Re-centre the paddle for the new level.
+    paddle.setPositionX(
+        (static_cast<float>(Constants::WINDOW_WIDTH) - Constants::PADDLE_WIDTH) * 0.5f);
+
+    createBricks();
+    resetBallOnPaddle();
+}
+
+void Simulation::enterRow()
+{
+    const std::uint32_t row = endless->getNewestRow();
+
+    // The row coming down onto the deadline as this one comes in costs a
+    // life if it has bricks left, which are then cleared without score.
+    if (row >= EndlessField::DEADLINE_ROWS)
+    {
+        const std::uint32_t start   = endless->getRowStart(row - EndlessField::DEADLINE_ROWS);
+        bool                reached = false;
+        for (std::uint32_t i = start; i < start + EndlessField::COLUMNS; ++i)
+        {
+            if (brickHitPoints[i] == 0)
+                continue;
+
+            reached    = true;
+            brickHash ^= brickStateKey(i, brickHitPoints[i]) ^ brickStateKey(i, 0);
+            brickHitPoints[i] = 0;
+            --bricksRemaining;
+        }
+
+        if (reached && --lives <= 0)
+        {
+            lives = 0;
+            state = GameState::GameOver;
+            return;
+        }
+    }
+
+    // The new row's slot held one that passed the deadline, so it has no
+    // bricks left; the count and hash are kept exact regardless.
+    const std::vector<Brick>& bricks = endless->getBricks();
+    const std::uint32_t       start  = endless->getRowStart(row);
+    for (std::uint32_t i = start; i < start + EndlessField::COLUMNS; ++i)
+    {
+        if (brickHitPoints[i] != 0)
+            --bricksRemaining;
+        brickHash ^= brickStateKey(i, brickHitPoints[i]);
+        brickHitPoints[i] = bricks[i].hitPoints;
+        brickHash ^= brickStateKey(i, brickHitPoints[i]);
+        if (brickHitPoints[i] != 0)
+            ++bricksRemaining;
+    }
+
+    if (row % EndlessField::ROWS_PER_LEVEL == 0)
+    {
+        ++level;
+        ballSpeed = std::min(ballSpeed + Constants::BALL_SPEED_STEP, Constants::BALL_MAX_SPEED);
+    }
+}
+
+// =============================================================================
+// Per-tick steps
+// =============================================================================
+
+void Simulation::applyCommands(InputMask input)
+{
+    if (input & Input::Launch)
+    {
+        if (state == GameState::MainMenu  ||
+            state == GameState::GameOver  ||
+            state == GameState::Victory)
+        {
+            restart();
+        }
+        else if (state == GameState::BallOnPaddle)
+        {
+            // Random launch angle in [-45°, +45°] from straight up.
+            float angleOffsetDeg = static_cast<float>(rng.below(91)) - 45.0f;
+            ball.launch(ballSpeed, angleOffsetDeg);
+            state = GameState::Playing;
+        }
+    }
+
+    if (input & Input::Pause)
+    {
+        if (state == GameState::Playing)
+            state = GameState::Paused;
+        else if (state == GameState::Paused)
+            state = GameState::Playing;
+    }
+}
+
+void Simulation::update(float deltaTime, InputMask input)
+{
+    // The level clock runs while the level is in play, ball launched or
+    // not, and stops while the game is paused.
+    ++brickClock;
+    if (moving.getCount() != 0)
+        moving.update(brickClock);
+    if (endless && endless->advance(brickClock))
+    {
+        enterRow();
+        if (state == GameState::GameOver)
+            return;
+    }
+
+    // Always move the paddle regardless of ball state so the player can
+    // position it before launching.
+    float direction = 0.0f;
+    if (input & Input::Left)
+        direction -= 1.0f;
+    if (input & Input::Right)
+        direction += 1.0f;
+
+    paddle.update(deltaTime, static_cast<float>(Constants::WINDOW_WIDTH), direction);
+
+    // While the ball is on the paddle, keep it anchored to the paddle centre
+    // so it tracks along as the player moves.
+    if (state == GameState::BallOnPaddle)
+    {
+        float ballX = paddle.getCentreX();
+        float ballY = paddle.getTopY() - Constants::BALL_RADIUS - 1.0f;
+        ball.reset(ballX, ballY);
+        return;
+    }
+
+    // From here on the ball is in motion.
+    ball.update(deltaTime);
+
+    handleWallCollisions();
+    handlePaddleCollision();
+    handleBrickCollisions();
+
+    // Check for level-complete or overall victory.  Endless games go on.
+    if (bricksRemaining <= 0 && !endless)
+    {
+        if (level >= levels->getLevelCount())
+        {
+            state = GameState::Victory;
+        }
+        else
+        {
+            state              = GameState::LevelComplete;
+            levelCompleteTimer = Constants::LEVEL_COMPLETE_DELAY;
+
+            // Read the next level while the banner is up.
+            levels->prefetch(level + 1);
+        }
+    }
+}
+
+// =============================================================================
+// Collision helpers
+// =============================================================================
+
+void Simulation::handleWallCollisions()
+{
+    sf::Vector2f pos    = ball.getPosition();
+    float        radius = ball.getRadius();
+    float        winW   = static_cast<float>(Constants::WINDOW_WIDTH);
+    float        winH   = static_cast<float>(Constants::WINDOW_HEIGHT);
+
+    // Left wall – reflect rightward.
+    if (pos.x - radius < 0.0f)
+    {
+        ball.setVelocityX(std::abs(ball.getVelocity().x));
+        ball.setPosition(radius, pos.y);
+    }
+
+    // Right wall – reflect leftward.
+    if (pos.x + radius > winW)
+    {
+        ball.setVelocityX(-std::abs(ball.getVelocity().x));
+        ball.setPosition(winW - radius, pos.y);
+    }
+
+    // Top wall – reflect downward.  Tall levels put it above the window.
+    const float top = layout->getTop();
+    if (pos.y - radius < top)
+    {
+        ball.setVelocityY(std::abs(ball.getVelocity().y));
+        ball.setPosition(pos.x, top + radius);
+    }
+
+    // Bottom boundary – player has missed the ball.
+    if (pos.y - radius > winH)
+    {
+        --lives;
+        if (lives <= 0)
+        {
+            lives = 0;
+            state = GameState::GameOver;
+        }
+        else
+        {
+            resetBallOnPaddle();
+        }
+    }
+}
+
+void Simulation::handlePaddleCollision()
+{
+    // Only process collisions while the ball is heading downward; this prevents
+    // the ball from being deflected a second time while it is still passing
+    // through the paddle shape after the first bounce.
+    if (ball.getVelocity().y <= 0.0f)
+        return;
+
+    sf::FloatRect paddleBounds = paddle.getBounds();
+    sf::Vector2f  ballPos      = ball.getPosition();
+    float         radius       = ball.getRadius();
+
+    // Broad-phase AABB check: expand the paddle rectangle by the ball radius
+    // in every direction, then test whether the ball centre falls inside.
+    sf::FloatRect expandedBounds = {
+        paddleBounds.left   - radius,
+        paddleBounds.top    - radius,
+        paddleBounds.width  + 2.0f * radius,
+        paddleBounds.height + 2.0f * radius
+    };
+
+    if (!expandedBounds.contains(ballPos))
+        return;
+
+    // Nudge the ball just above the paddle surface to prevent it sinking in.
+    ball.setPosition(ballPos.x, paddleBounds.top - radius - 0.5f);
+
+    // Map the horizontal hit position to a deflection angle.
+    // hitOffset is in [-1, 1]: -1 = far left edge, 0 = centre, +1 = far right.
+    float hitOffset = (ballPos.x - paddle.getCentreX()) /
+                      (paddle.getWidth() * 0.5f);
+    hitOffset = std::max(-1.0f, std::min(1.0f, hitOffset));
+
+    // Angles range from -75° (far left) to +75° (far right) relative to
+    // straight upward, giving the player meaningful directional control.
+    static constexpr float MAX_ANGLE_RAD = 75.0f * (3.14159265f / 180.0f);
+    float angle = hitOffset * MAX_ANGLE_RAD;
+
+    float speed = ball.getSpeed();
+    ball.setVelocityX( speed * std::sin(angle));  // Positive = rightward.
+    ball.setVelocityY(-speed * std::cos(angle));  // Negative = upward in SFML.
+
+    // Re-normalise to compensate for any floating-point error in sin/cos.
+    ball.normaliseSpeed(ballSpeed);
+}
+
+void Simulation::handleBrickCollisions()
+{
+    sf::Vector2f ballCenter = ball.getPosition();
+    float        radius     = ball.getRadius();
+
+    // Reflect the ball at most once per tick to avoid erratic behaviour when
+    // the ball grazes the corner shared by two adjacent bricks.
+    bool collisionResolvedThisTick = false;
+
+    // Only bricks sharing an index cell with the ball's bounding box can
+    // touch it; they come back in layout order.
+    const std::vector<Brick>& bricks  = layout->getBricks();
+    const sf::FloatRect       ballBox = { ballCenter.x - radius, ballCenter.y - radius, 2.0f * radius, 2.0f * radius };
+    layout->findBricks(ballBox, nearbyBricks);
+
+    for (std::uint32_t index : nearbyBricks)
+    {
+        if (brickHitPoints[index] != 0)
+            collideBrick(index, bricks[index].getBounds(), MovingBricks::NONE, ballCenter, collisionResolvedThisTick);
+    }
+
+    // Moving bricks are not in the level's index; they have their own.
+    if (moving.getCount() != 0)
+    {
+        moving.findOverlapping(ballBox, nearbyMovers);
+        for (std::uint32_t mover : nearbyMovers)
+        {
+            const std::uint32_t index = moving.getBrick(mover);
+            if (brickHitPoints[index] != 0)
+                collideBrick(index, moving.getBounds(mover), mover, ballCenter, collisionResolvedThisTick);
+        }
+    }
+
+    // Nor are the rows of an endless game, which the field finds where
+    // they are now.
+    if (endless)
+    {
+        endless->findOverlapping(ballBox, nearbyBricks);
+        for (std::uint32_t index : nearbyBricks)
+        {
+            if (brickHitPoints[index] != 0)
+                collideBrick(index, endless->getBounds(index), MovingBricks::NONE, ballCenter, collisionResolvedThisTick);
+        }
+    }
+
+    if (!blastQueue.empty())
+        detonate();
+}
+
+void Simulation::collideBrick(std::uint32_t index, const sf::FloatRect& rect, std::size_t mover,
+                              sf::Vector2f ballCenter, bool& resolved)
+{
+    float radius = ball.getRadius();
+
+    // Nearest-point circle–AABB test:
+    // find the closest point on the brick rectangle to the ball centre.
+    float closestX = std::max(rect.left, std::min(ballCenter.x, rect.left + rect.width));
+    float closestY = std::max(rect.top,  std::min(ballCenter.y, rect.top  + rect.height));
+
+    float dx     = ballCenter.x - closestX;
+    float dy     = ballCenter.y - closestY;
+    float distSq = dx * dx + dy * dy;
+
+    // No intersection if the nearest point is farther than the radius.
+    if (distSq >= radius * radius)
+        return;
+
+    // -------------------------------------------------------------------------
+    // Collision confirmed – damage the brick.
+    // -------------------------------------------------------------------------
+    damageBrick(index);
+
+    // -------------------------------------------------------------------------
+    // Resolve the ball reflection (first hit only this tick).
+    // -------------------------------------------------------------------------
+    if (resolved)
+        return;
+
+    // Compute the collision normal from nearest-point to ball centre.
+    float dist = std::sqrt(distSq);
+
+    sf::Vector2f normal;
+    if (dist > 0.0001f)
+    {
+        normal = { dx / dist, dy / dist };
+    }
+    else
+    {
+        // The ball centre is exactly inside the rectangle – use
+        // a safe default upward normal.
+        normal = { 0.0f, -1.0f };
+    }
+
+    if (endless)
+        reflectBall(normal, endless->getVelocity());
+    else if (mover == MovingBricks::NONE)
+        reflectBall(normal);
+    else
+        reflectBall(normal, moving.getVelocity(mover));
+
+    // Push the ball clear of the brick surface along the normal.
+    float penetrationDepth = radius - dist;
+    ball.setPosition(
+        ballCenter.x + normal.x * (penetrationDepth + 0.5f),
+        ballCenter.y + normal.y * (penetrationDepth + 0.5f));
+
+    // Normalise speed to counteract accumulated floating-point drift.
+    ball.normaliseSpeed(ballSpeed);
+
+    resolved = true;
+}
+
+void Simulation::damageBrick(std::uint32_t index)
+{
+    brickHash ^= brickStateKey(index, brickHitPoints[index]);
+    --brickHitPoints[index];
+    brickHash ^= brickStateKey(index, brickHitPoints[index]);
+
+    if (brickHitPoints[index] == 0)
+    {
+        const Brick& brick = getBricks()[index];
+        score += brick.points;
+        --bricksRemaining;
+
+        if (brick.type == BrickType::Explosive)
+            blastQueue.push_back(index);
+    }
+}
+
+void Simulation::detonate()
+{
+    // The queue grows while it is walked; index rather than iterate.
+    for (std::size_t head = 0; head < blastQueue.size(); ++head)
+    {
+        const std::uint32_t exploding = blastQueue[head];
+        if (endless)
+        {
+            // Endless rows move together: what the blast reaches is found
+            // where they are now.
+            endless->findOverlapping(endless->getBrick(exploding).getBlastBounds(), nearbyBricks);
+            for (std::uint32_t target : nearbyBricks)
+            {
+                if (brickHitPoints[target] != 0)
+                    damageBrick(target);
+            }
+            continue;
+        }
+
+        const std::size_t   mover     = moving.find(exploding);
+        if (mover == MovingBricks::NONE)
+        {
+            std::size_t          count;
+            const std::uint32_t* targets = layout->getBlastTargets(exploding, count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (brickHitPoints[targets[i]] != 0)
+                    damageBrick(targets[i]);
+            }
+        }
+
+        if (moving.getCount() == 0)
+            continue;
+
+        // Moving bricks, and the targets of a moving brick, are found
+        // where they are now.
+        Brick brick = layout->getBricks()[exploding];
+        if (mover != MovingBricks::NONE)
+        {
+            brick.x += moving.getOffset(mover).x;
+            brick.y += moving.getOffset(mover).y;
+            layout->findOverlapping(brick.getBlastBounds(), nearbyBricks);
+            for (std::uint32_t target : nearbyBricks)
+            {
+                if (brickHitPoints[target] != 0)
+                    damageBrick(target);
+            }
+        }
+
+        moving.findOverlapping(brick.getBlastBounds(), nearbyMovers);
+        for (std::uint32_t target : nearbyMovers)
+        {
+            const std::uint32_t index = moving.getBrick(target);
+            if (index != exploding && brickHitPoints[index] != 0)
+                damageBrick(index);
+        }
+    }
+    blastQueue.clear();
+}
+
+void Simulation::reflectBall(sf::Vector2f normal)
+{
+    // Standard specular reflection: r = v − 2(v·n)n
+    sf::Vector2f vel = ball.getVelocity();
+    float dot        = vel.x * normal.x + vel.y * normal.y;
+
+    ball.setVelocityX(vel.x - 2.0f * dot * normal.x);
+    ball.setVelocityY(vel.y - 2.0f * dot * normal.y);
+}
+
+void Simulation::reflectBall(sf::Vector2f normal, sf::Vector2f surfaceVelocity)
+{
+    // The same reflection in the surface's frame of reference.
+    sf::Vector2f vel = ball.getVelocity() - surfaceVelocity;
+    float dot        = vel.x * normal.x + vel.y * normal.y;
+    if (dot >= 0.0f)
+        return;
+
+    ball.setVelocityX(vel.x - 2.0f * dot * normal.x + surfaceVelocity.x);
+    ball.setVelocityY(vel.y - 2.0f * dot * normal.y + surfaceVelocity.y);
+}
@@ -0,0 +1,432 @@
+/**
+ * @file Simulation.hpp
+ * @brief Declaration of the Simulation class — the headless game model.
+ *
+ * Simulation holds every piece of state that affects gameplay (ball, paddle,
+ * bricks, score, lives, level, state machine) and advances it in fixed
+ * ticks of Constants::TICK_SECONDS driven only by an InputMask.  It owns no
+ * window and performs no rendering, so it can run inside the interactive
+ * game, a benchmark, or any other headless tool.
+ *
+ * Given the same seed and the same sequence of inputs, two Simulation
+ * instances produce identical games.  All randomness comes from the
+ * simulation's own Random generator, so any number of simulations can run
+ * concurrently in one process without affecting each other.
+ *
+ * Levels come from a LevelPack (see Level.hpp): the simulation shares the
+ * current level's immutable brick layout and keeps only each brick's
+ * remaining hit points itself.  Entering LevelComplete asks the pack for
+ * the next level, so it is read in the background during the banner and
+ * the switch itself is a pointer swap and a copy of the hit points.
+ * Moving bricks are placed by a clock counting the ticks the level has been
+ * played; they keep still while the game is paused, and a snapshot moves
+ * them by restoring the clock (see MovingBricks.hpp).
+ *
+ * An endless pack (LevelPack::isEndless()) never completes a level: rows
+ * stream down through the playfield by the same clock (see
+ * EndlessField.hpp), the level number and ball speed rise every
+ * EndlessField::ROWS_PER_LEVEL rows, and a row reaching the deadline with
+ * bricks left costs a life.  Bricks are then numbered by their place in
+ * the field's ring, so the hit-point array, snapshots and the brick hash
+ * work as they do for levels.
+ *
+ * Collision detection
+ * -------------------
+ * Ball vs. walls, paddle, and bricks are resolved in separate helper methods.
+ * Brick collisions use the circle–AABB nearest-point algorithm to produce a
+ * physically plausible reflection normal.  Only the first brick collision is
+ * resolved per tick to avoid double-reflections at brick corners.  The
+ * level's grid index limits the test to bricks near the ball, so the cost
+ * per tick does not grow with the size of the level; moving bricks are
+ * found through their own index, kept up to date as they move.  A moving
+ * brick bounces the ball as seen from the brick, so its motion changes the
+ * direction the ball leaves in.  The top wall is the
+ * top of the level's playfield, above the window for tall levels.
+ */
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Ball.hpp"
+#include "Brick.hpp"
+#include "EndlessField.hpp"
+#include "GameSnapshot.hpp"
+#include "GameState.hpp"
+#include "Input.hpp"
+#include "Level.hpp"
+#include "MovingBricks.hpp"
+#include "Paddle.hpp"
+#include "Random.hpp"
+
+/**
+ * @brief Fixed-tick Breakout game model.
+ *
+ * A new Simulation starts in the MainMenu state; a Launch input starts the
+ * first game.  The Controls state is never entered by the simulation — it is
+ * a presentation-only screen owned by Game.
+ *
+ * Movable but not copyable, since an endless game owns its field's worker
+ * thread; copy one by restoring a snapshot() into a new Simulation.
+ */
+class Simulation
+{
+public:
+    /**
+     * @brief Constructs a simulation in the MainMenu state.
+     *
+     * Seeds the simulation's random-number generator (used for ball launch
+     * angles) and sets up level 1 so the menu has a backdrop.
+     *
+     * @param seed    Seed for the simulation's random-number generator.
+     * @param levels  Campaign to play; the built-in one by default.  Replays
+     *                only reproduce with the pack they were recorded on.
+     */
+    explicit Simulation(std::uint32_t seed,
+                        std::shared_ptr<const LevelPack> levels = LevelPack::builtIn());
+
+    /**
+     * @brief Advances the game by one tick of Constants::TICK_SECONDS.
+     *
+     * Edge-triggered inputs are applied first (Launch starts, launches, or
+     * restarts; Pause toggles pause), then physics, collisions and timers run
+     * for whichever state results.
+     *
+     * @param input  Player input for this tick (see Input.hpp).
+     */
+    void step(InputMask input);
+
+    /**
+     * @brief Resets all game state and starts from level 1.
+     *
+     * Resets score, lives, level, and ball speed; re-centres the paddle;
+     * restores every brick; and places the ball on the paddle.  The
+     * random-number generator is not reseeded.
+     */
+    void restart();
+
+    /**
+     * @brief Captures the complete simulation state.
+     * @return GameSnapshot  Plain-data copy; restore() returns to this tick.
+     */
+    GameSnapshot snapshot() const;
+
+    /**
+     * @brief Captures the complete simulation state into @p out.
+     *
+     * Reuses @p out's brick array, so refilling a snapshot kept across
+     * ticks does not allocate.
+     *
+     * @param out  Receives the state.
+     */
+    void snapshot(GameSnapshot& out) const;
+
+    /**
+     * @brief Returns the simulation to a previously captured state.
+     *
+     * Switches layouts if the snapshot belongs to a different level, then
+     * applies every saved value.  Subsequent ticks are identical to the
+     * ones that followed the original capture.
+     *
+     * A snapshot stores brick damage, not bricks, so one whose brick count
+     * differs from its level's layout (taken on other levels, or before the
+     * level was reloaded) is refused, as is one of an endless game that
+     * does not cover the whole ring (EndlessField::BRICK_COUNT).
+     *
+     * @param snapshot  State from snapshot() of a simulation of this build.
+     * @return false, leaving the simulation unchanged, if the snapshot does
+     *         not fit the layout of its level.
+     */
+    bool restore(const GameSnapshot& snapshot);
+
+    /**
+     * @brief Restarts the current level's bricks from the level pack.
+     *
+     * Takes the pack's current layout for the level at full health; the
+     * ball, paddle, score, lives and state carry on.  For picking up a
+     * level file edited while the game runs (see LevelWatcher.hpp): the
+     * layout is already loaded, so this is as cheap as starting a level.
+     */
+    void reloadLevel();
+
+    /**
+     * @brief Returns a 64-bit hash of the state that determines future ticks.
+     *
+     * Covers the same fields as snapshot() except the tick and seed, which
+     * a replay already implies, and the brick clock on levels where no
+     * brick moves and the game is not endless.  Brick damage enters
+     * through a hash updated whenever a brick is hit, so the cost is a few
+     * multiplies regardless of brick count; cheap enough to compute every
+     * tick while recording or verifying a replay.
+     *
+     * @return std::uint64_t  Equal for equal states; differs otherwise with
+     *                        overwhelming probability.
+     */
+    std::uint64_t stateHash() const;
+
+    // =========================================================================
+    // Accessors
+    // =========================================================================
+
+    /// @return The ball.
+    const Ball& getBall() const;
+
+    /// @return The paddle.
+    const Paddle& getPaddle() const;
+
+    /// @return All bricks of the current level, including destroyed ones;
+    ///         in endless mode the records of the field's ring, placed by
+    ///         getEndlessField().
+    const std::vector<Brick>& getBricks() const;
+
+    /// @return Layout of the current level: its bricks, index and playfield.
+    const Level& getLayout() const;
+
+    /// @return Remaining hit points of each brick in getBricks(); 0 = destroyed.
+    const std::vector<std::uint8_t>& getBrickHitPoints() const;
+
+    /// @return Where the current level's moving bricks are this tick.
+    const MovingBricks& getMovingBricks() const;
+
+    /// @return The rows of an endless game, or nullptr outside endless mode.
+    const EndlessField* getEndlessField() const;
+
+    /// @return The campaign being played.
+    const std::shared_ptr<const LevelPack>& getLevelPack() const;
+
+    /// @return Current logical game state.
+    GameState getState() const;
+
+    /// @return Accumulated player score.
+    int getScore() const;
+
+    /// @return Remaining player lives.
+    int getLives() const;
+
+    /// @return Current level number (1-based).
+    int getLevel() const;
+
+    /// @return Live brick count in the current level.
+    int getBricksRemaining() const;
+
+    /// @return Hash of every brick's remaining hit points; changes with
+    ///         every brick hit (see brickStateKey()).
+    std::uint64_t getBrickHash() const;
+
+    /// @return Number of ticks simulated since construction.
+    std::uint32_t getTick() const;
+
+    /// @return Seed passed to the constructor.
+    std::uint32_t getSeed() const;
+
+private:
+    // =========================================================================
+    // Level management
+    // =========================================================================
+
+    /**
+     * @brief Switches to the current level's layout at full health.
+     */
+    void createBricks();
+
+    /// Recomputes brickHash from every brick's hit points.
+    void rehashBricks();
+
+    /**
+     * @brief Places the ball on the paddle and enters BallOnPaddle state.
+     *
+     * The ball centre is set just above the paddle's top edge so it appears
+     * to rest on the paddle surface until the player launches it.
+     */
+    void resetBallOnPaddle();
+
+    /**
+     * @brief Advances to the next level after the current one is cleared.
+     *
+     * Increments the level counter, increases ball speed (capped at
+     * BALL_MAX_SPEED), sets up the new level's bricks, and resets the ball on
+     * paddle.
+     */
+    void advanceLevel();
+
+    /**
+     * @brief Brings the endless field's newest row into play.
+     *
+     * If the row reaching the deadline as it comes in still has bricks,
+     * takes a life, ending the game on the last one, and clears them.
+     * Then gives the new row's bricks their hit points, in the slot of a
+     * row that passed the deadline, and moves up a level every
+     * EndlessField::ROWS_PER_LEVEL rows.
+     */
+    void enterRow();
+
+    // =========================================================================
+    // Per-tick steps
+    // =========================================================================
+
+    /**
+     * @brief Applies edge-triggered inputs to the state machine.
+     *
+     *   - Launch: MainMenu / GameOver / Victory → restart();
+     *             BallOnPaddle → launch the ball and enter Playing.
+     *   - Pause:  toggles between Playing and Paused.
+     *
+     * @param input  Input for the current tick.
+     */
+    void applyCommands(InputMask input);
+
+    /**
+     * @brief Advances paddle, ball and collisions by @p deltaTime seconds.
+     *
+     * - Moves the paddle according to the Left / Right input bits.
+     * - In BallOnPaddle state: keeps the ball anchored to the paddle centre.
+     * - In Playing state: moves the ball, resolves all collisions, checks for
+     *   ball-lost and level-complete conditions.
+     *
+     * @param deltaTime  Tick length in seconds.
+     * @param input      Input for the current tick.
+     */
+    void update(float deltaTime, InputMask input);
+
+    // =========================================================================
+    // Collision helpers
+    // =========================================================================
+
+    /**
+     * @brief Tests the ball against the four window walls and responds.
+     *
+     * - Left and right walls: reflect the ball horizontally.
+     * - Top wall: reflect the ball vertically.
+     * - Bottom boundary: deduct a life; either reset the ball or trigger
+     *   GameOver if no lives remain.
+     */
+    void handleWallCollisions();
+
+    /**
+     * @brief Tests the ball against the paddle and responds if they intersect.
+     *
+     * Uses an AABB broad phase before computing the precise contact position.
+     * Collision response maps the horizontal hit offset (in [-1, 1] relative
+     * to the paddle centre) to a launch angle of up to ±75° from vertical,
+     * giving the player meaningful directional control.
+     *
+     * The ball is nudged above the paddle surface after each collision to
+     * prevent it from becoming trapped inside the shape.
+     */
+    void handlePaddleCollision();
+
+    /**
+     * @brief Tests the ball against every active brick and responds.
+     *
+     * Bricks near the ball are found through the level's grid index and
+     * tested in layout order, exactly as if every brick were tested; then
+     * the moving bricks near it, where they are this tick, or in endless
+     * mode the field's bricks near it, lowest row first.  Uses the
+     * circle–AABB nearest-point method to find the collision normal.
+     * Only the first intersection resolved per tick reverses the ball's
+     * direction; subsequent bricks hit in the same tick are still damaged but
+     * do not cause additional reflections, preventing erratic multi-bounce
+     * behaviour at brick-cluster boundaries.  Explosive bricks destroyed
+     * here detonate once every hit has been applied.
+     */
+    void handleBrickCollisions();
+
+    /**
+     * @brief Tests the ball against one live brick and responds.
+     * @param index       Brick index.
+     * @param rect        Its collision bounds this tick.
+     * @param mover       Its number in moving, or MovingBricks::NONE;
+     *                    endless bricks all move with the field.
+     * @param ballCenter  Ball centre before any brick moved it this tick;
+     *                    every brick is tested against the same position.
+     * @param resolved    Whether the ball has already been reflected this
+     *                    tick; set when this brick reflects it.
+     */
+    void collideBrick(std::uint32_t index, const sf::FloatRect& rect, std::size_t mover,
+                      sf::Vector2f ballCenter, bool& resolved);
+
+    /**
+     * @brief Takes one hit point from brick @p index, which must be live.
+     *
+     * Keeps the brick hash, score and live-brick count up to date, and
+     * queues the brick in blastQueue if it is destroyed and explosive.
+     */
+    void damageBrick(std::uint32_t index);
+
+    /**
+     * @brief Detonates the queued explosive bricks, and every explosive
+     *        brick their blasts destroy.
+     *
+     * Breadth first: each blast hits every live brick on its target list
+     * (Level::getBlastTargets(), found through the grid index when the
+     * level was loaded) and every moving brick its blast bounds touch, and
+     * explosive bricks destroyed that way join the end of the queue.  A
+     * moving brick explodes where it is, its static targets found through
+     * the index on the spot, as is everything an endless brick's blast
+     * reaches.  A brick is queued only when destroyed, so each
+     * explodes once, and a chain costs one short list walk per explosion
+     * however large the level.  Hits commute, so the result does not depend
+     * on the order of the queue.
+     */
+    void detonate();
+
+    /**
+     * @brief Reflects the ball's velocity off a surface defined by @p normal.
+     *
+     * Applies the standard specular-reflection formula:
+     *   r = v − 2(v·n)n
+     *
+     * @param normal  Unit vector perpendicular to the reflecting surface,
+     *                pointing away from the surface into the ball's half-space.
+     */
+    void reflectBall(sf::Vector2f normal);
+
+    /**
+     * @brief Reflects the ball off a surface moving at @p surfaceVelocity.
+     *
+     * Reflects the ball's velocity relative to the surface, then adds the
+     * surface's velocity back.  A ball already leaving the surface, as
+     * seen from it, is left alone.
+     *
+     * @param normal           As for reflectBall(sf::Vector2f).
+     * @param surfaceVelocity  Pixels per second.
+     */
+    void reflectBall(sf::Vector2f normal, sf::Vector2f surfaceVelocity);
+
+    // =========================================================================
+    // Member data
+    // =========================================================================
+
+    Ball               ball;              ///< The bouncing ball.
+    Paddle             paddle;            ///< Player-controlled paddle.
+
+    std::shared_ptr<const LevelPack> levels;         ///< Campaign being played.
+    std::shared_ptr<const Level>     layout;         ///< Current level's bricks.
+    std::vector<std::uint8_t>        brickHitPoints; ///< Remaining hit points per brick.
+    std::vector<std::uint32_t>       nearbyBricks;   ///< Scratch list for brick queries; reserved by createBricks().
+    std::vector<std::uint32_t>       nearbyMovers;   ///< Scratch list for moving-brick queries; likewise.
+    std::vector<std::uint32_t>       blastQueue;     ///< Explosive bricks destroyed, not yet detonated; likewise.
+    MovingBricks                     moving;         ///< Current level's moving bricks.
+    std::uint32_t                    brickClock;     ///< Ticks the current level has been played.
+    std::unique_ptr<EndlessField>    endless;        ///< Rows of an endless pack; null otherwise.
+
+    GameState          state;             ///< Current logical game state.
+    int                score;             ///< Accumulated player score.
+    int                lives;             ///< Remaining player lives.
+    int                level;             ///< Current level number (1-based).
+    float              ballSpeed;         ///< Active ball speed in pixels/second.
+
+    float              levelCompleteTimer;///< Countdown (seconds) before advancing.
+    int                bricksRemaining;   ///< Live brick count in current level.
+
+    /// XOR of a per-(brick, hit points) key over all bricks; updated
+    /// incrementally by hits so stateHash() never walks the grid.
+    std::uint64_t      brickHash;
+
+    std::uint32_t      tick;              ///< Ticks simulated since construction.
+    std::uint32_t      seed;              ///< Seed rng was created with.
+    Random             rng;               ///< Launch-angle random numbers.
+};
@@ -25,6 +25,22 @@ namespace Constants {
     /// Target frames per second; passed to sf::Window::setFramerateLimit.
     constexpr uint32_t FRAME_RATE = 60;
 
+    /// Fixed simulation rate in ticks per second.  The simulation always
+    /// advances in steps of 1 / TICK_RATE seconds regardless of the display
+    /// frame rate, so a given input sequence always produces the same game.
+    constexpr uint32_t TICK_RATE = 120;
+
+    /// Duration of one simulation tick in seconds.
+    constexpr float TICK_SECONDS = 1.0f / static_cast<float>(TICK_RATE);
+
+    /// Upper bound on ticks simulated per rendered frame.  Matches the old
+    /// 50 ms delta-time cap: after a stall the game drops time rather than
+    /// fast-forwarding.
+    constexpr int MAX_TICKS_PER_FRAME = 6;
+
+    /// Seconds of play kept for rewinding (one snapshot per tick).
+    constexpr uint32_t REWIND_SECONDS = 10;
+
     /// Text shown in the OS title bar.
     constexpr const char* WINDOW_TITLE = "Breakout";
 
@@ -89,7 +105,8 @@ namespace Constants {
     /// Number of lives the player begins with.
     constexpr int INITIAL_LIVES = 3;
 
-    /// Total number of levels; the Victory screen is shown after the last one.
+    /// Number of built-in levels.  The Victory screen follows the last level
+    /// of whichever level pack is played (see Level.hpp).
     constexpr int MAX_LEVELS = 5;
 
     /// Seconds to display the "Level Complete" screen before advancing.
@@ -15,18 +15,28 @@
  *
  * If the font is missing, Game's constructor emits a descriptive error message
  * to stderr and closes the window gracefully.
+ *
+ * Command-line options
+ * --------------------
+ * Optional diagnostic modes are selected with flags parsed by
+ * parseGameOptions(); run with --help for the list.
  */
 
 #include "Game.hpp"
+#include "GameOptions.hpp"
 
-int main()
+int main(int argc, char* argv[])
 {
+    GameOptions options;
+    if (!parseGameOptions(argc, argv, options))
+        return 0;
+
     // Path to the UI font, relative to the executable.
     // The setup script places DejaVuSans.ttf here; swap this path if you
     // prefer a different font.
     const std::string fontPath = "assets/DejaVuSans.ttf";
 
-    Game game(fontPath);
+    Game game(fontPath, options);
     game.run();
 
     return 0;
@@ -0,0 +1,456 @@
+/**
+ * @file Json.cpp
+ * @brief Implementation of JsonValue parsing and writing.
+ */
+
+#include "Json.hpp"
+
+#include <cctype>   // std::isspace, std::isdigit
+#include <cmath>    // std::isfinite
+#include <cstdlib>  // std::strtod
+#include <iomanip>  // std::setprecision
+#include <ostream>
+#include <sstream>  // std::ostringstream
+
+// -----------------------------------------------------------------------------
+// Parser
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/// Recursive-descent parser over an in-memory document.
+class Parser
+{
+public:
+    explicit Parser(const std::string& text) : text(text), pos(0) {}
+
+    bool parseDocument(JsonValue& out, std::string& error)
+    {
+        if (!parseValue(out, 0) || (skipSpace(), pos != text.size()))
+        {
+            std::ostringstream message;
+            message << (failure.empty() ? "unexpected trailing characters" : failure)
+                    << " at offset " << pos;
+            error = message.str();
+            return false;
+        }
+        return true;
+    }
+
+private:
+    /// Deepest nesting accepted, to bound recursion on malformed input.
+    static constexpr int MAX_DEPTH = 64;
+
+    void skipSpace()
+    {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos])))
+            ++pos;
+    }
+
+    bool fail(const char* message)
+    {
+        if (failure.empty())
+            failure = message;
+        return false;
+    }
+
+    bool consume(const char* literal)
+    {
+        std::size_t length = std::char_traits<char>::length(literal);
+        if (text.compare(pos, length, literal) != 0)
+            return false;
+        pos += length;
+        return true;
+    }
+
+    bool parseValue(JsonValue& out, int depth)
+    {
+        if (depth > MAX_DEPTH)
+            return fail("nesting too deep");
+
+        skipSpace();
+        if (pos >= text.size())
+            return fail("unexpected end of input");
+
+        char c = text[pos];
+        if (c == '{')  return parseObject(out, depth);
+        if (c == '[')  return parseArray(out, depth);
+        if (c == '"')
+        {
+            std::string value;
+            if (!parseString(value))
+                return false;
+            out = JsonValue::makeString(value);
+            return true;
+        }
+        if (consume("true"))  { out = JsonValue::makeBool(true);  return true; }
+        if (consume("false")) { out = JsonValue::makeBool(false); return true; }
+        if (consume("null"))  { out = JsonValue();                return true; }
+        return parseNumber(out);
+    }
+
+    bool parseNumber(JsonValue& out)
+    {
+        const char* begin = text.c_str() + pos;
+        char*       end   = nullptr;
+        double      value = std::strtod(begin, &end);
+        if (end == begin)
+            return fail("expected a value");
+        pos += static_cast<std::size_t>(end - begin);
+        out = JsonValue::makeNumber(value);
+        return true;
+    }
+
+    bool parseString(std::string& out)
+    {
+        ++pos; // Opening quote.
+        while (pos < text.size())
+        {
+            char c = text[pos++];
+            if (c == '"')
+                return true;
+            if (c != '\\')
+            {
+                out += c;
+                continue;
+            }
+            if (pos >= text.size())
+                break;
+
+            char escape = text[pos++];
+            switch (escape)
+            {
+            case '"':  out += '"';  break;
+            case '\\': out += '\\'; break;
+            case '/':  out += '/';  break;
+            case 'b':  out += '\b'; break;
+            case 'f':  out += '\f'; break;
+            case 'n':  out += '\n'; break;
+            case 'r':  out += '\r'; break;
+            case 't':  out += '\t'; break;
+            case 'u':
+            {
+                // Basic Multilingual Plane only, encoded as UTF-8.
+                if (pos + 4 > text.size())
+                    return fail("truncated \\u escape");
+                unsigned code = static_cast<unsigned>(std::strtoul(text.substr(pos, 4).c_str(), nullptr, 16));
+                pos += 4;
+                if (code < 0x80)
+                {
+                    out += static_cast<char>(code);
+                }
+                else if (code < 0x800)
+                {
+                    out += static_cast<char>(0xC0 | (code >> 6));
+                    out += static_cast<char>(0x80 | (code & 0x3F));
+                }
+                else
+                {
+                    out += static_cast<char>(0xE0 | (code >> 12));
+                    out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                    out += static_cast<char>(0x80 | (code & 0x3F));
+                }
+                break;
+            }
+            default:
+                return fail("invalid escape");
+            }
+        }
+        return fail("unterminated string");
+    }
+
+    bool parseArray(JsonValue& out, int depth)
+    {
+        ++pos; // '['
+        out = JsonValue::makeArray();
+
+        skipSpace();
+        if (pos < text.size() && text[pos] == ']')
+        {
+            ++pos;
+            return true;
+        }
+
+        for (;;)
+        {
+            JsonValue element;
+            if (!parseValue(element, depth + 1))
+                return false;
+            out.append(element);
+
+            skipSpace();
+            if (pos < text.size() && text[pos] == ',') { ++pos; continue; }
+            if (pos < text.size() && text[pos] == ']') { ++pos; return true; }
+            return fail("expected ',' or ']'");
+        }
+    }
+
+    bool parseObject(JsonValue& out, int depth)
+    {
+        ++pos; // '{'
+        out = JsonValue::makeObject();
+
+        skipSpace();
+        if (pos < text.size() && text[pos] == '}')
+        {
+            ++pos;
+            return true;
+        }
+
+        for (;;)
+        {
+            skipSpace();
+            if (pos >= text.size() || text[pos] != '"')
+                return fail("expected a member name");
+
+            std::string key;
+            if (!parseString(key))
+                return false;
+
+            skipSpace();
+            if (pos >= text.size() || text[pos] != ':')
+                return fail("expected ':'");
+            ++pos;
+
+            JsonValue member;
+            if (!parseValue(member, depth + 1))
+                return false;
+            out.set(key, member);
+
+            skipSpace();
+            if (pos < text.size() && text[pos] == ',') { ++pos; continue; }
+            if (pos < text.size() && text[pos] == '}') { ++pos; return true; }
+            return fail("expected ',' or '}'");
+        }
+    }
+
+    const std::string& text;    ///< Document being parsed.
+    std::size_t        pos;     ///< Current byte offset.
+    std::string        failure; ///< First error encountered.
+};
+
+/**
+ * @brief Writes @p value as a quoted, escaped JSON string.
+ */
+void writeString(std::ostream& out, const std::string& value)
+{
+    out << '"';
+    for (char c : value)
+    {
+        switch (c)
+        {
+        case '"':  out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n";  break;
+        case '\r': out << "\\r";  break;
+        case '\t': out << "\\t";  break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                out << "\\u00" << "0123456789abcdef"[(c >> 4) & 0xF]
+                               << "0123456789abcdef"[c & 0xF];
+            }
+            else
+            {
+                out << c;
+            }
+            break;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Construction
+// -----------------------------------------------------------------------------
+
+JsonValue::JsonValue()
+    : type(Type::Null)
+    , boolean(false)
+    , number(0.0)
+{
+}
+
+JsonValue JsonValue::makeBool(bool value)
+{
+    JsonValue result;
+    result.type    = Type::Bool;
+    result.boolean = value;
+    return result;
+}
+
+JsonValue JsonValue::makeNumber(double value)
+{
+    JsonValue result;
+    result.type   = Type::Number;
+    result.number = value;
+    return result;
+}
+
+JsonValue JsonValue::makeString(const std::string& value)
+{
+    JsonValue result;
+    result.type = Type::String;
+    result.text = value;
+    return result;
+}
+
+JsonValue JsonValue::makeArray()
+{
+    JsonValue result;
+    result.type = Type::Array;
+    return result;
+}
+
+JsonValue JsonValue::makeObject()
+{
+    JsonValue result;
+    result.type = Type::Object;
+    return result;
+}
+
+bool JsonValue::parse(const std::string& text, JsonValue& out, std::string& error)
+{
+    Parser parser(text);
+    return parser.parseDocument(out, error);
+}
+
+// -----------------------------------------------------------------------------
+// Accessors
+// -----------------------------------------------------------------------------
+
+JsonValue::Type JsonValue::getType() const
+{
+    return type;
+}
+
+double JsonValue::asNumber(double fallback) const
+{
+    return type == Type::Number ? number : fallback;
+}
+
+bool JsonValue::asBool(bool fallback) const
+{
+    return type == Type::Bool ? boolean : fallback;
+}
+
+const std::string& JsonValue::asString() const
+{
+    return text;
+}
+
+const std::vector<JsonValue>& JsonValue::items() const
+{
+    return elements;
+}
+
+const std::vector<std::string>& JsonValue::keys() const
+{
+    return names;
+}
+
+const JsonValue* JsonValue::find(const std::string& key) const
+{
+    if (type != Type::Object)
+        return nullptr;
+
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        if (names[i] == key)
+            return &elements[i];
+    }
+    return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+// Mutators
+// -----------------------------------------------------------------------------
+
+JsonValue& JsonValue::set(const std::string& key, const JsonValue& value)
+{
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        if (names[i] == key)
+        {
+            elements[i] = value;
+            return elements[i];
+        }
+    }
+
+    names.push_back(key);
+    elements.push_back(value);
+    return elements.back();
+}
+
+void JsonValue::append(const JsonValue& value)
+{
+    elements.push_back(value);
+}
+
+// -----------------------------------------------------------------------------
+// Output
+// -----------------------------------------------------------------------------
+
+void JsonValue::write(std::ostream& out, int indent) const
+{
+    const std::string pad(static_cast<std::size_t>(indent) * 2, ' ');
+    const std::string innerPad(static_cast<std::size_t>(indent + 1) * 2, ' ');
+
+    switch (type)
+    {
+    case Type::Null:
+        out << "null";
+        break;
+
+    case Type::Bool:
+        out << (boolean ? "true" : "false");
+        break;
+
+    case Type::Number:
+        if (std::isfinite(number))
+            out << std::setprecision(10) << number;
+        else
+            out << "null";
+        break;
+
+    case Type::String:
+        writeString(out, text);
+        break;
+
+    case Type::Array:
+        if (elements.empty())
+        {
+            out << "[]";
+            break;
+        }
+        out << "[\n";
+        for (std::size_t i = 0; i < elements.size(); ++i)
+        {
+            out << innerPad;
+            elements[i].write(out, indent + 1);
+            out << (i + 1 < elements.size() ? ",\n" : "\n");
+        }
+        out << pad << ']';
+        break;
+
+    case Type::Object:
+        if (elements.empty())
+        {
+            out << "{}";
+            break;
+        }
+        out << "{\n";
+        for (std::size_t i = 0; i < elements.size(); ++i)
+        {
+            out << innerPad;
+            writeString(out, names[i]);
+            out << ": ";
+            elements[i].write(out, indent + 1);
+            out << (i + 1 < elements.size() ? ",\n" : "\n");
+        }
+        out << pad << '}';
+        break;
+    }
+}
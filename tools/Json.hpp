@@ -0,0 +1,115 @@
+/**
+ * @file Json.hpp
+ * @brief Declaration of JsonValue — a minimal JSON document model.
+ *
+ * Just enough JSON for the command-line tools' configuration and report
+ * files: null, booleans, numbers, strings, arrays, and objects.  Objects keep
+ * their keys in insertion order so files rewritten by a tool diff cleanly
+ * against the original.  Not intended for untrusted or very large input.
+ */
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A JSON value of any type.
+ */
+class JsonValue
+{
+public:
+    /// The kind of value held.
+    enum class Type
+    {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    /// Constructs a null value.
+    JsonValue();
+
+    /// @return A boolean value.
+    static JsonValue makeBool(bool value);
+
+    /// @return A number value.
+    static JsonValue makeNumber(double value);
+
+    /// @return A string value.
+    static JsonValue makeString(const std::string& value);
+
+    /// @return An empty array.
+    static JsonValue makeArray();
+
+    /// @return An empty object.
+    static JsonValue makeObject();
+
+    /**
+     * @brief Parses @p text into @p out.
+     *
+     * @param text   Complete JSON document.
+     * @param out    Receives the parsed value on success.
+     * @param error  Receives a message with the byte offset on failure.
+     * @return true on success.
+     */
+    static bool parse(const std::string& text, JsonValue& out, std::string& error);
+
+    /// @return The kind of value held.
+    Type getType() const;
+
+    /// @return The number, or @p fallback if this is not a number.
+    double asNumber(double fallback = 0.0) const;
+
+    /// @return The boolean, or @p fallback if this is not a boolean.
+    bool asBool(bool fallback = false) const;
+
+    /// @return The string, or an empty string if this is not a string.
+    const std::string& asString() const;
+
+    /// @return Array elements or object values, in order.
+    const std::vector<JsonValue>& items() const;
+
+    /// @return Object keys in insertion order (empty for non-objects).
+    const std::vector<std::string>& keys() const;
+
+    /**
+     * @brief Looks up @p key in an object.
+     * @param key  Member name.
+     * @return Pointer to the member, or nullptr if absent or not an object.
+     */
+    const JsonValue* find(const std::string& key) const;
+
+    /**
+     * @brief Sets (or replaces) member @p key of an object.
+     * @param key    Member name.
+     * @param value  New member value.
+     * @return Reference to the stored member.
+     */
+    JsonValue& set(const std::string& key, const JsonValue& value);
+
+    /**
+     * @brief Appends @p value to an array.
+     * @param value  Element to append.
+     */
+    void append(const JsonValue& value);
+
+    /**
+     * @brief Writes the value as indented JSON.
+     * @param out     Destination stream.
+     * @param indent  Current indentation depth (spaces = 2 × indent).
+     */
+    void write(std::ostream& out, int indent = 0) const;
+
+private:
+    Type                     type;     ///< Kind of value held.
+    bool                     boolean;  ///< Value when type == Bool.
+    double                   number;   ///< Value when type == Number.
+    std::string              text;     ///< Value when type == String.
+    std::vector<JsonValue>   elements; ///< Array elements / object values.
+    std::vector<std::string> names;    ///< Object keys, parallel to elements.
+};
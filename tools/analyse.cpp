@@ -0,0 +1,466 @@
+/**
+ * @file analyse.cpp
+ * @brief breakout_analyse — plays every level of a pack with the bot to
+ *        measure how solvable and how hard it is.
+ *
+ * A hand-made level can hide bricks the ball never reaches, or a shape that
+ * traps the ball in a loop that never touches a brick.  breakout_analyse
+ * plays each level of a pack many times with the Autopilot, headlessly and
+ * on every core, and reports per level:
+ *
+ *   - the clear rate: games in which the bot cleared the level before
+ *     losing its lives;
+ *   - the mean and 90th-percentile time to clear, in game seconds, and
+ *     the mean lives lost on the way;
+ *   - bricks never hit in any game, which are usually unreachable;
+ *   - loops: games in which the ball stayed in play for --loop-seconds
+ *     without hitting a brick, and games that hit the --max-minutes cap.
+ *
+ *     breakout_analyse                          the built-in levels
+ *     breakout_analyse --levels levels --games 5000
+ *     breakout_analyse --generate 42 --level 3 --details
+ *
+ * Each game starts at the beginning of its level with a full set of lives
+ * and that level's ball speed, so levels are measured independently.
+ * Game g uses simulation seed `--seed + g` on every level, and the results
+ * do not depend on the thread count.  The exit status is 0 when every
+ * level was cleared at least once, 1 otherwise (or if the pack cannot be
+ * loaded), and 2 on usage errors.
+ */
+
+#include <algorithm>  // std::sort, std::min, std::max
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>    // std::strtoul, std::strtod
+#include <iomanip>    // std::setw, std::setprecision
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Autopilot.hpp"
+#include "GameSnapshot.hpp"
+#include "Level.hpp"
+#include "LevelGenerator.hpp"
+#include "Simulation.hpp"
+#include "constants.hpp"
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/// Command-line options.
+struct AnalyseOptions
+{
+    std::string   levelsPath;              ///< --levels directory; empty = not given.
+    bool          generate     = false;    ///< --generate was given.
+    std::uint32_t generateSeed = 0;        ///< Campaign seed for --generate.
+    int           level        = 0;        ///< Only this level; 0 = every level.
+    std::uint32_t games        = 1000;     ///< Games per level.
+    std::uint32_t seed         = 1;        ///< Seed of game 0.
+    double        maxMinutes   = 20.0;     ///< Game time before a game is abandoned.
+    double        loopSeconds  = 120.0;    ///< Play without a brick hit that counts as a loop.
+    unsigned      threads      = 0;        ///< 0 = one per hardware thread.
+    bool          details      = false;    ///< List never-hit bricks and looping seeds.
+};
+
+/// Outcome of one game.
+struct GameResult
+{
+    enum class Outcome : std::uint8_t { Cleared, GameOver, Looped, TimedOut };
+
+    Outcome       outcome   = Outcome::GameOver;
+    std::uint8_t  livesLost = 0;
+    std::uint32_t ticks     = 0;  ///< Ticks until the game ended.
+    sf::Vector2f  velocity;       ///< Ball velocity when the game ended.
+};
+
+/// Bricks hit in any game of one level, set by whichever worker sees the hit.
+struct HitMap
+{
+    std::size_t                               count = 0;
+    std::unique_ptr<std::atomic<std::uint8_t>[]> hit;
+};
+
+/// Largest brick and seed listings printed by --details.
+static constexpr std::size_t MAX_LISTED = 10;
+
+// =============================================================================
+// Command line
+// =============================================================================
+
+static void printUsage()
+{
+    const AnalyseOptions defaults;
+    std::cerr << "Usage: breakout_analyse [options]\n"
+              << "  --levels <dir>        Analyse the levels in <dir> (default: built-in)\n"
+              << "  --generate <seed>     Analyse the generated campaign for <seed>\n"
+              << "  --level <n>           Analyse level <n> only\n"
+              << "  --games <n>           Games per level (default: " << defaults.games << ")\n"
+              << "  --seed <n>            Seed of the first game (default: " << defaults.seed << ")\n"
+              << "  --max-minutes <m>     Abandon a game after <m> minutes of game time\n"
+              << "                        (default: " << defaults.maxMinutes << ")\n"
+              << "  --loop-seconds <s>    Ball in play this long without a brick hit is a\n"
+              << "                        loop (default: " << defaults.loopSeconds << ")\n"
+              << "  --threads <n>         Worker threads (default: all hardware threads)\n"
+              << "  --details             List never-hit bricks and the seeds of looping games\n";
+}
+
+static bool parseOptions(int argc, char* argv[], AnalyseOptions& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--details")
+        {
+            options.details = true;
+            continue;
+        }
+        if (arg == "--help" || arg == "-h")
+            return false;
+
+        if (i + 1 >= argc || arg.compare(0, 2, "--") != 0)
+        {
+            std::cerr << "breakout_analyse: "
+                      << (arg.compare(0, 2, "--") == 0 ? arg + " requires a value"
+                                                       : "unexpected argument \"" + arg + "\"")
+                      << '\n';
+            return false;
+        }
+
+        const char* value = argv[++i];
+        if (arg == "--levels")
+            options.levelsPath = value;
+        else if (arg == "--generate")
+        {
+            options.generate     = true;
+            options.generateSeed = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 0));
+        }
+        else if (arg == "--level")
+            options.level = static_cast<int>(std::strtol(value, nullptr, 10));
+        else if (arg == "--games")
+            options.games = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--seed")
+            options.seed = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 0));
+        else if (arg == "--max-minutes")
+            options.maxMinutes = std::strtod(value, nullptr);
+        else if (arg == "--loop-seconds")
+            options.loopSeconds = std::strtod(value, nullptr);
+        else if (arg == "--threads")
+            options.threads = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+        else
+        {
+            std::cerr << "breakout_analyse: unknown option " << arg << '\n';
+            return false;
+        }
+    }
+
+    if (!options.levelsPath.empty() && options.generate)
+    {
+        std::cerr << "breakout_analyse: --levels and --generate cannot be combined\n";
+        return false;
+    }
+    if (options.games == 0 || options.level < 0 ||
+        !(options.maxMinutes > 0.0) || options.maxMinutes > 24.0 * 60.0 ||
+        !(options.loopSeconds > 0.0) || options.loopSeconds > options.maxMinutes * 60.0)
+    {
+        std::cerr << "breakout_analyse: --games, --max-minutes and --loop-seconds must be positive, "
+                     "--max-minutes at most a day and --loop-seconds within it\n";
+        return false;
+    }
+    return true;
+}
+
+// =============================================================================
+// Playing
+// =============================================================================
+
+/**
+ * @brief Moves a new simulation to the start of level @p number.
+ *
+ * As if the previous levels had just been cleared: ball on the paddle,
+ * full lives and the ball speed of that level.
+ */
+static void startAtLevel(Simulation& sim, int number)
+{
+    const std::shared_ptr<const Level> layout = sim.getLevelPack()->getLevel(number);
+
+    GameSnapshot start = sim.snapshot();
+    start.state           = GameState::BallOnPaddle;
+    start.level           = number;
+    start.ballSpeed       = std::min(Constants::BALL_INITIAL_SPEED +
+                                     static_cast<float>(number - 1) * Constants::BALL_SPEED_STEP,
+                                     Constants::BALL_MAX_SPEED);
+    start.brickHitPoints  = layout->getInitialHitPoints();
+    start.bricksRemaining = static_cast<std::int32_t>(start.brickHitPoints.size());
+    sim.restore(start);
+}
+
+/**
+ * @brief Plays one game of level @p number until it is cleared or lost.
+ * @param hits  Receives the bricks hit.
+ */
+static GameResult playGame(const std::shared_ptr<const LevelPack>& pack, int number,
+                           std::uint32_t seed, const AnalyseOptions& options, HitMap& hits)
+{
+    const std::uint32_t maxTicks  = static_cast<std::uint32_t>(options.maxMinutes  * 60.0 * Constants::TICK_RATE);
+    const std::uint32_t loopTicks = static_cast<std::uint32_t>(options.loopSeconds * Constants::TICK_RATE);
+
+    Simulation sim(seed, pack);
+    Autopilot  bot(seed ^ 0x9E3779B9u);
+    startAtLevel(sim, number);
+
+    const std::uint32_t firstTick = sim.getTick();
+    std::uint64_t       brickHash = sim.getBrickHash();
+    std::uint32_t       quietTicks = 0;   // Ticks in play since the last brick hit.
+
+    GameResult result;
+    for (;;)
+    {
+        sim.step(bot.nextInput(sim));
+        result.ticks = sim.getTick() - firstTick;
+
+        const GameState state = sim.getState();
+        if (state == GameState::LevelComplete || state == GameState::Victory)
+        {
+            result.outcome = GameResult::Outcome::Cleared;
+            break;
+        }
+        if (state == GameState::GameOver)
+        {
+            result.outcome = GameResult::Outcome::GameOver;
+            break;
+        }
+
+        if (sim.getBrickHash() != brickHash)
+        {
+            brickHash  = sim.getBrickHash();
+            quietTicks = 0;
+        }
+        else if (state == GameState::Playing && ++quietTicks >= loopTicks)
+        {
+            result.outcome = GameResult::Outcome::Looped;
+            break;
+        }
+        if (result.ticks >= maxTicks)
+        {
+            result.outcome = GameResult::Outcome::TimedOut;
+            break;
+        }
+    }
+    result.livesLost = static_cast<std::uint8_t>(Constants::INITIAL_LIVES - sim.getLives());
+    result.velocity  = sim.getBall().getVelocity();
+
+    // Compare against the starting hit points; most bricks are already
+    // marked after a few games, so the atomics are rarely written.
+    const std::vector<std::uint8_t>& initial   = sim.getLayout().getInitialHitPoints();
+    const std::vector<std::uint8_t>& remaining = sim.getBrickHitPoints();
+    for (std::size_t i = 0; i < remaining.size(); ++i)
+    {
+        if (remaining[i] < initial[i] && !hits.hit[i].load(std::memory_order_relaxed))
+            hits.hit[i].store(1, std::memory_order_relaxed);
+    }
+    return result;
+}
+
+// =============================================================================
+// Report
+// =============================================================================
+
+/// Game seconds in @p ticks.
+static double toSeconds(std::uint32_t ticks)
+{
+    return static_cast<double>(ticks) / Constants::TICK_RATE;
+}
+
+/**
+ * @brief Prints the summary line for one level, and its details.
+ * @return true if the level was cleared at least once.
+ */
+static bool printLevel(int number, const Level& layout, const GameResult* results,
+                       const HitMap& hits, const AnalyseOptions& options)
+{
+    std::size_t                counts[4] = {};
+    std::vector<std::uint32_t> clearTicks;
+    std::uint64_t              livesLost = 0;
+    for (std::uint32_t game = 0; game < options.games; ++game)
+    {
+        const GameResult& result = results[game];
+        ++counts[static_cast<int>(result.outcome)];
+        livesLost += result.livesLost;
+        if (result.outcome == GameResult::Outcome::Cleared)
+            clearTicks.push_back(result.ticks);
+    }
+
+    std::vector<std::size_t> neverHit;
+    for (std::size_t i = 0; i < hits.count; ++i)
+        if (!hits.hit[i].load(std::memory_order_relaxed))
+            neverHit.push_back(i);
+
+    const std::size_t cleared = counts[static_cast<int>(GameResult::Outcome::Cleared)];
+    std::cout << std::setw(5) << number << std::setw(9) << layout.getBricks().size()
+              << std::setw(8) << std::setprecision(1) << 100.0 * cleared / options.games << '%';
+
+    if (clearTicks.empty())
+    {
+        std::cout << std::setw(12) << "-" << std::setw(8) << "-";
+    }
+    else
+    {
+        std::sort(clearTicks.begin(), clearTicks.end());
+        double total = 0.0;
+        for (std::uint32_t ticks : clearTicks)
+            total += toSeconds(ticks);
+        std::cout << std::setw(11) << total / clearTicks.size() << 's'
+                  << std::setw(7) << toSeconds(clearTicks[(clearTicks.size() - 1) * 9 / 10]) << 's';
+    }
+
+    std::cout << std::setw(12) << std::setprecision(2) << static_cast<double>(livesLost) / options.games
+              << std::setw(11) << neverHit.size()
+              << std::setw(7) << counts[static_cast<int>(GameResult::Outcome::Looped)]
+              << std::setw(10) << counts[static_cast<int>(GameResult::Outcome::TimedOut)] << '\n';
+
+    if (options.details)
+    {
+        const std::vector<Brick>& bricks = layout.getBricks();
+        for (std::size_t i = 0; i < neverHit.size() && i < MAX_LISTED; ++i)
+        {
+            const Brick& brick = bricks[neverHit[i]];
+            std::cout << "        never hit: brick " << neverHit[i] << " at (" << std::setprecision(1)
+                      << brick.x << ", " << brick.y << "), " << brick.width << " x " << brick.height << '\n';
+        }
+        if (neverHit.size() > MAX_LISTED)
+            std::cout << "        never hit: " << neverHit.size() - MAX_LISTED << " more\n";
+
+        std::size_t listed = 0;
+        for (std::uint32_t game = 0; game < options.games && listed < MAX_LISTED; ++game)
+        {
+            const GameResult& result = results[game];
+            if (result.outcome != GameResult::Outcome::Looped && result.outcome != GameResult::Outcome::TimedOut)
+                continue;
+            std::cout << "        " << (result.outcome == GameResult::Outcome::Looped ? "loop" : "timeout")
+                      << ": seed " << options.seed + game << ", ended at " << std::setprecision(1)
+                      << toSeconds(result.ticks) << " s, ball velocity (" << std::setprecision(2)
+                      << result.velocity.x << ", " << result.velocity.y << ")\n";
+            ++listed;
+        }
+    }
+    return cleared > 0;
+}
+
+// =============================================================================
+// Entry point
+// =============================================================================
+
+int main(int argc, char* argv[])
+{
+    AnalyseOptions options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage();
+        return 2;
+    }
+
+    std::shared_ptr<const LevelPack> pack = LevelPack::builtIn();
+    if (!options.levelsPath.empty())
+    {
+        std::shared_ptr<LevelPack> loaded;
+        if (!LevelPack::loadDirectory(options.levelsPath, loaded))
+            return 1;
+        pack = std::move(loaded);
+    }
+    else if (options.generate)
+    {
+        pack = LevelGenerator::campaign(options.generateSeed);
+    }
+
+    const int levelCount = pack->getLevelCount();
+    if (options.level > levelCount)
+    {
+        std::cerr << "breakout_analyse: the pack has " << levelCount << " levels\n";
+        return 2;
+    }
+    const int firstLevel = options.level ? options.level : 1;
+    const int lastLevel  = options.level ? options.level : levelCount;
+
+    // Load every level up front, in parallel, so workers never wait on one.
+    std::vector<std::shared_ptr<const Level>> layouts;
+    for (int number = firstLevel; number <= lastLevel; ++number)
+        pack->prefetch(number);
+    for (int number = firstLevel; number <= lastLevel; ++number)
+        layouts.push_back(pack->getLevel(number));
+
+    std::vector<HitMap> hits(layouts.size());
+    for (std::size_t level = 0; level < layouts.size(); ++level)
+    {
+        hits[level].count = layouts[level]->getBricks().size();
+        hits[level].hit.reset(new std::atomic<std::uint8_t>[hits[level].count]);
+        for (std::size_t i = 0; i < hits[level].count; ++i)
+            hits[level].hit[i].store(0, std::memory_order_relaxed);
+    }
+
+    // One job per game; job j plays game j % games of level j / games.
+    const std::size_t jobCount = layouts.size() * options.games;
+    unsigned threadCount = options.threads ? options.threads
+                                           : std::max(1u, std::thread::hardware_concurrency());
+    threadCount = static_cast<unsigned>(std::min<std::size_t>(threadCount, jobCount));
+
+    // ---- Play on the worker pool ----
+    std::vector<GameResult>  results(jobCount);
+    std::atomic<std::size_t> nextJob{ 0 };
+    std::atomic<std::size_t> completed{ 0 };
+    std::atomic<std::uint64_t> totalTicks{ 0 };
+
+    auto worker = [&]()
+    {
+        for (std::size_t job = nextJob++; job < jobCount; job = nextJob++)
+        {
+            const std::size_t   level = job / options.games;
+            const std::uint32_t game  = static_cast<std::uint32_t>(job % options.games);
+            results[job] = playGame(pack, firstLevel + static_cast<int>(level), options.seed + game,
+                                    options, hits[level]);
+            totalTicks += results[job].ticks;
+            ++completed;
+        }
+    };
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threadCount; ++t)
+        pool.emplace_back(worker);
+
+    // Progress on stderr keeps stdout a clean report.
+    while (completed.load() < jobCount)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        std::cerr << "\rbreakout_analyse: " << completed.load() << " / " << jobCount << " games" << std::flush;
+    }
+    std::cerr << '\n';
+
+    for (std::thread& thread : pool)
+        thread.join();
+
+    const double wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // ---- Report ----
+    std::cout << std::fixed << std::setw(5) << "level" << std::setw(9) << "bricks" << std::setw(9) << "cleared"
+              << std::setw(12) << "mean clear" << std::setw(8) << "p90" << std::setw(12) << "lives lost"
+              << std::setw(11) << "never hit" << std::setw(7) << "loops" << std::setw(10) << "timeouts" << '\n';
+
+    bool allCleared = true;
+    for (std::size_t level = 0; level < layouts.size(); ++level)
+    {
+        allCleared &= printLevel(firstLevel + static_cast<int>(level), *layouts[level],
+                                 results.data() + level * options.games, hits[level], options);
+    }
+
+    std::cout << "\n" << jobCount << " games, " << totalTicks.load() << " ticks in "
+              << std::setprecision(2) << wallSeconds << " s on " << threadCount << " threads ("
+              << totalTicks.load() / std::max(wallSeconds, 1e-9) / 1e6 << " Mticks/s)\n";
+
+    return allCleared ? 0 : 1;
+}
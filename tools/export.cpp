@@ -0,0 +1,672 @@
+/**
+ * @file export.cpp
+ * @brief breakout_export — renders a replay to video frames faster than real time.
+ *
+ * Plays a replay headlessly and renders the frames offscreen with the real
+ * Renderer at any resolution and frame rate, writing either a YUV4MPEG2
+ * stream (.y4m, or "-" for stdout, ready to pipe into an encoder) or a
+ * numbered PNG sequence in a directory.
+ *
+ * Pipeline
+ * --------
+ *   simulation thread   plays the replay and, for every output frame, pushes
+ *                       a GameSnapshot of the tick that frame shows;
+ *   render workers      (one per hardware thread by default) each own an
+ *                       OpenGL context, a RenderTexture, a font and a
+ *                       scratch Simulation: restore the snapshot, render,
+ *                       read the pixels back, then either encode a PNG
+ *                       directly or convert the frame to 4:2:0 YUV;
+ *   writer thread       (y4m only) writes converted frames in order.
+ *
+ * Snapshots are about 150 bytes, so handing a frame to a worker costs far
+ * less than rendering it, and the simulation (millions of ticks per second)
+ * never limits throughput.  The number of frames between the simulation and
+ * the output is bounded, so memory use does not grow with replay length even
+ * when the writer falls behind.  Throughput scales with cores until the GPU
+ * driver or the disk saturates.
+ *
+ * The frame shown at time t is the state after floor(t × TICK_RATE) ticks;
+ * the playfield is scaled to the output size, letterboxed if the aspect ratio
+ * differs from the window's.  On a machine without a GPU or display, run
+ * under `xvfb-run -a` for software rendering.  Replays recorded on custom,
+ * generated or endless levels need the matching --levels, --generate or
+ * --endless option.
+ */
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithm>  // std::min, std::max
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>     // std::FILE, std::fopen, std::fwrite, std::snprintf
+#include <cstdlib>    // std::strtoul, std::strtod
+#include <deque>
+#include <filesystem>
+#include <functional> // std::ref, std::cref
+#include <iomanip>    // std::setprecision
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>    // std::move
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>    // _O_BINARY
+#include <io.h>       // _setmode, _fileno
+#endif
+
+#include "GameSnapshot.hpp"
+#include "Level.hpp"
+#include "LevelGenerator.hpp"
+#include "Renderer.hpp"
+#include "Replay.hpp"
+#include "Simulation.hpp"
+#include "constants.hpp"
+
+namespace fs = std::filesystem;
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/// Output container.
+enum class OutputFormat { Y4m, Png };
+
+/// Command-line options.
+struct ExportOptions
+{
+    std::string   replayPath;
+    std::string   outputPath;
+    std::string   fontPath     = "assets/DejaVuSans.ttf";
+    unsigned      width        = Constants::WINDOW_WIDTH;
+    unsigned      height       = Constants::WINDOW_HEIGHT;
+    unsigned      fps          = Constants::FRAME_RATE;
+    unsigned      threads      = 0;     ///< Render workers; 0 = one per hardware thread.
+    double        start        = 0.0;   ///< Seconds into the replay.
+    double        duration     = -1.0;  ///< Seconds to export; negative = to the end.
+    bool          quiet        = false; ///< No progress line.
+    OutputFormat  format       = OutputFormat::Png;
+    std::string   levelsPath;           ///< --levels directory; empty = not given.
+    bool          generate     = false; ///< --generate was given.
+    std::uint32_t generateSeed = 0;     ///< Campaign seed for --generate.
+    bool          endless      = false; ///< --endless was given.
+    std::uint32_t endlessSeed  = 0;     ///< Row seed for --endless.
+};
+
+/// Frames in flight per render worker (queued, rendering, or awaiting write).
+static constexpr std::size_t FRAMES_PER_WORKER = 4;
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [options] <replay> <output>\n"
+              << "  <output> ending in .y4m, or \"-\" for stdout, writes a YUV4MPEG2 stream;\n"
+              << "  anything else is a directory that receives frame_NNNNNN.png files.\n"
+              << "  --size <w>x<h>    Output resolution (default 800x600)\n"
+              << "  --fps <n>         Output frame rate (default 60)\n"
+              << "  --start <s>       Start this many seconds into the replay\n"
+              << "  --duration <s>    Export this many seconds (default: to the end)\n"
+              << "  --threads <n>     Render workers (default: all hardware threads)\n"
+              << "  --font <file>     Font for HUD text (default assets/DejaVuSans.ttf)\n"
+              << "  --levels <dir>    Play on the levels in <dir> (default: built-in)\n"
+              << "  --generate <n>    Play on the generated campaign for seed <n>\n"
+              << "  --endless <n>     Play on the endless field for seed <n>\n"
+              << "  --quiet           No progress output\n";
+}
+
+static bool parseOptions(int argc, char* argv[], ExportOptions& options)
+{
+    std::vector<std::string> positional;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+
+        auto value = [&]() -> const char*
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << "breakout_export: " << arg << " requires a value\n";
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--size")
+        {
+            const char* v = value();
+            char*       end = nullptr;
+            if (!v) return false;
+            options.width = static_cast<unsigned>(std::strtoul(v, &end, 10));
+            if (*end != 'x' || options.width == 0)
+            {
+                std::cerr << "breakout_export: --size expects <width>x<height>\n";
+                return false;
+            }
+            options.height = static_cast<unsigned>(std::strtoul(end + 1, &end, 10));
+            if (*end != '\0' || options.height == 0)
+            {
+                std::cerr << "breakout_export: --size expects <width>x<height>\n";
+                return false;
+            }
+        }
+        else if (arg == "--fps")      { const char* v = value(); if (!v) return false; options.fps = static_cast<unsigned>(std::strtoul(v, nullptr, 10)); }
+        else if (arg == "--start")    { const char* v = value(); if (!v) return false; options.start = std::max(0.0, std::strtod(v, nullptr)); }
+        else if (arg == "--duration") { const char* v = value(); if (!v) return false; options.duration = std::strtod(v, nullptr); }
+        else if (arg == "--threads")  { const char* v = value(); if (!v) return false; options.threads = static_cast<unsigned>(std::strtoul(v, nullptr, 10)); }
+        else if (arg == "--font")     { const char* v = value(); if (!v) return false; options.fontPath = v; }
+        else if (arg == "--levels")   { const char* v = value(); if (!v) return false; options.levelsPath = v; }
+        else if (arg == "--generate") { const char* v = value(); if (!v) return false; options.generate = true; options.generateSeed = static_cast<std::uint32_t>(std::strtoul(v, nullptr, 0)); }
+        else if (arg == "--endless")  { const char* v = value(); if (!v) return false; options.endless = true; options.endlessSeed = static_cast<std::uint32_t>(std::strtoul(v, nullptr, 0)); }
+        else if (arg == "--quiet")    { options.quiet = true; }
+        else if (arg == "--help" || arg == "-h") { printUsage(argv[0]); return false; }
+        else if (arg.size() > 1 && arg[0] == '-')
+        {
+            std::cerr << "breakout_export: unknown option \"" << arg << "\"\n";
+            printUsage(argv[0]);
+            return false;
+        }
+        else
+        {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.size() != 2)
+    {
+        printUsage(argv[0]);
+        return false;
+    }
+    options.replayPath = positional[0];
+    options.outputPath = positional[1];
+
+    if (!options.levelsPath.empty() + options.generate + options.endless > 1)
+    {
+        std::cerr << "breakout_export: --levels, --generate and --endless cannot be combined\n";
+        return false;
+    }
+
+    if (options.fps == 0 || options.fps > Constants::TICK_RATE)
+    {
+        std::cerr << "breakout_export: --fps must be between 1 and " << Constants::TICK_RATE << "\n";
+        return false;
+    }
+
+    const fs::path output(options.outputPath);
+    options.format = (options.outputPath == "-" || output.extension() == ".y4m")
+                         ? OutputFormat::Y4m : OutputFormat::Png;
+
+    // 4:2:0 chroma covers 2×2 pixel blocks.
+    if (options.format == OutputFormat::Y4m && (options.width % 2 != 0 || options.height % 2 != 0))
+    {
+        std::cerr << "breakout_export: y4m output needs an even width and height\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief View that shows the whole playfield in a @p width × @p height
+ *        target, letterboxed to keep the window's aspect ratio.
+ */
+static sf::View playfieldView(unsigned width, unsigned height)
+{
+    const float fieldWidth  = static_cast<float>(Constants::WINDOW_WIDTH);
+    const float fieldHeight = static_cast<float>(Constants::WINDOW_HEIGHT);
+    const float scale       = std::min(width / fieldWidth, height / fieldHeight);
+    const float viewWidth   = fieldWidth  * scale / static_cast<float>(width);
+    const float viewHeight  = fieldHeight * scale / static_cast<float>(height);
+
+    sf::View view(sf::FloatRect(0.0f, 0.0f, fieldWidth, fieldHeight));
+    view.setViewport(sf::FloatRect((1.0f - viewWidth) * 0.5f, (1.0f - viewHeight) * 0.5f,
+                                   viewWidth, viewHeight));
+    return view;
+}
+
+/**
+ * @brief Converts RGBA pixels to planar 4:2:0 YUV (BT.601, video range).
+ *
+ * Luma is computed per pixel; each chroma sample averages a 2×2 block.
+ *
+ * @param rgba    width × height RGBA pixels.
+ * @param width   Even image width.
+ * @param height  Even image height.
+ * @param out     Receives the Y, U and V planes back to back.
+ */
+static void convertToI420(const std::uint8_t* rgba, unsigned width, unsigned height,
+                          std::vector<std::uint8_t>& out)
+{
+    const std::size_t lumaSize   = static_cast<std::size_t>(width) * height;
+    const std::size_t chromaSize = lumaSize / 4;
+    out.resize(lumaSize + 2 * chromaSize);
+
+    std::uint8_t* yPlane = out.data();
+    std::uint8_t* uPlane = yPlane + lumaSize;
+    std::uint8_t* vPlane = uPlane + chromaSize;
+
+    for (unsigned y = 0; y < height; y += 2)
+    {
+        for (unsigned x = 0; x < width; x += 2)
+        {
+            int r = 0, g = 0, b = 0;
+            for (unsigned dy = 0; dy < 2; ++dy)
+            {
+                for (unsigned dx = 0; dx < 2; ++dx)
+                {
+                    const std::size_t   index = static_cast<std::size_t>(y + dy) * width + x + dx;
+                    const std::uint8_t* pixel = rgba + index * 4;
+                    yPlane[index] = static_cast<std::uint8_t>(
+                        ((66 * pixel[0] + 129 * pixel[1] + 25 * pixel[2] + 128) >> 8) + 16);
+                    r += pixel[0];
+                    g += pixel[1];
+                    b += pixel[2];
+                }
+            }
+            r = (r + 2) / 4;
+            g = (g + 2) / 4;
+            b = (b + 2) / 4;
+
+            const std::size_t chroma = static_cast<std::size_t>(y / 2) * (width / 2) + x / 2;
+            uPlane[chroma] = static_cast<std::uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            vPlane[chroma] = static_cast<std::uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+}
+
+// =============================================================================
+// Pipeline
+// =============================================================================
+
+/// One output frame: its number and the state it shows.
+struct FrameJob
+{
+    std::uint32_t index;
+    GameSnapshot  snapshot;
+};
+
+/**
+ * @brief State shared by the simulation, render and writer threads.
+ *
+ * A frame is "in flight" from the moment the simulation queues it until it
+ * has been written; the simulation waits while capacity frames are in
+ * flight, which bounds both the job queue and the writer's reorder buffer.
+ */
+class Pipeline
+{
+public:
+    explicit Pipeline(std::size_t maxInFlight) : capacity(maxInFlight) {}
+
+    /// Queues a frame, waiting for room.  @return false if the export failed.
+    bool push(const FrameJob& job)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        slotFree.wait(lock, [&] { return inFlight < capacity || failed; });
+        if (failed)
+            return false;
+        jobs.push_back(job);
+        ++inFlight;
+        jobReady.notify_one();
+        return true;
+    }
+
+    /// Marks the end of the frame list; idle workers exit.
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        jobReady.notify_all();
+    }
+
+    /// Takes the next frame to render.  @return false when none remain.
+    bool take(FrameJob& job)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        jobReady.wait(lock, [&] { return !jobs.empty() || closed || failed; });
+        if (jobs.empty() || failed)
+            return false;
+        job = jobs.front();
+        jobs.pop_front();
+        return true;
+    }
+
+    /// Hands a converted frame to the writer.
+    void submit(std::uint32_t index, std::vector<std::uint8_t>&& frame)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        converted[index] = std::move(frame);
+        if (index == nextToWrite)
+            frameReady.notify_one();
+    }
+
+    /**
+     * @brief Waits for the next frame in order (writer thread).
+     * @return false if the export failed.
+     */
+    bool awaitNext(std::vector<std::uint8_t>& frame)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        frameReady.wait(lock, [&] { return converted.count(nextToWrite) != 0 || failed; });
+        if (failed)
+            return false;
+        auto found = converted.find(nextToWrite);
+        frame = std::move(found->second);
+        converted.erase(found);
+        ++nextToWrite;
+        return true;
+    }
+
+    /// Releases a frame's slot once it is on disk.
+    void written()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        --inFlight;
+        ++completed;
+        slotFree.notify_one();
+    }
+
+    /// Aborts the export; the first message is kept.
+    void fail(const std::string& message)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!failed)
+            error = message;
+        failed = true;
+        jobReady.notify_all();
+        slotFree.notify_all();
+        frameReady.notify_all();
+    }
+
+    /// @return Frames written so far.
+    std::uint32_t getCompleted() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return completed;
+    }
+
+    /// @return true after fail(); @p message receives the reason.
+    bool hasFailed(std::string& message) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        message = error;
+        return failed;
+    }
+
+private:
+    mutable std::mutex      mutex;
+    std::condition_variable jobReady;   ///< Workers wait for jobs.
+    std::condition_variable slotFree;   ///< Simulation waits for capacity.
+    std::condition_variable frameReady; ///< Writer waits for the next frame.
+
+    const std::size_t    capacity;
+    std::size_t          inFlight    = 0;
+    std::deque<FrameJob> jobs;
+    std::map<std::uint32_t, std::vector<std::uint8_t>> converted; ///< Out-of-order y4m frames.
+    std::uint32_t        nextToWrite = 0;
+    std::uint32_t        completed   = 0;
+    bool                 closed      = false;
+    bool                 failed      = false;
+    std::string          error;
+};
+
+/**
+ * @brief Simulation thread: plays the replay and queues every output frame.
+ *
+ * @param replay      Replay to play.
+ * @param pack        Levels it was recorded on.
+ * @param firstTick   Tick shown by frame 0.
+ * @param frameCount  Frames to queue.
+ * @param fps         Output frame rate.
+ */
+static void simulate(Pipeline& pipeline, const Replay& replay,
+                     const std::shared_ptr<const LevelPack>& pack, std::uint32_t firstTick,
+                     std::uint32_t frameCount, unsigned fps)
+{
+    Simulation   sim(replay.getSeed(), pack);
+    ReplayPlayer player(replay);
+    player.seek(sim, firstTick);
+
+    bool warned = false;
+    for (std::uint32_t frame = 0; frame < frameCount; ++frame)
+    {
+        const std::uint32_t tick = firstTick + static_cast<std::uint32_t>(
+            static_cast<std::uint64_t>(frame) * Constants::TICK_RATE / fps);
+
+        while (sim.getTick() < tick && !player.isFinished())
+        {
+            if (!warned && !player.matchesRecording(sim))
+            {
+                std::cerr << "breakout_export: WARNING: replay desynced by tick " << sim.getTick()
+                          << "; the video no longer shows the recorded game\n";
+                warned = true;
+            }
+            sim.step(player.next());
+        }
+
+        if (!pipeline.push({ frame, sim.snapshot() }))
+            return;
+    }
+    pipeline.close();
+}
+
+/**
+ * @brief Render worker: renders queued frames and encodes or converts them.
+ */
+static void renderFrames(Pipeline& pipeline, const ExportOptions& options,
+                         const std::shared_ptr<const LevelPack>& pack)
+{
+    // Fonts cache glyphs in textures of the current GL context, so every
+    // worker loads its own.  A missing font was already reported by main().
+    sf::Font font;
+    font.loadFromFile(options.fontPath);
+    Renderer renderer(font);
+
+    sf::RenderTexture texture;
+    if (!texture.create(options.width, options.height))
+    {
+        pipeline.fail("no OpenGL context available (run under xvfb-run for software rendering)");
+        return;
+    }
+    texture.setView(playfieldView(options.width, options.height));
+
+    Simulation                sim(0, pack);
+    std::vector<std::uint8_t> converted;
+    FrameJob                  job;
+    char                      name[32];
+
+    while (pipeline.take(job))
+    {
+        if (!sim.restore(job.snapshot))
+        {
+            pipeline.fail("frame " + std::to_string(job.index) + " does not fit the levels");
+            return;
+        }
+        renderer.render(texture, sim, sim.getState());
+        texture.display();
+        const sf::Image image = texture.getTexture().copyToImage();
+
+        if (options.format == OutputFormat::Png)
+        {
+            std::snprintf(name, sizeof(name), "frame_%06u.png", static_cast<unsigned>(job.index));
+            const fs::path path = fs::path(options.outputPath) / name;
+            if (!image.saveToFile(path.string()))
+            {
+                pipeline.fail("could not write \"" + path.string() + "\"");
+                return;
+            }
+            pipeline.written();
+        }
+        else
+        {
+            convertToI420(image.getPixelsPtr(), options.width, options.height, converted);
+            pipeline.submit(job.index, std::move(converted));
+            converted = std::vector<std::uint8_t>();
+        }
+    }
+}
+
+/**
+ * @brief Writer thread: writes the y4m header and every frame in order.
+ */
+static void writeY4m(Pipeline& pipeline, std::FILE* file, const ExportOptions& options,
+                     std::uint32_t frameCount)
+{
+    // C420jpeg: 4:2:0 with chroma sited between the four luma samples, as
+    // the 2×2 average in convertToI420() produces.
+    std::fprintf(file, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C420jpeg\n",
+                 options.width, options.height, options.fps);
+
+    std::vector<std::uint8_t> frame;
+    for (std::uint32_t i = 0; i < frameCount; ++i)
+    {
+        if (!pipeline.awaitNext(frame))
+            return;
+        if (std::fputs("FRAME\n", file) < 0 ||
+            std::fwrite(frame.data(), 1, frame.size(), file) != frame.size())
+        {
+            pipeline.fail("could not write \"" + options.outputPath + "\"");
+            return;
+        }
+        pipeline.written();
+    }
+}
+
+// =============================================================================
+// Entry point
+// =============================================================================
+
+int main(int argc, char* argv[])
+{
+    ExportOptions options;
+    if (!parseOptions(argc, argv, options))
+        return 2;
+
+    std::shared_ptr<const LevelPack> pack = LevelPack::builtIn();
+    if (!options.levelsPath.empty())
+    {
+        std::shared_ptr<LevelPack> loaded;
+        if (!LevelPack::loadDirectory(options.levelsPath, loaded))
+            return 1;
+        pack = std::move(loaded);
+    }
+    else if (options.generate)
+    {
+        pack = LevelGenerator::campaign(options.generateSeed);
+    }
+    else if (options.endless)
+    {
+        pack = LevelGenerator::endless(options.endlessSeed);
+    }
+
+    Replay replay;
+    if (!Replay::load(options.replayPath, pack->getSource(), replay))
+        return 1;
+
+    // ---- Frame range ----
+    const std::uint32_t tickCount = replay.getTickCount();
+    const std::uint32_t firstTick = static_cast<std::uint32_t>(std::min<double>(
+        tickCount, replay.getStartTick() + options.start * Constants::TICK_RATE));
+    std::uint32_t lastTick = tickCount;
+    if (options.duration >= 0.0)
+        lastTick = static_cast<std::uint32_t>(
+            std::min<double>(tickCount, firstTick + options.duration * Constants::TICK_RATE));
+
+    const std::uint32_t frameCount = static_cast<std::uint32_t>(
+        static_cast<std::uint64_t>(lastTick - firstTick) * options.fps / Constants::TICK_RATE + 1);
+
+    // ---- Output ----
+    std::FILE* file = nullptr;
+    if (options.format == OutputFormat::Y4m)
+    {
+        if (options.outputPath == "-")
+        {
+#ifdef _WIN32
+            _setmode(_fileno(stdout), _O_BINARY);
+#endif
+            file = stdout;
+        }
+        else
+        {
+            file = std::fopen(options.outputPath.c_str(), "wb");
+        }
+    }
+    else
+    {
+        std::error_code error;
+        fs::create_directories(options.outputPath, error);
+        if (!fs::is_directory(options.outputPath, error))
+        {
+            std::cerr << "breakout_export: cannot create directory \"" << options.outputPath << "\"\n";
+            return 1;
+        }
+    }
+    if (options.format == OutputFormat::Y4m && !file)
+    {
+        std::cerr << "breakout_export: cannot open \"" << options.outputPath << "\" for writing\n";
+        return 1;
+    }
+
+    {
+        sf::Font font;
+        if (!font.loadFromFile(options.fontPath))
+            std::cerr << "breakout_export: font \"" << options.fontPath << "\" not found; HUD text is skipped\n";
+    }
+
+    const unsigned workers = options.threads ? options.threads
+                                             : std::max(1u, std::thread::hardware_concurrency());
+
+    // ---- Run the pipeline ----
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+
+    Pipeline pipeline(workers * FRAMES_PER_WORKER);
+
+    std::vector<std::thread> threads;
+    threads.emplace_back(simulate, std::ref(pipeline), std::cref(replay), std::cref(pack),
+                         firstTick, frameCount, options.fps);
+    for (unsigned w = 0; w < workers; ++w)
+        threads.emplace_back(renderFrames, std::ref(pipeline), std::cref(options), std::cref(pack));
+    if (options.format == OutputFormat::Y4m)
+        threads.emplace_back(writeY4m, std::ref(pipeline), file, std::cref(options), frameCount);
+
+    // Progress on stderr keeps stdout free for the video stream.
+    std::string error;
+    while (pipeline.getCompleted() < frameCount && !pipeline.hasFailed(error))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        if (!options.quiet)
+            std::cerr << "\rbreakout_export: frame " << pipeline.getCompleted() << " / " << frameCount << std::flush;
+    }
+    if (!options.quiet)
+        std::cerr << '\n';
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    bool ok = !pipeline.hasFailed(error);
+    if (file && file != stdout)
+        ok = (std::fclose(file) == 0) && ok;
+    else if (file)
+        ok = (std::fflush(file) == 0) && ok;
+
+    if (!ok)
+    {
+        std::cerr << "breakout_export: " << (error.empty() ? "could not write \"" + options.outputPath + "\"" : error) << "\n";
+        return 1;
+    }
+
+    const double seconds      = std::chrono::duration<double>(Clock::now() - start).count();
+    const double videoSeconds = static_cast<double>(frameCount) / options.fps;
+    std::cerr << std::fixed << std::setprecision(1)
+              << "breakout_export: " << frameCount << " frames (" << videoSeconds << " s) at "
+              << options.width << "x" << options.height << " in " << seconds << " s on "
+              << workers << " render threads: " << frameCount / std::max(seconds, 1e-9)
+              << " fps, " << videoSeconds / std::max(seconds, 1e-9) << "x real time\n";
+    return 0;
+}
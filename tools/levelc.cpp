@@ -0,0 +1,83 @@
+/**
+ * @file levelc.cpp
+ * @brief breakout_levelc — compiles level sources into level files.
+ *
+ * Level sources (`.level`, see Level::parse()) are meant to be written by
+ * hand; the game also reads them directly, but parses every brick to do so.
+ * breakout_levelc parses a source once, builds its collision index, and
+ * writes both as a compiled level (`.brkl`) that the game memory-maps and
+ * copies without parsing or rebuilding anything:
+ *
+ *     breakout_levelc levels/01.level                 writes levels/01.brkl
+ *     breakout_levelc levels/01.level out/first.brkl
+ *
+ * The written file is loaded back as a check, and its size and load time
+ * are reported.  The exit status is 0 on success, 1 if the source has an
+ * error or the output cannot be written, and 2 on usage errors.
+ */
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>    // std::setprecision
+#include <iostream>
+#include <iterator>   // std::istreambuf_iterator
+#include <string>
+
+#include "Level.hpp"
+
+namespace fs = std::filesystem;
+
+// =============================================================================
+// Entry point
+// =============================================================================
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || argc > 3 || std::string(argv[1]) == "--help")
+    {
+        std::cerr << "Usage: breakout_levelc <source.level> [output.brkl]\n"
+                  << "  Compiles a level source; the output defaults to the source\n"
+                  << "  path with a .brkl extension.\n";
+        return 2;
+    }
+
+    const std::string source = argv[1];
+    const std::string output = (argc == 3) ? std::string(argv[2])
+                                           : fs::path(source).replace_extension(".brkl").string();
+
+    std::ifstream file(source, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "breakout_levelc: cannot open \"" << source << "\"\n";
+        return 1;
+    }
+    const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    Level       level;
+    std::string error;
+    if (!Level::parse(text, level, error))
+    {
+        std::cerr << "breakout_levelc: " << source << ": " << error << '\n';
+        return 1;
+    }
+    if (!level.save(output))
+        return 1;
+
+    // Load the result the way the game does, as a check and a measurement.
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    Level check;
+    if (!Level::load(output, check) || check.getBricks().size() != level.getBricks().size())
+    {
+        std::cerr << "breakout_levelc: \"" << output << "\" does not load back\n";
+        return 1;
+    }
+    const double milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::error_code sizeError;
+    std::cout << output << ": " << level.getBricks().size() << " bricks, "
+              << fs::file_size(output, sizeError) << " bytes, loads in "
+              << std::fixed << std::setprecision(2) << milliseconds << " ms\n";
+    return 0;
+}
@@ -0,0 +1,642 @@
+/**
+ * @file perf_suite.cpp
+ * @brief breakout_perf — whole-game performance regression suite.
+ *
+ * Plays a list of deterministic sessions headlessly through the complete
+ * Simulation and, unless disabled, renders every display frame into an
+ * offscreen sf::RenderTexture with the real Renderer.  Per-tick update times
+ * and per-frame render times are collected and summarised (mean, p99, max),
+ * then compared against the baseline file with configurable tolerances.  The
+ * process exits non-zero when any metric regresses, so it can gate CI.
+ *
+ * Sessions
+ * --------
+ * A session is either a recorded replay file, or a (seed, tick count) pair
+ * played by the Autopilot bot.  Both replay the same game every time:
+ * launches, rebounds, lives lost, level transitions and restarts.  Replays
+ * pin the input exactly; bot sessions are convenient but change whenever the
+ * bot does.  Every session plays the built-in levels.  --record <dir> saves
+ * every bot session as a replay so it can be frozen into the baseline.  Long
+ * sessions exercise behaviour microbenchmarks miss, such as heap
+ * fragmentation from repeated level rebuilds.  The final score and level are stored with the baseline;
+ * if a session no longer plays the same game its timings are not comparable
+ * and the suite fails with a request to re-record the baseline.
+ *
+ * Baseline file
+ * -------------
+ *   {
+ *     "tolerance": { "relative": 0.25, "absolute_us": 0.05 },
+ *     "sessions": [
+ *       { "name": "repro", "replay": "sessions/repro.replay" },   // relative to this file
+ *       { "name": "campaign", "seed": 1, "ticks": 14400,
+ *         "tolerance": { "relative": 0.5 },          // optional override
+ *         "workload": { "score": 1230, "level": 3 },  // written by --update-baseline
+ *         "metrics":  { "update_mean_us": 1.4, ... } }
+ *     ]
+ *   }
+ *
+ * A metric regresses when  measured > baseline × (1 + relative) + absolute_us
+ * (total_ms: absolute_us / 1000).  A tick costs about a tenth of a
+ * microsecond, so the absolute slack only has to cover timer resolution; a
+ * slack of whole microseconds would let the update metrics grow tenfold.
+ * Render metrics and total_ms are judged only when the run and the baseline
+ * both rendered, or both did not.
+ * Sessions without stored metrics are measured and reported but not judged;
+ * a run that judges no metric at all fails, so an empty baseline cannot pass
+ * the gate.  The checked-in baseline (perf/baseline.json) plays replays
+ * recorded from the bot under perf/sessions/.
+ *
+ * GPU-less machines
+ * -----------------
+ * Offscreen rendering needs an OpenGL context.  On a headless Linux box run
+ * the suite under Xvfb (Mesa's llvmpipe provides software GL); if no context
+ * can be created the suite falls back to simulation-only timing and says so.
+ * --no-render skips rendering explicitly.
+ */
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithm>  // std::sort, std::max
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>    // std::strtoul, std::strtod
+#include <cstring>    // std::strcmp
+#include <fstream>
+#include <iomanip>    // std::setw, std::setprecision
+#include <iostream>
+#include <sstream>    // std::ostringstream
+#include <string>
+#include <utility>    // std::pair
+#include <vector>
+
+#include "Autopilot.hpp"
+#include "FramePhase.hpp"
+#include "Json.hpp"
+#include "PerfCounters.hpp"
+#include "Renderer.hpp"
+#include "Replay.hpp"
+#include "Simulation.hpp"
+#include "constants.hpp"
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/// Command-line options.
+struct SuiteOptions
+{
+    std::string baselinePath   = "perf/baseline.json";
+    std::string fontPath       = "assets/DejaVuSans.ttf";
+    std::string outputPath;                 ///< Optional results JSON.
+    std::string onlySession;                ///< Run just this session.
+    std::string recordDir;                  ///< Save bot sessions as replays here.
+    bool        updateBaseline = false;
+    bool        render         = true;
+    bool        perfCounters   = false;
+    int         repeat         = 3;
+    double      relativeOverride = -1.0;    ///< < 0 = use the file's value.
+};
+
+/// Regression tolerance: measured ≤ baseline × (1 + relative) + absoluteUs.
+struct Tolerance
+{
+    double relative   = 0.25;
+    double absoluteUs = 0.05;
+};
+
+/// Named metric values in a fixed order.
+using Metrics = std::vector<std::pair<std::string, double>>;
+
+/// Outcome of playing one session.
+struct SessionResult
+{
+    Metrics metrics;
+    int     finalScore = 0;
+    int     finalLevel = 0;
+    int     levelTransitions = 0;
+    bool    rendered   = false;
+    PerfCounters::Values updateCounters{};
+    PerfCounters::Values renderCounters{};
+    bool    countersActive = false;
+};
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+/**
+ * @brief Returns the value at quantile @p q of sorted @p values.
+ */
+static double quantile(const std::vector<double>& values, double q)
+{
+    if (values.empty())
+        return 0.0;
+    std::size_t rank = static_cast<std::size_t>(q * static_cast<double>(values.size() - 1) + 0.5);
+    return values[std::min(rank, values.size() - 1)];
+}
+
+/**
+ * @brief Appends mean, p99 and max of @p samples (microseconds) to @p out.
+ */
+static void summarise(const std::string& prefix, std::vector<double>& samples, Metrics& out)
+{
+    if (samples.empty())
+        return;
+
+    double total = 0.0;
+    for (double s : samples)
+        total += s;
+    std::sort(samples.begin(), samples.end());
+
+    out.emplace_back(prefix + "_mean_us", total / static_cast<double>(samples.size()));
+    out.emplace_back(prefix + "_p99_us",  quantile(samples, 0.99));
+    out.emplace_back(prefix + "_max_us",  samples.back());
+}
+
+/**
+ * @brief Reads a tolerance object, starting from @p base.
+ */
+static Tolerance readTolerance(const JsonValue* node, Tolerance base)
+{
+    if (!node)
+        return base;
+    if (const JsonValue* r = node->find("relative"))
+        base.relative = r->asNumber(base.relative);
+    if (const JsonValue* a = node->find("absolute_us"))
+        base.absoluteUs = a->asNumber(base.absoluteUs);
+    return base;
+}
+
+/**
+ * @brief Returns whether @p name is judged against the baseline.
+ *
+ * Maxima are reported for context but are too noisy to gate on.
+ */
+static bool isGatedMetric(const std::string& name)
+{
+    return name.find("_max_us") == std::string::npos;
+}
+
+/// @return Whether @p name depends on rendering having run.
+static bool isRenderMetric(const std::string& name)
+{
+    return name.compare(0, 7, "render_") == 0 || name == "total_ms";
+}
+
+static void printUsage(const char* program)
+{
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --baseline <file>     Baseline JSON (default perf/baseline.json)\n"
+              << "  --update-baseline     Store measured metrics as the new baseline\n"
+              << "  --tolerance <ratio>   Override the relative tolerance (e.g. 0.2)\n"
+              << "  --session <name>      Run only the named session\n"
+              << "  --repeat <n>          Runs per session; median is used (default 3)\n"
+              << "  --no-render           Time the simulation only\n"
+              << "  --font <file>         Font for HUD text (default assets/DejaVuSans.ttf)\n"
+              << "  --perf-counters       Also report hardware counters (Linux)\n"
+              << "  --output <file>       Write measured results as JSON\n"
+              << "  --record <dir>        Save each bot session as <dir>/<name>.replay\n";
+}
+
+static bool parseOptions(int argc, char* argv[], SuiteOptions& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        auto value = [&]() -> const char*
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << "breakout_perf: " << arg << " requires a value\n";
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--baseline")             { const char* v = value(); if (!v) return false; options.baselinePath = v; }
+        else if (arg == "--update-baseline") { options.updateBaseline = true; }
+        else if (arg == "--tolerance")       { const char* v = value(); if (!v) return false; options.relativeOverride = std::strtod(v, nullptr); }
+        else if (arg == "--session")         { const char* v = value(); if (!v) return false; options.onlySession = v; }
+        else if (arg == "--repeat")          { const char* v = value(); if (!v) return false; options.repeat = std::max(1, std::atoi(v)); }
+        else if (arg == "--no-render")       { options.render = false; }
+        else if (arg == "--font")            { const char* v = value(); if (!v) return false; options.fontPath = v; }
+        else if (arg == "--perf-counters")   { options.perfCounters = true; }
+        else if (arg == "--output")          { const char* v = value(); if (!v) return false; options.outputPath = v; }
+        else if (arg == "--record")          { const char* v = value(); if (!v) return false; options.recordDir = v; }
+        else if (arg == "--help" || arg == "-h") { printUsage(argv[0]); return false; }
+        else
+        {
+            std::cerr << "breakout_perf: unknown option \"" << arg << "\"\n";
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+// =============================================================================
+// Session playback
+// =============================================================================
+
+/**
+ * @brief Plays one session and measures it.
+ *
+ * @param seed          Simulation and bot seed.
+ * @param ticks         Number of simulation ticks to play.
+ * @param replay        Recorded inputs to play, or nullptr for the bot.
+ * @param recording     If non-null, receives every input played.
+ * @param target        Offscreen target, or nullptr to skip rendering.
+ * @param renderer      Renderer used when @p target is non-null.
+ * @param counters      Hardware counters (may be inactive).
+ * @return SessionResult  Metrics and final game state.
+ */
+static SessionResult playSession(std::uint32_t seed, std::uint32_t ticks,
+                                 const Replay* replay, Replay* recording,
+                                 sf::RenderTexture* target, const Renderer& renderer,
+                                 PerfCounters& counters)
+{
+    using Clock = std::chrono::steady_clock;
+
+    Simulation sim(seed);
+    Autopilot  bot(seed ^ 0xA5A5A5A5u);
+
+    Replay       none;
+    ReplayPlayer player(replay ? *replay : none);
+    if (replay)
+        player.seek(sim, replay->getStartTick());
+
+    // Render once per display frame, as the interactive game does.
+    const std::uint32_t ticksPerFrame =
+        std::max<std::uint32_t>(1, Constants::TICK_RATE / Constants::FRAME_RATE);
+
+    std::vector<double> updateUs;
+    std::vector<double> renderUs;
+    updateUs.reserve(ticks);
+    if (target)
+        renderUs.reserve(ticks / ticksPerFrame + 1);
+
+    const PerfCounters::Values updateBefore = counters.totals(FramePhase::Update);
+    const PerfCounters::Values renderBefore = counters.totals(FramePhase::Render);
+
+    SessionResult result;
+    int           lastLevel = sim.getLevel();
+    Clock::time_point sessionStart = Clock::now();
+
+    for (std::uint32_t t = 0; t < ticks; ++t)
+    {
+        InputMask input = replay ? player.next() : bot.nextInput(sim);
+        if (recording)
+            recording->record(sim, input);
+
+        Clock::time_point begin = Clock::now();
+        {
+            PerfCounters::Scope scope(counters, FramePhase::Update);
+            sim.step(input);
+        }
+        Clock::time_point end = Clock::now();
+        updateUs.push_back(std::chrono::duration<double, std::micro>(end - begin).count());
+
+        if (sim.getLevel() != lastLevel)
+        {
+            ++result.levelTransitions;
+            lastLevel = sim.getLevel();
+        }
+
+        if (target && (t + 1) % ticksPerFrame == 0)
+        {
+            begin = Clock::now();
+            {
+                PerfCounters::Scope scope(counters, FramePhase::Render);
+                renderer.render(*target, sim, sim.getState());
+                target->display();
+            }
+            end = Clock::now();
+            renderUs.push_back(std::chrono::duration<double, std::micro>(end - begin).count());
+        }
+    }
+
+    double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - sessionStart).count();
+
+    summarise("update", updateUs, result.metrics);
+    summarise("render", renderUs, result.metrics);
+    result.metrics.emplace_back("total_ms", totalMs);
+
+    if (recording)
+        recording->finish(sim);
+
+    result.finalScore = sim.getScore();
+    result.finalLevel = sim.getLevel();
+    result.rendered   = (target != nullptr);
+
+    result.countersActive = counters.isActive();
+    const PerfCounters::Values updateAfter = counters.totals(FramePhase::Update);
+    const PerfCounters::Values renderAfter = counters.totals(FramePhase::Render);
+    for (int e = 0; e < PerfCounters::EventCount; ++e)
+    {
+        result.updateCounters[e] = updateAfter[e] - updateBefore[e];
+        result.renderCounters[e] = renderAfter[e] - renderBefore[e];
+    }
+    return result;
+}
+
+/**
+ * @brief Combines repeated runs by taking the median of every metric.
+ */
+static SessionResult medianOf(std::vector<SessionResult>& runs)
+{
+    SessionResult combined = runs.front();
+    for (std::size_t m = 0; m < combined.metrics.size(); ++m)
+    {
+        std::vector<double> values;
+        for (const SessionResult& run : runs)
+            values.push_back(run.metrics[m].second);
+        std::sort(values.begin(), values.end());
+        combined.metrics[m].second = values[values.size() / 2];
+    }
+    return combined;
+}
+
+/**
+ * @brief Prints IPC and misses per tick / frame for one session.
+ */
+static void printCounters(const SessionResult& result, std::uint32_t ticks)
+{
+    auto line = [](const char* label, const PerfCounters::Values& v, double count)
+    {
+        if (count <= 0.0 || v[PerfCounters::Cycles] == 0)
+            return;
+        std::cout << "      " << label << std::fixed << std::setprecision(2)
+                  << " IPC " << static_cast<double>(v[PerfCounters::Instructions]) /
+                                static_cast<double>(v[PerfCounters::Cycles])
+                  << std::setprecision(1)
+                  << ", cache-miss " << static_cast<double>(v[PerfCounters::CacheMisses]) / count
+                  << ", branch-miss " << static_cast<double>(v[PerfCounters::BranchMisses]) / count
+                  << '\n';
+    };
+
+    const double frames = static_cast<double>(ticks / std::max<std::uint32_t>(1,
+                              Constants::TICK_RATE / Constants::FRAME_RATE));
+    line("update (per tick): ", result.updateCounters, static_cast<double>(ticks));
+    if (result.rendered)
+        line("render (per frame):", result.renderCounters, frames);
+}
+
+// =============================================================================
+// Entry point
+// =============================================================================
+
+int main(int argc, char* argv[])
+{
+    SuiteOptions options;
+    if (!parseOptions(argc, argv, options))
+        return 2;
+
+    // ---- Load the baseline ----
+    std::ifstream baselineFile(options.baselinePath);
+    if (!baselineFile)
+    {
+        std::cerr << "breakout_perf: cannot open baseline \"" << options.baselinePath << "\"\n";
+        return 2;
+    }
+    std::ostringstream contents;
+    contents << baselineFile.rdbuf();
+    baselineFile.close();
+
+    // Replay paths in the baseline are relative to the baseline file.
+    const std::size_t slash = options.baselinePath.find_last_of("/\\");
+    const std::string baselineDir =
+        slash == std::string::npos ? std::string() : options.baselinePath.substr(0, slash + 1);
+
+    JsonValue   baseline;
+    std::string error;
+    if (!JsonValue::parse(contents.str(), baseline, error))
+    {
+        std::cerr << "breakout_perf: " << options.baselinePath << ": " << error << '\n';
+        return 2;
+    }
+
+    Tolerance globalTolerance = readTolerance(baseline.find("tolerance"), Tolerance());
+    if (options.relativeOverride >= 0.0)
+        globalTolerance.relative = options.relativeOverride;
+
+    const JsonValue* sessions = baseline.find("sessions");
+    if (!sessions || sessions->getType() != JsonValue::Type::Array || sessions->items().empty())
+    {
+        std::cerr << "breakout_perf: baseline has no \"sessions\" array\n";
+        return 2;
+    }
+
+    // ---- Offscreen rendering setup ----
+    sf::Font font;
+    if (options.render && !font.loadFromFile(options.fontPath))
+        std::cerr << "breakout_perf: font \"" << options.fontPath << "\" not found; HUD text is skipped\n";
+    Renderer renderer(font);
+
+    sf::RenderTexture texture;
+    sf::RenderTexture* target = nullptr;
+    if (options.render)
+    {
+        if (texture.create(Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT))
+            target = &texture;
+        else
+            std::cerr << "breakout_perf: no OpenGL context available; timing the simulation only "
+                         "(run under xvfb-run for software rendering)\n";
+    }
+
+    PerfCounters counters;
+    if (options.perfCounters)
+        counters.open();
+
+    // ---- Play and judge every session ----
+    JsonValue updated  = baseline;
+    JsonValue results  = JsonValue::makeObject();
+    JsonValue sessionsOut = JsonValue::makeArray();
+    bool      regressed = false;
+    int       judged    = 0;
+
+    std::cout << std::fixed;
+
+    for (const JsonValue& session : sessions->items())
+    {
+        const std::string  name  = session.find("name") ? session.find("name")->asString() : "unnamed";
+        std::uint32_t       seed  = static_cast<std::uint32_t>(session.find("seed") ? session.find("seed")->asNumber() : 1.0);
+        std::uint32_t       ticks = static_cast<std::uint32_t>(session.find("ticks") ? session.find("ticks")->asNumber() : 0.0);
+
+        JsonValue sessionOut = session;
+
+        if (!options.onlySession.empty() && name != options.onlySession)
+        {
+            sessionsOut.append(sessionOut);
+            continue;
+        }
+
+        // Replay sessions take their seed and length from the file.
+        Replay replay;
+        const JsonValue* replayPath = session.find("replay");
+        if (replayPath)
+        {
+            if (!Replay::load(baselineDir + replayPath->asString(), LevelPack::builtIn()->getSource(), replay))
+            {
+                std::cout << "\n" << name << "\n  FAIL  replay could not be loaded\n";
+                regressed = true;
+                sessionsOut.append(sessionOut);
+                continue;
+            }
+            seed  = replay.getSeed();
+            ticks = replay.getTickCount() - replay.getStartTick();
+        }
+
+        std::vector<SessionResult> runs;
+        for (int r = 0; r < options.repeat; ++r)
+            runs.push_back(playSession(seed, ticks, replayPath ? &replay : nullptr, nullptr,
+                                       target, renderer, counters));
+        SessionResult result = medianOf(runs);
+
+        std::cout << "\n" << name << (replayPath ? "  (replay, seed " : "  (seed ")
+                  << seed << ", " << ticks << " ticks, "
+                  << result.levelTransitions << " level transitions, final score "
+                  << result.finalScore << ", level " << result.finalLevel
+                  << (result.rendered ? "" : ", not rendered") << ")\n";
+
+        if (!options.recordDir.empty() && !replayPath)
+        {
+            Replay recorded(seed, LevelPack::builtIn()->getSource());
+            playSession(seed, ticks, nullptr, &recorded, nullptr, renderer, counters);
+            const std::string path = options.recordDir + "/" + name + ".replay";
+            if (recorded.save(path))
+                std::cout << "  recorded " << path << '\n';
+        }
+
+        const Tolerance tolerance = readTolerance(session.find("tolerance"), globalTolerance);
+        const JsonValue* storedMetrics  = session.find("metrics");
+        const JsonValue* storedWorkload = session.find("workload");
+        const bool       baselineRendered = storedMetrics && storedMetrics->find("render_mean_us");
+
+        // Timings are only comparable if the session still plays the same game.
+        bool workloadChanged = false;
+        if (storedWorkload)
+        {
+            int score = static_cast<int>(storedWorkload->find("score") ? storedWorkload->find("score")->asNumber() : -1);
+            int level = static_cast<int>(storedWorkload->find("level") ? storedWorkload->find("level")->asNumber() : -1);
+            workloadChanged = (score != result.finalScore || level != result.finalLevel);
+        }
+
+        if (workloadChanged && !options.updateBaseline)
+        {
+            std::cout << "  FAIL  session no longer plays the recorded game; timings are not comparable.\n"
+                      << "        Re-record with --update-baseline after verifying the gameplay change.\n";
+            regressed = true;
+        }
+
+        for (const auto& metric : result.metrics)
+        {
+            const JsonValue* stored = storedMetrics ? storedMetrics->find(metric.first) : nullptr;
+
+            std::cout << "  " << std::left << std::setw(16) << metric.first << std::right
+                      << std::setprecision(2) << std::setw(12) << metric.second;
+
+            if (!stored || workloadChanged || options.updateBaseline)
+            {
+                std::cout << '\n';
+                continue;
+            }
+
+            const double base     = stored->asNumber();
+            const double absolute = metric.first == "total_ms" ? tolerance.absoluteUs / 1000.0
+                                                               : tolerance.absoluteUs;
+            const double limit    = base * (1.0 + tolerance.relative) + absolute;
+            std::cout << "   baseline " << std::setw(10) << base;
+
+            if (!isGatedMetric(metric.first))
+            {
+                std::cout << '\n';
+                continue;
+            }
+            if (isRenderMetric(metric.first) && result.rendered != baselineRendered)
+            {
+                std::cout << "   not judged (baseline " << (baselineRendered ? "rendered" : "not rendered")
+                          << ")\n";
+                continue;
+            }
+
+            ++judged;
+            if (metric.second > limit)
+            {
+                std::cout << "   REGRESSION (limit " << limit << ")\n";
+                regressed = true;
+            }
+            else
+            {
+                std::cout << "   ok\n";
+            }
+        }
+
+        if (result.countersActive)
+            printCounters(result, ticks);
+
+        // Record results for --update-baseline / --output.
+        JsonValue metricsOut = JsonValue::makeObject();
+        for (const auto& metric : result.metrics)
+            metricsOut.set(metric.first, JsonValue::makeNumber(metric.second));
+
+        JsonValue workloadOut = JsonValue::makeObject();
+        workloadOut.set("score", JsonValue::makeNumber(result.finalScore));
+        workloadOut.set("level", JsonValue::makeNumber(result.finalLevel));
+
+        if (options.updateBaseline)
+        {
+            // A baseline recorded without rendering must not erase stored
+            // render metrics from an earlier, rendered run, nor replace the
+            // total they belong with.
+            if (!result.rendered && baselineRendered)
+            {
+                for (std::size_t k = 0; k < storedMetrics->keys().size(); ++k)
+                {
+                    if (isRenderMetric(storedMetrics->keys()[k]))
+                        metricsOut.set(storedMetrics->keys()[k], storedMetrics->items()[k]);
+                }
+            }
+            sessionOut.set("workload", workloadOut);
+            sessionOut.set("metrics", metricsOut);
+        }
+        sessionsOut.append(sessionOut);
+
+        JsonValue measured = JsonValue::makeObject();
+        measured.set("workload", workloadOut);
+        measured.set("metrics", metricsOut);
+        results.set(name, measured);
+    }
+
+    // ---- Outputs ----
+    if (options.updateBaseline)
+    {
+        updated.set("sessions", sessionsOut);
+        std::ofstream out(options.baselinePath);
+        updated.write(out);
+        out << '\n';
+        std::cout << "\nBaseline written to " << options.baselinePath << '\n';
+        return 0;
+    }
+
+    if (!options.outputPath.empty())
+    {
+        std::ofstream out(options.outputPath);
+        results.write(out);
+        out << '\n';
+    }
+
+    if (regressed)
+    {
+        std::cout << "\nPerformance regression detected.\n";
+        return 1;
+    }
+
+    if (judged == 0)
+    {
+        std::cout << "\nNo stored metrics to compare against; run with --update-baseline to record them.\n";
+        return 1;
+    }
+
+    std::cout << "\nAll " << judged << " metrics within tolerance.\n";
+    return 0;
+}
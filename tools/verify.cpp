@@ -0,0 +1,436 @@
+/**
+ * @file verify.cpp
+ * @brief breakout_verify — re-simulates archived replays on every core.
+ *
+ * After a physics or rules change, every archived replay should either still
+ * play the same game or fail loudly.  breakout_verify collects the replay
+ * files named on the command line (directories are searched recursively for
+ * *.replay), re-simulates each one headlessly, and checks:
+ *
+ *   - the state hash of every tick against the recorded hash, reporting
+ *     the first that differs;
+ *   - the final state, including the score, against the state the recorder
+ *     stored with Replay::finish().
+ *
+ * Replays are independent, so they are spread over a pool of worker threads
+ * (one per hardware thread by default) that pull the next file from a shared
+ * counter.  The largest files are handed out first so one long replay does
+ * not leave the other cores idle at the end.  Results are printed in path
+ * order once all replays are done, one line per replay with its throughput,
+ * followed by a summary.  The exit status is 0 when every replay passes,
+ * 1 when any fails, and 2 on usage errors.
+ *
+ * Replays without hashes or a final state (recorded by older builds) cannot
+ * be checked; they are listed as unchecked and do not fail the run.
+ *
+ * Replays play on the built-in levels unless --levels, --generate or
+ * --endless names the ones they were recorded on; a replay recorded on
+ * other levels cannot be read.
+ */
+
+#include <algorithm>  // std::sort, std::max
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>    // std::atoi, std::strtoul
+#include <filesystem>
+#include <fstream>
+#include <iomanip>    // std::setw, std::setprecision
+#include <iostream>
+#include <iterator>   // std::istreambuf_iterator
+#include <memory>
+#include <sstream>    // std::ostringstream
+#include <string>
+#include <thread>
+#include <utility>    // std::move
+#include <vector>
+
+#include "GameSnapshot.hpp"
+#include "Level.hpp"
+#include "LevelGenerator.hpp"
+#include "Replay.hpp"
+#include "Simulation.hpp"
+
+namespace fs = std::filesystem;
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/// Command-line options.
+struct VerifyOptions
+{
+    std::vector<std::string> inputs;          ///< Replay files and directories.
+    unsigned                 threads = 0;     ///< 0 = one per hardware thread.
+    bool                     quiet   = false; ///< Print failures and the summary only.
+    bool                     details = false; ///< Explain every failure in full.
+    std::string              levelsPath;      ///< --levels directory; empty = not given.
+    bool                     generate     = false; ///< --generate was given.
+    std::uint32_t            generateSeed = 0;     ///< Campaign seed for --generate.
+    bool                     endless      = false; ///< --endless was given.
+    std::uint32_t            endlessSeed  = 0;     ///< Row seed for --endless.
+};
+
+/// Outcome of verifying one replay.
+struct VerifyResult
+{
+    enum class Status { Passed, Failed, Unchecked, Unreadable };
+
+    Status        status        = Status::Unreadable;
+    std::uint32_t ticks         = 0;
+    bool          desynced      = false; ///< A state hash differed.
+    std::uint32_t desyncTick    = 0;     ///< Tick of the first differing hash.
+    bool          finalChecked  = false; ///< The replay stored a final state.
+    bool          finalMatches  = false;
+    int           expectedScore = 0;
+    int           actualScore   = 0;
+    double        seconds       = 0.0;   ///< Load plus simulation time.
+    std::string   message;               ///< Load error or --details report.
+};
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static void printUsage(const char* program)
+{
+    std::cout << "Usage: " << program << " [options] <replay or directory>...\n"
+              << "  --threads <n>   Worker threads (default: all hardware threads)\n"
+              << "  --quiet         Print failures and the summary only\n"
+              << "  --details       Explain each failure (differing fields)\n"
+              << "  --levels <dir>  Play on the levels in <dir> (default: built-in)\n"
+              << "  --generate <n>  Play on the generated campaign for seed <n>\n"
+              << "  --endless <n>   Play on the endless field for seed <n>\n";
+}
+
+static bool parseOptions(int argc, char* argv[], VerifyOptions& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+
+        if (arg == "--threads")
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << "breakout_verify: --threads requires a value\n";
+                return false;
+            }
+            options.threads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (arg == "--levels" || arg == "--generate" || arg == "--endless")
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << "breakout_verify: " << arg << " requires a value\n";
+                return false;
+            }
+            const char* value = argv[++i];
+            if (arg == "--levels")
+            {
+                options.levelsPath = value;
+            }
+            else if (arg == "--generate")
+            {
+                options.generate     = true;
+                options.generateSeed = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 0));
+            }
+            else
+            {
+                options.endless     = true;
+                options.endlessSeed = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 0));
+            }
+        }
+        else if (arg == "--quiet")       { options.quiet = true; }
+        else if (arg == "--details")     { options.details = true; }
+        else if (arg == "--help" || arg == "-h") { printUsage(argv[0]); return false; }
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            std::cerr << "breakout_verify: unknown option \"" << arg << "\"\n";
+            printUsage(argv[0]);
+            return false;
+        }
+        else
+        {
+            options.inputs.push_back(arg);
+        }
+    }
+
+    if (options.inputs.empty())
+    {
+        printUsage(argv[0]);
+        return false;
+    }
+    if (!options.levelsPath.empty() + options.generate + options.endless > 1)
+    {
+        std::cerr << "breakout_verify: --levels, --generate and --endless cannot be combined\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Expands files and directories into a sorted list of replay paths.
+ * @return false if an input does not exist.
+ */
+static bool collectReplays(const std::vector<std::string>& inputs, std::vector<fs::path>& out)
+{
+    for (const std::string& input : inputs)
+    {
+        std::error_code error;
+        if (fs::is_directory(input, error))
+        {
+            for (const fs::directory_entry& entry : fs::recursive_directory_iterator(input, error))
+            {
+                if (entry.is_regular_file() && entry.path().extension() == ".replay")
+                    out.push_back(entry.path());
+            }
+        }
+        else if (fs::is_regular_file(input, error))
+        {
+            out.push_back(input);
+        }
+        else
+        {
+            std::cerr << "breakout_verify: \"" << input << "\" does not exist\n";
+            return false;
+        }
+    }
+
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return true;
+}
+
+// =============================================================================
+// Verification
+// =============================================================================
+
+/**
+ * @brief Loads and re-simulates one replay.
+ * @param path     Replay file.
+ * @param pack     Levels to play it on.
+ * @param details  Fill VerifyResult::message with a failure report.
+ */
+static VerifyResult verifyReplay(const fs::path& path, const std::shared_ptr<const LevelPack>& pack,
+                                 bool details)
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+
+    VerifyResult result;
+
+    std::ifstream file(path, std::ios::binary);
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                                    std::istreambuf_iterator<char>());
+    Replay replay;
+    if (!file || !Replay::decode(bytes, replay, result.message))
+    {
+        if (result.message.empty())
+            result.message = "cannot read file";
+        return result;
+    }
+    if (!replay.isPlayableOn(pack->getSource()))
+    {
+        result.message = "recorded on other levels (check --levels, --generate and --endless)";
+        return result;
+    }
+
+    GameSnapshot expectedFinal;
+    result.ticks        = replay.getTickCount() - replay.getStartTick();
+    result.finalChecked = replay.findFinalState(expectedFinal);
+
+    Simulation   sim(replay.getSeed(), pack);
+    ReplayPlayer player(replay);
+    player.seek(sim, replay.getStartTick());
+    std::ostringstream report;
+
+    while (!player.isFinished())
+    {
+        if (!result.desynced && !player.matchesRecording(sim))
+        {
+            result.desynced   = true;
+            result.desyncTick = sim.getTick();
+            if (details)
+                player.reportDesync(sim, report);
+        }
+        sim.step(player.next());
+    }
+
+    result.actualScore = sim.getScore();
+    if (result.finalChecked)
+    {
+        const GameSnapshot actualFinal = sim.snapshot();
+        result.expectedScore = expectedFinal.score;
+
+        // Compare field by field; padding bytes are not part of the state.
+        std::ostringstream differences;
+        result.finalMatches =
+            GameSnapshot::writeDifferences(differences, expectedFinal, actualFinal) == 0;
+        if (details && !result.finalMatches)
+            report << "  Final state differs:\n" << differences.str();
+    }
+
+    const bool hashed = !replay.getStateHashes().empty();
+    if (result.desynced || (result.finalChecked && !result.finalMatches))
+        result.status = VerifyResult::Status::Failed;
+    else if (!hashed && !result.finalChecked)
+        result.status = VerifyResult::Status::Unchecked;
+    else
+        result.status = VerifyResult::Status::Passed;
+
+    result.message = report.str();
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+/**
+ * @brief Prints one result line (and its details, if any).
+ */
+static void printResult(const fs::path& path, const VerifyResult& result)
+{
+    static const char* const LABELS[] = { "ok", "FAIL", "unchecked", "ERROR" };
+    std::cout << std::left << std::setw(10) << LABELS[static_cast<int>(result.status)]
+              << std::right << path.string();
+
+    if (result.status == VerifyResult::Status::Unreadable)
+    {
+        std::cout << ": " << result.message << '\n';
+        return;
+    }
+
+    std::cout << "  (" << result.ticks << " ticks, "
+              << std::setprecision(2) << result.ticks / std::max(result.seconds, 1e-9) / 1e6
+              << " Mticks/s";
+    if (result.desynced)
+        std::cout << ", desync by tick " << result.desyncTick;
+    if (result.finalChecked && result.expectedScore != result.actualScore)
+        std::cout << ", score " << result.actualScore << " != recorded " << result.expectedScore;
+    else if (result.finalChecked && !result.finalMatches)
+        std::cout << ", final state differs";
+    std::cout << ")\n";
+
+    if (result.status == VerifyResult::Status::Failed && !result.message.empty())
+        std::cout << result.message;
+}
+
+// =============================================================================
+// Entry point
+// =============================================================================
+
+int main(int argc, char* argv[])
+{
+    VerifyOptions options;
+    if (!parseOptions(argc, argv, options))
+        return 2;
+
+    std::vector<fs::path> paths;
+    if (!collectReplays(options.inputs, paths))
+        return 2;
+
+    // Packs are thread-safe, so every worker plays on the same one.
+    std::shared_ptr<const LevelPack> pack = LevelPack::builtIn();
+    if (!options.levelsPath.empty())
+    {
+        std::shared_ptr<LevelPack> loaded;
+        if (!LevelPack::loadDirectory(options.levelsPath, loaded))
+            return 2;
+        pack = std::move(loaded);
+    }
+    else if (options.generate)
+    {
+        pack = LevelGenerator::campaign(options.generateSeed);
+    }
+    else if (options.endless)
+    {
+        pack = LevelGenerator::endless(options.endlessSeed);
+    }
+    if (paths.empty())
+    {
+        std::cerr << "breakout_verify: no .replay files found\n";
+        return 2;
+    }
+
+    // Hand out the largest replays first to avoid a long tail on one core.
+    std::vector<std::size_t> order(paths.size());
+    std::vector<std::uintmax_t> sizes(paths.size());
+    for (std::size_t i = 0; i < paths.size(); ++i)
+    {
+        std::error_code error;
+        order[i] = i;
+        sizes[i] = fs::file_size(paths[i], error);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::size_t a, std::size_t b) { return sizes[a] > sizes[b]; });
+
+    unsigned threadCount = options.threads ? options.threads
+                                           : std::max(1u, std::thread::hardware_concurrency());
+    threadCount = static_cast<unsigned>(std::min<std::size_t>(threadCount, paths.size()));
+
+    // ---- Verify on the worker pool ----
+    std::vector<VerifyResult> results(paths.size());
+    std::atomic<std::size_t>  nextJob{ 0 };
+    std::atomic<std::size_t>  completed{ 0 };
+
+    auto worker = [&]()
+    {
+        for (std::size_t job = nextJob++; job < order.size(); job = nextJob++)
+        {
+            results[order[job]] = verifyReplay(paths[order[job]], pack, options.details);
+            ++completed;
+        }
+    };
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threadCount; ++t)
+        pool.emplace_back(worker);
+
+    // Progress on stderr keeps stdout a clean report.
+    while (completed.load() < paths.size())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        if (!options.quiet)
+            std::cerr << "\rbreakout_verify: " << completed.load() << " / " << paths.size() << std::flush;
+    }
+    if (!options.quiet)
+        std::cerr << '\n';
+
+    for (std::thread& thread : pool)
+        thread.join();
+
+    const double wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // ---- Report ----
+    std::cout << std::fixed;
+
+    std::size_t   counts[4] = {};
+    std::uint64_t totalTicks = 0;
+    for (std::size_t i = 0; i < paths.size(); ++i)
+    {
+        const VerifyResult& result = results[i];
+        ++counts[static_cast<int>(result.status)];
+        totalTicks += result.ticks;
+
+        if (!options.quiet || result.status == VerifyResult::Status::Failed ||
+            result.status == VerifyResult::Status::Unreadable)
+        {
+            printResult(paths[i], result);
+        }
+    }
+
+    std::cout << "\n" << paths.size() << " replays: "
+              << counts[static_cast<int>(VerifyResult::Status::Passed)]     << " passed, "
+              << counts[static_cast<int>(VerifyResult::Status::Failed)]     << " failed, "
+              << counts[static_cast<int>(VerifyResult::Status::Unreadable)] << " unreadable, "
+              << counts[static_cast<int>(VerifyResult::Status::Unchecked)]  << " unchecked\n"
+              << totalTicks << " ticks in " << std::setprecision(2) << wallSeconds << " s on "
+              << threadCount << " threads ("
+              << totalTicks / std::max(wallSeconds, 1e-9) / 1e6 << " Mticks/s)\n";
+
+    const bool failed = counts[static_cast<int>(VerifyResult::Status::Failed)] > 0 ||
+                        counts[static_cast<int>(VerifyResult::Status::Unreadable)] > 0;
+    return failed ? 1 : 0;
+}